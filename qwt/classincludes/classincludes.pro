@@ -59,6 +59,7 @@ CLASSHEADERS = \
     QwtScaleArithmetic \
     QwtScaleDiv \
     QwtScaleDraw \
+    QwtScaleLabelCache \
     QwtScaleEngine \
     QwtScaleMap \
     QwtSimpleCompassRose \
@@ -76,6 +77,7 @@ CLASSHEADERS = \
     QwtSymbol \
     QwtSystemClock \
     QwtText \
+    QwtTextCache \
     QwtTextEngine \
     QwtTextLabel \
     QwtTransform \
@@ -91,6 +93,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtLegend \
         QwtLegendData \
         QwtLegendLabel \
+        QwtListLegend \
         QwtPointMapper \
         QwtMatrixRasterData \
         QwtOHLCSample \
@@ -118,12 +121,14 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotScaleItem \
         QwtPlotSeriesItem \
         QwtPlotShapeItem \
+        QwtPlotSnapshot \
         QwtPlotSpectroCurve \
         QwtPlotSpectrogram \
         QwtPlotSvgItem \
         QwtPlotTextLabel \
         QwtPlotTradingCurve \
         QwtPlotVectorField \
+        QwtPlotWaterfall \
         QwtPlotZoneItem \
         QwtPlotZoomer \
         QwtScaleWidget \
@@ -133,6 +138,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtSplineCurveFitter \
         QwtWeedingCurveFitter \
         QwtIntervalSeriesData \
+        QwtHistogramData \
         QwtPoint3DSeriesData \
         QwtPointSeriesData \
         QwtSetSeriesData \
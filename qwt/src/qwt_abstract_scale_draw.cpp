@@ -11,11 +11,12 @@
 #include "qwt_text.h"
 #include "qwt_painter.h"
 #include "qwt_scale_map.h"
+#include "qwt_scale_label_cache.h"
 #include "qwt_math.h"
 
 #include <qpainter.h>
 #include <qpalette.h>
-#include <qmap.h>
+#include <qstring.h>
 #include <qlist.h>
 #include <qlocale.h>
 
@@ -25,7 +26,9 @@ public:
     PrivateData():
         spacing( 4.0 ),
         penWidthF( 0.0 ),
-        minExtent( 0.0 )
+        minExtent( 0.0 ),
+        isLabelCachePersistent( false ),
+        labelFormatId( -1 )
     {
         components = QwtAbstractScaleDraw::Backbone
             | QwtAbstractScaleDraw::Ticks
@@ -47,7 +50,11 @@ public:
 
     double minExtent;
 
-    QMap<double, QwtText> labelCache;
+    QwtScaleLabelCache labelCache;
+    bool isLabelCachePersistent;
+
+    // -1, when labelFormatKey() needs to be requested again
+    int labelFormatId;
 };
 
 /*!
@@ -105,7 +112,16 @@ void QwtAbstractScaleDraw::setScaleDiv( const QwtScaleDiv &scaleDiv )
 {
     d_data->scaleDiv = scaleDiv;
     d_data->map.setScaleInterval( scaleDiv.lowerBound(), scaleDiv.upperBound() );
-    d_data->labelCache.clear();
+
+    if ( d_data->isLabelCachePersistent )
+    {
+        // the cached labels are kept, as long as the format does not change
+        d_data->labelFormatId = -1;
+    }
+    else
+    {
+        invalidateCache();
+    }
 }
 
 /*!
@@ -370,6 +386,10 @@ double QwtAbstractScaleDraw::maxTickLength() const
   This method is often overloaded by applications to have individual
   labels.
 
+  The labels are cached by tickLabel(). When they depend on other
+  parameters than the value and the locale, labelFormatKey() needs to
+  be overloaded too.
+
   \param value Value
   \return Label string.
 */
@@ -378,6 +398,28 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
     return QLocale().toString( value );
 }
 
+/*!
+   \brief Key identifying the format of the labels
+
+   The cache for the tick labels is indexed by the key and the value
+   of a tick. The key is requested, after a new scale division has been
+   assigned and needs to be different for all settings, that have
+   an effect on label(). For a persistent label cache the labels are
+   taken from the cache as long as the key does not change - even when
+   a different scale division is assigned.
+
+   The default implementation returns the name of the locale.
+   Overloading label() usually implies overloading labelFormatKey(),
+   when the labels depend on the scale division or other parameters.
+
+   \return Key for the label format
+   \sa label(), tickLabel(), setLabelCache()
+*/
+QString QwtAbstractScaleDraw::labelFormatKey() const
+{
+    return QLocale().name();
+}
+
 /*!
    \brief Convert a value into its representing label and cache it.
 
@@ -386,17 +428,28 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
    calculation of the label sizes might be slow (really slow
    for rich text in Qt4), so it's necessary to cache the labels.
 
+   The labels are stored together with their sizes in a bounded
+   cache. When the cache is persistent it is kept, when the scale
+   division changes. So for a scrolling axis only the labels of
+   new ticks are created.
+
    \param font Font
    \param value Value
 
    \return Tick label
+   \sa labelFormatKey(), setLabelCache()
 */
 const QwtText &QwtAbstractScaleDraw::tickLabel(
     const QFont &font, double value ) const
 {
-    QMap<double, QwtText>::const_iterator it1 = d_data->labelCache.constFind( value );
-    if ( it1 != d_data->labelCache.constEnd() )
-        return *it1;
+    if ( d_data->labelFormatId < 0 )
+        d_data->labelFormatId = d_data->labelCache.formatId( labelFormatKey() );
+
+    const int formatId = d_data->labelFormatId;
+
+    const QwtText *cachedLabel = d_data->labelCache.find( formatId, value );
+    if ( cachedLabel )
+        return *cachedLabel;
 
     QwtText lbl = label( value );
     lbl.setRenderFlags( 0 );
@@ -404,18 +457,75 @@ const QwtText &QwtAbstractScaleDraw::tickLabel(
 
     ( void )lbl.textSize( font ); // initialize the internal cache
 
-    QMap<double, QwtText>::iterator it2 = d_data->labelCache.insert( value, lbl );
-    return *it2;
+    return *d_data->labelCache.insert( formatId, value, lbl );
+}
+
+/*!
+   Assign a cache for the tick labels
+
+   Scale draws with the same labelFormatKey() might share their
+   labels by assigning the same persistent cache.
+
+   \param cache Label cache
+   \sa labelCache(), labelFormatKey(), QwtScaleLabelCache
+*/
+void QwtAbstractScaleDraw::setLabelCache( const QwtScaleLabelCache &cache )
+{
+    d_data->labelCache = cache;
+
+    // the ids of the label formats are individual for each cache
+    d_data->labelFormatId = -1;
+}
+
+/*!
+   \return Cache for the tick labels
+   \sa setLabelCache()
+*/
+QwtScaleLabelCache QwtAbstractScaleDraw::labelCache() const
+{
+    return d_data->labelCache;
+}
+
+/*!
+   \brief En/Disable a persistent label cache
+
+   By default the cache is invalidated, when a new QwtScaleDiv is set.
+   A persistent cache is kept as long as labelFormatKey() does not
+   change, what avoids creating the labels again for scrolling or
+   zooming axes. This is only correct, when labelFormatKey() covers
+   all parameters, that have an effect on label() - f.e. when label()
+   has been overloaded.
+
+   \param on On/Off
+   \sa isLabelCachePersistent(), labelFormatKey(), invalidateCache()
+*/
+void QwtAbstractScaleDraw::setLabelCachePersistent( bool on )
+{
+    d_data->isLabelCachePersistent = on;
+}
+
+/*!
+   \return True, when the label cache is kept for a new QwtScaleDiv
+   \sa setLabelCachePersistent()
+*/
+bool QwtAbstractScaleDraw::isLabelCachePersistent() const
+{
+    return d_data->isLabelCachePersistent;
 }
 
 /*!
    Invalidate the cache used by tickLabel()
 
-   The cache is invalidated, when a new QwtScaleDiv is set. If
-   the labels need to be changed. while the same QwtScaleDiv is set,
+   The cache is invalidated, when a new QwtScaleDiv is set - unless
+   it is persistent and the labelFormatKey() does not change.
+   If the labels need to be changed for other reasons,
    invalidateCache() needs to be called manually.
+
+   \note All scale draws sharing the cache are affected
+   \sa setLabelCache(), setLabelCachePersistent()
 */
 void QwtAbstractScaleDraw::invalidateCache()
 {
     d_data->labelCache.clear();
+    d_data->labelFormatId = -1;
 }
@@ -17,8 +17,10 @@ class QwtText;
 class QPalette;
 class QPainter;
 class QFont;
+class QString;
 class QwtTransform;
 class QwtScaleMap;
+class QwtScaleLabelCache;
 
 /*!
   \brief A abstract base class for drawing scales
@@ -95,6 +97,12 @@ public:
     void setMinimumExtent( double );
     double minimumExtent() const;
 
+    void setLabelCache( const QwtScaleLabelCache & );
+    QwtScaleLabelCache labelCache() const;
+
+    void setLabelCachePersistent( bool );
+    bool isLabelCachePersistent() const;
+
     void invalidateCache();
 
 protected:
@@ -127,6 +135,8 @@ protected:
     */
     virtual void drawLabel( QPainter *painter, double value ) const = 0;
 
+    virtual QString labelFormatKey() const;
+
     const QwtText &tickLabel( const QFont &, double value ) const;
 
 private:
@@ -250,3 +250,46 @@ QPointF QwtBezier::pointAt( const QPointF &p1,
     return QPointF( x, y );
 }
 
+
+/*!
+  Find points on a Bézier Curve for a series of parameter values
+
+  pointsAt() is the batch version of pointAt() for evaluating many
+  parameter values of the same curve. The loop has no dependencies
+  between the iterations and can be vectorized by the compiler.
+
+  \param p1 Start point
+  \param cp1 First control point
+  \param cp2 Second control point
+  \param p2 End point
+  \param t Array of parameter values, something between [0,1]
+  \param count Number of parameter values
+  \param points Array of at least count points, where the results are stored
+
+  \sa pointAt()
+ */
+void QwtBezier::pointsAt( const QPointF &p1,
+    const QPointF &cp1, const QPointF &cp2, const QPointF &p2,
+    const double *t, int count, QPointF *points )
+{
+    const double x1 = p1.x();
+    const double y1 = p1.y();
+    const double cx1 = 3.0 * cp1.x();
+    const double cy1 = 3.0 * cp1.y();
+    const double cx2 = 3.0 * cp2.x();
+    const double cy2 = 3.0 * cp2.y();
+    const double x2 = p2.x();
+    const double y2 = p2.y();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const double ti = t[i];
+
+        const double d2 = ti * ti;
+        const double d3 = d2 * ti;
+        const double s  = 1.0 - ti;
+
+        points[i].rx() = ( ( s * x1 + ti * cx1 ) * s + d2 * cx2 ) * s + d3 * x2;
+        points[i].ry() = ( ( s * y1 + ti * cy1 ) * s + d2 * cy2 ) * s + d3 * y2;
+    }
+}
@@ -44,6 +44,10 @@ public:
     static QPointF pointAt( const QPointF &p1, const QPointF &cp1,
         const QPointF &cp2, const QPointF &p2, double t );
 
+    static void pointsAt( const QPointF &p1, const QPointF &cp1,
+        const QPointF &cp2, const QPointF &p2,
+        const double *t, int count, QPointF *points );
+
 private:
     double m_tolerance;
     double m_flatness;
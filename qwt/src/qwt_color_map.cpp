@@ -11,6 +11,7 @@
 #include "qwt_interval.h"
 
 #include <qvector.h>
+#include <qnumeric.h>
 
 #if (__GNUC__ * 100 + __GNUC_MINOR__) >= 408
 
@@ -324,6 +325,56 @@ uint QwtColorMap::colorIndex( int numColors,
 #pragma GCC pop_options
 #endif
 
+/*!
+  \brief Map an array of values of a given interval into RGB values
+
+  The default implementation calls rgb() for each value. As this method
+  is used for rendering images, color maps should overload it, when
+  they can map many values more efficiently.
+
+  \param interval Range for all values
+  \param values Array of values
+  \param numValues Number of values
+  \param rgbs Array of numValues RGB values, that will be filled
+
+  \note NaN values are mapped to 0u ( transparent )
+  \sa rgb(), colorIndexes()
+*/
+void QwtColorMap::rgbValues( const QwtInterval &interval,
+    const double *values, int numValues, QRgb *rgbs ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+        rgbs[i] = qIsNaN( value ) ? 0u : rgb( interval, value );
+    }
+}
+
+/*!
+  \brief Map an array of values of a given interval into color indexes
+
+  The default implementation calls colorIndex() for each value.
+
+  \param numColors Number of colors, not more than 256
+  \param interval Range for all values
+  \param values Array of values
+  \param numValues Number of values
+  \param indexes Array of numValues indexes, that will be filled
+
+  \note NaN values are mapped to 0
+  \sa colorIndex(), rgbValues()
+*/
+void QwtColorMap::colorIndexes( int numColors, const QwtInterval &interval,
+    const double *values, int numValues, uchar *indexes ) const
+{
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double value = values[i];
+        indexes[i] = qIsNaN( value ) ? 0 : static_cast<uchar>(
+            colorIndex( numColors, interval, value ) );
+    }
+}
+
 /*!
    Build and return a color map of 256 colors
 
@@ -369,8 +420,35 @@ QVector<QRgb> QwtColorMap::colorTable( int numColors ) const
 class QwtLinearColorMap::PrivateData
 {
 public:
+    enum { LookupTableSize = 4096 };
+
+    void updateLookupTable()
+    {
+        /*
+          For ScaledColors the colors are precalculated for equidistant
+          positions, so that mapping an array of values is reduced
+          to a table lookup. The table is updated, whenever the map is
+          modified, so that it can be read from several threads
+          without any locking.
+         */
+        if ( mode == ScaledColors )
+        {
+            lookupTable.resize( LookupTableSize );
+
+            const double step = 1.0 / ( LookupTableSize - 1 );
+            for ( int i = 0; i < LookupTableSize; i++ )
+                lookupTable[i] = colorStops.rgb( ScaledColors, i * step );
+        }
+        else
+        {
+            lookupTable.clear();
+        }
+    }
+
     ColorStops colorStops;
     QwtLinearColorMap::Mode mode;
+
+    QVector<QRgb> lookupTable;
 };
 
 /*!
@@ -421,7 +499,11 @@ QwtLinearColorMap::~QwtLinearColorMap()
 */
 void QwtLinearColorMap::setMode( Mode mode )
 {
-    d_data->mode = mode;
+    if ( mode != d_data->mode )
+    {
+        d_data->mode = mode;
+        d_data->updateLookupTable();
+    }
 }
 
 /*!
@@ -449,6 +531,8 @@ void QwtLinearColorMap::setColorInterval(
     d_data->colorStops = ColorStops();
     d_data->colorStops.insert( 0.0, color1 );
     d_data->colorStops.insert( 1.0, color2 );
+
+    d_data->updateLookupTable();
 }
 
 /*!
@@ -464,7 +548,10 @@ void QwtLinearColorMap::setColorInterval(
 void QwtLinearColorMap::addColorStop( double value, const QColor& color )
 {
     if ( value >= 0.0 && value <= 1.0 )
+    {
         d_data->colorStops.insert( value, color );
+        d_data->updateLookupTable();
+    }
 }
 
 /*!
@@ -554,6 +641,117 @@ uint QwtLinearColorMap::colorIndex( int numColors,
 #pragma GCC pop_options
 #endif
 
+/*!
+  \brief Map an array of values of a given interval into RGB values
+
+  In ScaledColors mode the colors are taken from a table of 4096
+  precalculated colors, what is faster than interpolating the color stops
+  for each value, but not noticeably different.
+
+  \param interval Range for all values
+  \param values Array of values
+  \param numValues Number of values
+  \param rgbs Array of numValues RGB values, that will be filled
+
+  \note NaN values are mapped to 0u ( transparent )
+  \sa rgb()
+*/
+void QwtLinearColorMap::rgbValues( const QwtInterval &interval,
+    const double *values, int numValues, QRgb *rgbs ) const
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            rgbs[i] = 0u;
+
+        return;
+    }
+
+    const double min = interval.minValue();
+
+    if ( d_data->lookupTable.isEmpty() )
+    {
+        const ColorStops &colorStops = d_data->colorStops;
+
+        for ( int i = 0; i < numValues; i++ )
+        {
+            const double value = values[i];
+
+            rgbs[i] = qIsNaN( value ) ? 0u
+                : colorStops.rgb( d_data->mode, ( value - min ) / width );
+        }
+
+        return;
+    }
+
+    const QRgb *table = d_data->lookupTable.constData();
+
+    const int maxIndex = d_data->lookupTable.size() - 1;
+    const double factor = maxIndex / width;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double v = ( values[i] - min ) * factor;
+
+        if ( v > 0.0 )
+        {
+            rgbs[i] = ( v < maxIndex ) ? table[ int( v + 0.5 ) ] : table[maxIndex];
+        }
+        else
+        {
+            rgbs[i] = qIsNaN( v ) ? 0u : table[0];
+        }
+    }
+}
+
+/*!
+  \brief Map an array of values of a given interval into color indexes
+
+  \param numColors Size of the color table, not more than 256
+  \param interval Range for all values
+  \param values Array of values
+  \param numValues Number of values
+  \param indexes Array of numValues indexes, that will be filled
+
+  \note NaN values are mapped to 0
+  \sa colorIndex()
+*/
+void QwtLinearColorMap::colorIndexes( int numColors, const QwtInterval &interval,
+    const double *values, int numValues, uchar *indexes ) const
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        for ( int i = 0; i < numValues; i++ )
+            indexes[i] = 0;
+
+        return;
+    }
+
+    const double min = interval.minValue();
+    const int maxIndex = numColors - 1;
+    const double factor = maxIndex / width;
+
+    // FixedColors truncates, ScaledColors rounds
+    const double offset = ( d_data->mode == FixedColors ) ? 0.0 : 0.5;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double v = ( values[i] - min ) * factor;
+
+        if ( v > 0.0 )
+        {
+            indexes[i] = static_cast<uchar>(
+                ( v < maxIndex ) ? int( v + offset ) : maxIndex );
+        }
+        else
+        {
+            indexes[i] = 0; // also for NaN
+        }
+    }
+}
+
 class QwtAlphaColorMap::PrivateData
 {
 public:
@@ -635,8 +833,8 @@ void QwtAlphaColorMap::setAlphaInterval( int alpha1, int alpha2 )
     d_data->alpha1 = qBound( 0, alpha1, 255 );
     d_data->alpha2 = qBound( 0, alpha2, 255 );
 
-    d_data->rgbMin = d_data->rgb | ( alpha1 << 24 );
-    d_data->rgbMax = d_data->rgb | ( alpha2 << 24 );
+    d_data->rgbMin = d_data->rgb | ( d_data->alpha1 << 24 );
+    d_data->rgbMax = d_data->rgb | ( d_data->alpha2 << 24 );
 }
 
 /*!
@@ -672,7 +870,7 @@ QRgb QwtAlphaColorMap::rgb( const QwtInterval &interval, double value ) const
         return 0u;
 
     if ( value <= interval.minValue() )
-        return d_data->rgb;
+        return d_data->rgbMin;
 
     if ( value >= interval.maxValue() )
         return d_data->rgbMax;
@@ -28,6 +28,11 @@ template <typename T> class QVector;
   - QImage::Format_Indexed8\n
   - QImage::Format_ARGB32\n
 
+  For rendering images many values have to be mapped at once.
+  rgbValues() and colorIndexes() map arrays of values and
+  are overloaded by the built-in color maps with implementations,
+  that avoid the overhead of a virtual call per value.
+
   \sa QwtPlotSpectrogram, QwtScaleWidget
 */
 
@@ -76,6 +81,12 @@ public:
     virtual uint colorIndex( int numColors,
         const QwtInterval &interval, double value ) const;
 
+    virtual void rgbValues( const QwtInterval &,
+        const double *values, int numValues, QRgb *rgbs ) const;
+
+    virtual void colorIndexes( int numColors, const QwtInterval &,
+        const double *values, int numValues, uchar *indexes ) const;
+
     QColor color( const QwtInterval &, double value ) const;
     virtual QVector<QRgb> colorTable( int numColors ) const;
     virtual QVector<QRgb> colorTable256() const;
@@ -131,6 +142,12 @@ public:
     virtual uint colorIndex( int numColors,
         const QwtInterval &, double value ) const QWT_OVERRIDE;
 
+    virtual void rgbValues( const QwtInterval &,
+        const double *values, int numValues, QRgb *rgbs ) const QWT_OVERRIDE;
+
+    virtual void colorIndexes( int numColors, const QwtInterval &,
+        const double *values, int numValues, uchar *indexes ) const QWT_OVERRIDE;
+
     class ColorStops;
 
 private:
@@ -13,6 +13,7 @@
 
 #include <qpainter.h>
 #include <qpalette.h>
+#include <qvector.h>
 
 static void qwtDrawBox( QPainter *p, const QRectF &rect,
     const QPalette &pal, double lw )
@@ -254,6 +255,114 @@ void QwtColumnSymbol::draw( QPainter *painter,
     painter->restore();
 }
 
+/*!
+  Draw the symbol for a series of columns
+
+  For the Box style() with a NoFrame or Plain frameStyle() and a palette
+  with solid brushes the columns are collected and painted with one
+  QPainter::drawRects() call for the frames and one for the interiors.
+  In all other cases draw() is called for each column.
+
+  \param painter Painter
+  \param rects Directed rectangles
+  \param numRects Number of rectangles
+
+  \note Derived classes, that overload draw() for the Box style need to
+         overload drawColumns() as well.
+
+  \sa draw(), drawBox()
+*/
+void QwtColumnSymbol::drawColumns( QPainter *painter,
+    const QwtColumnRect *rects, int numRects ) const
+{
+    if ( numRects <= 0 )
+        return;
+
+    const QPalette &pal = d_data->palette;
+
+    bool doBatch = ( d_data->style == QwtColumnSymbol::Box )
+        && ( d_data->frameStyle != QwtColumnSymbol::Raised )
+        && ( pal.window().style() == Qt::SolidPattern );
+
+    const bool hasFrame = ( d_data->frameStyle == QwtColumnSymbol::Plain )
+        && ( d_data->lineWidth > 0 );
+
+    if ( doBatch && hasFrame )
+    {
+        // the interior is painted on top of the frame
+        doBatch = ( pal.dark().style() == Qt::SolidPattern )
+            && ( pal.window().color().alpha() == 255 );
+    }
+
+    if ( !doBatch )
+    {
+        for ( int i = 0; i < numRects; i++ )
+            draw( painter, rects[i] );
+
+        return;
+    }
+
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    QVector<QRectF> frameRects;
+    if ( hasFrame )
+        frameRects.reserve( numRects );
+
+    QVector<QRectF> windowRects;
+    windowRects.reserve( numRects );
+
+    for ( int i = 0; i < numRects; i++ )
+    {
+        QRectF r = rects[i].toRect();
+        if ( doAlign )
+        {
+            r.setLeft( qRound( r.left() ) );
+            r.setRight( qRound( r.right() ) );
+            r.setTop( qRound( r.top() ) );
+            r.setBottom( qRound( r.bottom() ) );
+        }
+
+        if ( !hasFrame )
+        {
+            windowRects += r.adjusted( 0, 0, 1, 1 );
+            continue;
+        }
+
+        // see qwtDrawBox
+
+        frameRects += r.adjusted( 0, 0, 1, 1 );
+
+        if ( r.width() == 0.0 || r.height() == 0.0 )
+            continue;
+
+        double lw = d_data->lineWidth;
+        lw = qwtMinF( lw, r.height() / 2.0 - 1.0 );
+        lw = qwtMinF( lw, r.width() / 2.0 - 1.0 );
+
+        const QRectF windowRect = r.adjusted( lw, lw, -lw + 1, -lw + 1 );
+        if ( windowRect.isValid() )
+            windowRects += windowRect;
+    }
+
+    painter->save();
+
+    painter->setPen( Qt::NoPen );
+
+    if ( !frameRects.isEmpty() )
+    {
+        painter->setBrush( pal.dark() );
+        painter->drawRects( frameRects.constData(), frameRects.size() );
+    }
+
+    if ( !windowRects.isEmpty() )
+    {
+        painter->setBrush( pal.window() );
+        painter->drawRects( windowRects.constData(), windowRects.size() );
+    }
+
+    painter->restore();
+}
+
 /*!
   Draw the symbol when it is in Box style.
 
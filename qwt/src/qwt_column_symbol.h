@@ -131,6 +131,9 @@ public:
 
     virtual void draw( QPainter *, const QwtColumnRect & ) const;
 
+    virtual void drawColumns( QPainter *,
+        const QwtColumnRect *rects, int numRects ) const;
+
 protected:
     void drawBox( QPainter *, const QwtColumnRect & ) const;
 
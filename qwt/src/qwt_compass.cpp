@@ -90,6 +90,7 @@ QwtCompassScaleDraw::~QwtCompassScaleDraw()
 void QwtCompassScaleDraw::setLabelMap( const QMap<double, QString> &map )
 {
     d_data->labelMap = map;
+    invalidateCache();
 }
 
 /*!
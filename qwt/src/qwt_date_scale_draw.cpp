@@ -65,6 +65,7 @@ QwtDateScaleDraw::~QwtDateScaleDraw()
 void QwtDateScaleDraw::setTimeSpec( Qt::TimeSpec timeSpec )
 {
     d_data->timeSpec = timeSpec;
+    invalidateCache();
 }
 
 /*!
@@ -89,6 +90,7 @@ Qt::TimeSpec QwtDateScaleDraw::timeSpec() const
 void QwtDateScaleDraw::setUtcOffset( int seconds )
 {
     d_data->utcOffset = seconds;
+    invalidateCache();
 }
 
 /*!
@@ -115,6 +117,7 @@ int QwtDateScaleDraw::utcOffset() const
 void QwtDateScaleDraw::setWeek0Type( QwtDate::Week0Type week0Type )
 {
     d_data->week0Type = week0Type;
+    invalidateCache();
 }
 
 /*!
@@ -141,6 +144,7 @@ void QwtDateScaleDraw::setDateFormat(
         intervalType <= QwtDate::Year )
     {
         d_data->dateFormats[ intervalType ] = format;
+        invalidateCache();
     }
 }
 
@@ -211,6 +215,37 @@ QwtText QwtDateScaleDraw::label( double value ) const
     return QwtDate::toString( dt, fmt, d_data->week0Type );
 }
 
+/*!
+  \brief Key identifying the format of the labels
+
+  The key is built from the interval type of the scale division,
+  the corresponding format string and the time specification.
+  So with a persistent label cache the tick labels of a scrolling time
+  axis are kept as long as the interval type does not change.
+
+  \return Key for the label format
+  \sa QwtAbstractScaleDraw::labelFormatKey(), intervalType(),
+      QwtAbstractScaleDraw::setLabelCachePersistent()
+*/
+QString QwtDateScaleDraw::labelFormatKey() const
+{
+    const QwtDate::IntervalType type = intervalType( scaleDiv() );
+
+    QString key = QwtScaleDraw::labelFormatKey();
+    key += QLatin1Char( ';' );
+    key += QString::number( type );
+    key += QLatin1Char( ';' );
+    key += QString::number( d_data->timeSpec );
+    key += QLatin1Char( ';' );
+    key += QString::number( d_data->utcOffset );
+    key += QLatin1Char( ';' );
+    key += QString::number( d_data->week0Type );
+    key += QLatin1Char( ';' );
+    key += dateFormat( type );
+
+    return key;
+}
+
 /*!
   Find the less detailed datetime unit, where no rounding
   errors happen.
@@ -78,6 +78,8 @@ protected:
     virtual QString dateFormatOfDate( const QDateTime &,
         QwtDate::IntervalType ) const;
 
+    virtual QString labelFormatKey() const QWT_OVERRIDE;
+
 private:
     class PrivateData;
     PrivateData *d_data;
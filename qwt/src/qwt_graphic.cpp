@@ -17,6 +17,11 @@
 #include <qimage.h>
 #include <qpixmap.h>
 #include <qpainterpath.h>
+#include <qcache.h>
+#include <qmutex.h>
+#include <qatomic.h>
+#include <qstring.h>
+#include <qdatastream.h>
 
 #if QT_VERSION >= 0x050000
 
@@ -29,6 +34,125 @@ static inline qreal qwtDevicePixelRatio()
 
 #endif
 
+// images of graphics larger than this are not cached
+static const int qwtMaxRasterPixels = 512 * 512;
+
+static const quint32 qwtStreamMagic = 0x51774772; // "QwGr"
+static const quint16 qwtStreamVersion = 1;
+
+namespace
+{
+    class RasterCache
+    {
+    public:
+        RasterCache()
+        {
+            cache.setMaxCost( 4096 );
+        }
+
+        QMutex mutex;
+        QCache< QString, QImage > cache; // cost in kilobytes
+    };
+}
+
+Q_GLOBAL_STATIC( RasterCache, qwtRasterCache )
+
+static QBasicAtomicInt qwtCacheIdCounter = Q_BASIC_ATOMIC_INITIALIZER( 0 );
+
+/*
+    Each modification of a graphic gets a new id, while copies
+    share the id of their source. So copies of a graphic find
+    the images of each other in the raster cache.
+ */
+static inline int qwtNextCacheId()
+{
+    return qwtCacheIdCounter.fetchAndAddRelaxed( 1 ) + 1;
+}
+
+static inline qreal qwtDevicePixelRatio( const QPainter *painter )
+{
+#if QT_VERSION >= 0x050600
+    return painter->device()->devicePixelRatioF();
+#elif QT_VERSION >= 0x050000
+    return painter->device()->devicePixelRatio();
+#else
+    Q_UNUSED( painter )
+    return 1.0;
+#endif
+}
+
+static inline bool qwtIsIntegral( double value )
+{
+    return value == qRound( value );
+}
+
+static bool qwtCanCacheRaster( const QPainter *painter, const QRectF &rect )
+{
+    if ( painter == NULL || !painter->isActive() )
+        return false;
+
+    const QPaintDevice *pd = painter->device();
+    if ( pd == NULL )
+        return false;
+
+    /*
+        Pixmaps and images are rasterized anyway and painting
+        an image on them would not be faster than painting the
+        graphic itself ( f.e. toPixmap() or toImage() ).
+     */
+    if ( pd->devType() != QInternal::Widget )
+        return false;
+
+    const QTransform transform = painter->combinedTransform();
+    if ( transform.type() > QTransform::TxTranslate )
+        return false;
+
+    if ( painter->opacity() < 1.0 ||
+        painter->compositionMode() != QPainter::CompositionMode_SourceOver )
+    {
+        return false;
+    }
+
+    if ( rect.isEmpty() )
+        return false;
+
+    const qreal ratio = qwtDevicePixelRatio( painter );
+
+    const double numPixels = rect.width() * rect.height() * ratio * ratio;
+    if ( numPixels > qwtMaxRasterPixels )
+        return false;
+
+    /*
+        The image would be painted with interpolation at fractional
+        device positions, what differs from painting the graphic itself
+     */
+    const QPointF pos = transform.map( rect.topLeft() ) * ratio;
+    if ( !qwtIsIntegral( pos.x() ) || !qwtIsIntegral( pos.y() ) )
+        return false;
+
+    return QwtGraphic::rasterCacheLimit() > 0;
+}
+
+static QString qwtRasterKey( int cacheId, const QPainter *painter,
+    const QSizeF &size, Qt::AspectRatioMode aspectRatioMode )
+{
+    const QChar separator( 0x1f );
+
+    QString key = QString::number( cacheId );
+    key += separator;
+    key += QString::number( int( aspectRatioMode ) );
+    key += separator;
+    key += QString::number( int( painter->renderHints() ) );
+    key += separator;
+    key += QString::number( qwtDevicePixelRatio( painter ) );
+    key += separator;
+    key += QString::number( size.width() );
+    key += QLatin1Char( 'x' );
+    key += QString::number( size.height() );
+
+    return key;
+}
+
 static bool qwtHasScalablePen( const QPainter *painter )
 {
     const QPen pen = painter->pen();
@@ -213,6 +337,113 @@ static inline void qwtExecCommand(
     }
 }
 
+static inline bool qwtCanMergeStates(
+    const QwtPainterCommand::StateData &state1,
+    const QwtPainterCommand::StateData &state2 )
+{
+    const QPaintEngine::DirtyFlags clipFlags = QPaintEngine::DirtyClipEnabled
+        | QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath;
+
+    if ( state1.flags & clipFlags )
+    {
+        /*
+            Clip regions/paths are combined with the current clip
+            and are mapped by the current transformation. So the
+            order of these operations has to be preserved.
+         */
+        if ( state2.flags & ( clipFlags | QPaintEngine::DirtyTransform ) )
+            return false;
+    }
+
+    return true;
+}
+
+static void qwtMergeStates( QwtPainterCommand::StateData &state1,
+    const QwtPainterCommand::StateData &state2 )
+{
+    const QPaintEngine::DirtyFlags flags = state2.flags;
+
+    if ( flags & QPaintEngine::DirtyPen )
+        state1.pen = state2.pen;
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        state1.brush = state2.brush;
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        state1.brushOrigin = state2.brushOrigin;
+
+    if ( flags & QPaintEngine::DirtyFont )
+        state1.font = state2.font;
+
+    if ( flags & QPaintEngine::DirtyBackground )
+    {
+        state1.backgroundMode = state2.backgroundMode;
+        state1.backgroundBrush = state2.backgroundBrush;
+    }
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        state1.transform = state2.transform;
+
+    if ( flags & QPaintEngine::DirtyClipEnabled )
+        state1.isClipEnabled = state2.isClipEnabled;
+
+    if ( flags & QPaintEngine::DirtyClipRegion )
+    {
+        state1.clipRegion = state2.clipRegion;
+        state1.clipOperation = state2.clipOperation;
+    }
+
+    if ( flags & QPaintEngine::DirtyClipPath )
+    {
+        state1.clipPath = state2.clipPath;
+        state1.clipOperation = state2.clipOperation;
+    }
+
+    if ( flags & QPaintEngine::DirtyHints )
+        state1.renderHints = state2.renderHints;
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        state1.compositionMode = state2.compositionMode;
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        state1.opacity = state2.opacity;
+
+    state1.flags |= flags;
+}
+
+static inline bool qwtHasRelativeGradient( const QBrush &brush )
+{
+    const QGradient *gradient = brush.gradient();
+    return gradient && gradient->coordinateMode() != QGradient::LogicalMode;
+}
+
+/*
+    Paths can be joined, when the areas covered by them don't overlap
+    for all scale factors. Then the order of the fill and stroke
+    operations has no effect. Because cosmetic pens don't scale with
+    the path we don't join paths, that are painted with them.
+ */
+static bool qwtJoinRect( const QPen &pen, const QBrush &brush,
+    const QPainterPath &path, QRectF &rect )
+{
+    if ( qwtHasRelativeGradient( brush ) )
+        return false;
+
+    qreal margin = 0.0;
+
+    if ( pen.style() != Qt::NoPen )
+    {
+        if ( pen.isCosmetic() || qwtHasRelativeGradient( pen.brush() ) )
+            return false;
+
+        // a generous estimation, that includes miter joins and square caps
+        margin = pen.widthF() * qwtMaxF( pen.miterLimit(), 1.0 );
+    }
+
+    rect = path.controlPointRect().adjusted( -margin, -margin, margin, margin );
+    return true;
+}
+
 class QwtGraphic::PathInfo
 {
 public:
@@ -320,6 +551,21 @@ public:
         return sy;
     }
 
+    inline QRectF pointRect() const
+    {
+        return d_pointRect;
+    }
+
+    inline QRectF boundingRect() const
+    {
+        return d_boundingRect;
+    }
+
+    inline bool hasScalablePen() const
+    {
+        return d_scalablePen;
+    }
+
 private:
     QRectF d_pointRect;
     QRectF d_boundingRect;
@@ -331,10 +577,18 @@ class QwtGraphic::PrivateData
 public:
     PrivateData():
         boundingRect( 0.0, 0.0, -1.0, -1.0 ),
-        pointRect( 0.0, 0.0, -1.0, -1.0 )
+        pointRect( 0.0, 0.0, -1.0, -1.0 ),
+        cacheId( qwtNextCacheId() ),
+        isPenKnown( false ),
+        isBrushKnown( false ),
+        isJoinable( false ),
+        hasJoinedStrokes( false )
     {
     }
 
+    void appendReplayCommand( const QwtPainterCommand & );
+    void resetReplay();
+
     QSizeF defaultSize;
     QVector< QwtPainterCommand > commands;
     QVector< QwtGraphic::PathInfo > pathInfos;
@@ -344,8 +598,115 @@ public:
 
     QwtGraphic::CommandTypes commandTypes;
     QwtGraphic::RenderHints renderHints;
+
+    int cacheId;
+
+    // the optimized commands, that are used by renderGraphic
+    QVector< QwtPainterCommand > replayCommands;
+
+    QPen replayPen;
+    QBrush replayBrush;
+    QRectF joinedRect;
+
+    bool isPenKnown;
+    bool isBrushKnown;
+    bool isJoinable;
+    bool hasJoinedStrokes;
 };
 
+void QwtGraphic::PrivateData::appendReplayCommand(
+    const QwtPainterCommand &cmd )
+{
+    QwtPainterCommand *last = NULL;
+    if ( !replayCommands.isEmpty() )
+        last = &replayCommands.last();
+
+    switch( cmd.type() )
+    {
+        case QwtPainterCommand::State:
+        {
+            const QwtPainterCommand::StateData *data = cmd.stateData();
+
+            if ( data->flags & QPaintEngine::DirtyPen )
+            {
+                replayPen = data->pen;
+                isPenKnown = true;
+            }
+
+            if ( data->flags & QPaintEngine::DirtyBrush )
+            {
+                replayBrush = data->brush;
+                isBrushKnown = true;
+            }
+
+            if ( last && last->type() == QwtPainterCommand::State
+                && qwtCanMergeStates( *last->stateData(), *data ) )
+            {
+                qwtMergeStates( *last->stateData(), *data );
+            }
+            else
+            {
+                replayCommands += cmd;
+            }
+
+            break;
+        }
+        case QwtPainterCommand::Path:
+        {
+            const QPainterPath &path = *cmd.path();
+            if ( path.isEmpty() )
+            {
+                // painting an empty path has no effect
+                break;
+            }
+
+            QRectF rect;
+
+            const bool joinable = isPenKnown && isBrushKnown
+                && qwtJoinRect( replayPen, replayBrush, path, rect );
+
+            if ( joinable && isJoinable
+                && last && last->type() == QwtPainterCommand::Path
+                && last->path()->fillRule() == path.fillRule()
+                && !joinedRect.intersects( rect ) )
+            {
+                last->path()->addPath( path );
+                joinedRect |= rect;
+
+                if ( replayPen.style() != Qt::NoPen )
+                    hasJoinedStrokes = true;
+            }
+            else
+            {
+                replayCommands += cmd;
+
+                isJoinable = joinable;
+                joinedRect = rect;
+            }
+
+            break;
+        }
+        default:
+        {
+            replayCommands += cmd;
+        }
+    }
+}
+
+void QwtGraphic::PrivateData::resetReplay()
+{
+    replayCommands.clear();
+
+    replayPen = QPen();
+    replayBrush = QBrush();
+    joinedRect = QRectF();
+
+    isPenKnown = false;
+    isBrushKnown = false;
+    isJoinable = false;
+    hasJoinedStrokes = false;
+}
+
 /*!
   \brief Constructor
 
@@ -400,8 +761,10 @@ void QwtGraphic::reset()
 {
     d_data->commands.clear();
     d_data->pathInfos.clear();
+    d_data->resetReplay();
 
     d_data->commandTypes = 0;
+    d_data->cacheId = qwtNextCacheId();
 
     d_data->boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     d_data->pointRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
@@ -444,10 +807,15 @@ QwtGraphic::CommandTypes QwtGraphic::commandTypes() const
 */
 void QwtGraphic::setRenderHint( RenderHint hint, bool on )
 {
+    if ( d_data->renderHints.testFlag( hint ) == on )
+        return;
+
     if ( on )
         d_data->renderHints |= hint;
     else
         d_data->renderHints &= ~hint;
+
+    d_data->cacheId = qwtNextCacheId();
 }
 
 /*!
@@ -633,8 +1001,20 @@ void QwtGraphic::renderGraphic( QPainter* painter, QTransform *initialTransform
     if ( isNull() )
         return;
 
-    const int numCommands = d_data->commands.size();
-    const QwtPainterCommand *commands = d_data->commands.constData();
+    const QVector< QwtPainterCommand > *cmds = &d_data->replayCommands;
+
+    if ( d_data->hasJoinedStrokes
+        && d_data->renderHints.testFlag( RenderPensUnscaled ) )
+    {
+        /*
+            Joined paths might overlap, when their pens
+            are not scaled together with the control points
+         */
+        cmds = &d_data->commands;
+    }
+
+    const int numCommands = cmds->size();
+    const QwtPainterCommand *commands = cmds->constData();
 
     const QTransform transform = painter->transform();
 
@@ -671,9 +1051,16 @@ void QwtGraphic::render( QPainter *painter, const QSizeF &size,
 
   The graphic is scaled to fit into the given rectangle
 
+  On widgets the graphic is painted from an image of the size of
+  the rectangle, that is stored in the raster cache. This is only
+  done for untransformed painters at integral device positions,
+  where the result is the same as rendering the graphic itself.
+
   \param painter Qt painter
   \param rect Rectangle for the scaled graphic
   \param aspectRatioMode Mode how to scale - See Qt::AspectRatioMode
+
+  \sa setRasterCacheLimit()
  */
 void QwtGraphic::render( QPainter *painter, const QRectF &rect,
     Qt::AspectRatioMode aspectRatioMode ) const
@@ -681,6 +1068,54 @@ void QwtGraphic::render( QPainter *painter, const QRectF &rect,
     if ( isEmpty() || rect.isEmpty() )
         return;
 
+    if ( qwtCanCacheRaster( painter, rect ) )
+    {
+        const QString key = qwtRasterKey( d_data->cacheId,
+            painter, rect.size(), aspectRatioMode );
+
+        RasterCache *rasterCache = qwtRasterCache();
+
+        QImage image;
+        {
+            QMutexLocker locker( &rasterCache->mutex );
+
+            const QImage *cachedImage = rasterCache->cache.object( key );
+            if ( cachedImage )
+                image = *cachedImage;
+        }
+
+        if ( image.isNull() )
+        {
+            const QSizeF size = rect.size();
+            const qreal ratio = qwtDevicePixelRatio( painter );
+
+            image = QImage( qwtCeil( size.width() * ratio ),
+                qwtCeil( size.height() * ratio ),
+                QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+            image.setDevicePixelRatio( ratio );
+#endif
+            image.fill( 0 );
+
+            // painting on an image is never cached: no recursion
+
+            QPainter imagePainter( &image );
+            imagePainter.setRenderHints( painter->renderHints() );
+            render( &imagePainter, QRectF( QPointF( 0.0, 0.0 ), size ),
+                aspectRatioMode );
+            imagePainter.end();
+
+            const int numBytes = image.bytesPerLine() * image.height();
+            const int cost = 1 + numBytes / 1024;
+
+            QMutexLocker locker( &rasterCache->mutex );
+            rasterCache->cache.insert( key, new QImage( image ), cost );
+        }
+
+        painter->drawImage( rect.topLeft(), image );
+        return;
+    }
+
     double sx = 1.0;
     double sy = 1.0;
 
@@ -989,8 +1424,13 @@ void QwtGraphic::drawPath( const QPainterPath &path )
     if ( painter == NULL )
         return;
 
-    d_data->commands += QwtPainterCommand( path );
+    const QwtPainterCommand cmd( path );
+
+    d_data->commands += cmd;
+    d_data->appendReplayCommand( cmd );
+
     d_data->commandTypes |= QwtGraphic::VectorData;
+    d_data->cacheId = qwtNextCacheId();
 
     if ( !path.isEmpty() )
     {
@@ -1029,8 +1469,13 @@ void QwtGraphic::drawPixmap( const QRectF &rect,
     if ( painter == NULL )
         return;
 
-    d_data->commands += QwtPainterCommand( rect, pixmap, subRect );
+    const QwtPainterCommand cmd( rect, pixmap, subRect );
+
+    d_data->commands += cmd;
+    d_data->appendReplayCommand( cmd );
+
     d_data->commandTypes |= QwtGraphic::RasterData;
+    d_data->cacheId = qwtNextCacheId();
 
     const QRectF r = painter->transform().mapRect( rect );
     updateControlPointRect( r );
@@ -1054,8 +1499,13 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
     if ( painter == NULL )
         return;
 
-    d_data->commands += QwtPainterCommand( rect, image, subRect, flags );
+    const QwtPainterCommand cmd( rect, image, subRect, flags );
+
+    d_data->commands += cmd;
+    d_data->appendReplayCommand( cmd );
+
     d_data->commandTypes |= QwtGraphic::RasterData;
+    d_data->cacheId = qwtNextCacheId();
 
     const QRectF r = painter->transform().mapRect( rect );
 
@@ -1071,7 +1521,12 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
  */
 void QwtGraphic::updateState( const QPaintEngineState &state )
 {
-    d_data->commands += QwtPainterCommand( state );
+    const QwtPainterCommand cmd( state );
+
+    d_data->commands += cmd;
+    d_data->appendReplayCommand( cmd );
+
+    d_data->cacheId = qwtNextCacheId();
 
     if ( state.state() & QPaintEngine::DirtyTransform )
     {
@@ -1152,3 +1607,178 @@ void QwtGraphic::setCommands( const QVector< QwtPainterCommand > &commands )
 
     painter.end();
 }
+
+/*!
+  \brief Set the maximum size of the raster cache
+
+  The raster cache stores the images, that are used by render()
+  for painting a graphic on widgets. It is shared by all
+  graphics. The default limit is 4096 kilobytes. A limit of 0 disables
+  caching.
+
+  \param kiloBytes Limit in kilobytes
+  \sa rasterCacheLimit(), clearRasterCache()
+ */
+void QwtGraphic::setRasterCacheLimit( int kiloBytes )
+{
+    RasterCache *rasterCache = qwtRasterCache();
+
+    QMutexLocker locker( &rasterCache->mutex );
+    rasterCache->cache.setMaxCost( qMax( kiloBytes, 0 ) );
+}
+
+/*!
+  \return Maximum size of the raster cache in kilobytes
+  \sa setRasterCacheLimit()
+ */
+int QwtGraphic::rasterCacheLimit()
+{
+    RasterCache *rasterCache = qwtRasterCache();
+
+    QMutexLocker locker( &rasterCache->mutex );
+    return rasterCache->cache.maxCost();
+}
+
+/*!
+  Remove all images from the raster cache
+  \sa setRasterCacheLimit()
+ */
+void QwtGraphic::clearRasterCache()
+{
+    RasterCache *rasterCache = qwtRasterCache();
+
+    QMutexLocker locker( &rasterCache->mutex );
+    rasterCache->cache.clear();
+}
+
+#ifndef QT_NO_DATASTREAM
+
+/*!
+  \brief Write a graphic to a stream
+
+  Beside the recorded commands the geometries of the graphic are
+  written, so that it can be read without replaying the commands.
+  Reading graphics from a memory mapped file can be done
+  without copying the data:
+
+  \code
+    QFile file( "symbols.dat" );
+    file.open( QIODevice::ReadOnly );
+
+    const uchar *data = file.map( 0, file.size() );
+
+    QDataStream stream( QByteArray::fromRawData(
+        reinterpret_cast< const char * >( data ), file.size() ) );
+
+    QwtGraphic graphic;
+    stream >> graphic;
+  \endcode
+
+  \param stream Output stream
+  \param graphic Graphic
+
+  \return Reference to the stream
+  \sa operator>>(QDataStream &, QwtGraphic &)
+ */
+QDataStream &operator<<( QDataStream &stream, const QwtGraphic &graphic )
+{
+    const QwtGraphic::PrivateData *data = graphic.d_data;
+
+    stream << qwtStreamMagic << qwtStreamVersion;
+
+    stream << data->defaultSize << quint32( data->renderHints )
+        << quint32( data->commandTypes )
+        << data->boundingRect << data->pointRect;
+
+    stream << qint32( data->pathInfos.size() );
+    for ( int i = 0; i < data->pathInfos.size(); i++ )
+    {
+        const QwtGraphic::PathInfo &info = data->pathInfos[i];
+
+        stream << info.pointRect() << info.boundingRect()
+            << info.hasScalablePen();
+    }
+
+    stream << qint32( data->commands.size() );
+    for ( int i = 0; i < data->commands.size(); i++ )
+        stream << data->commands[i];
+
+    return stream;
+}
+
+/*!
+  \brief Read a graphic from a stream
+
+  When the stream doesn't contain a valid graphic, the status of
+  the stream is set to QDataStream::ReadCorruptData and the graphic
+  is reset.
+
+  \param stream Input stream
+  \param graphic Graphic
+
+  \return Reference to the stream
+  \sa operator<<(QDataStream &, const QwtGraphic &)
+ */
+QDataStream &operator>>( QDataStream &stream, QwtGraphic &graphic )
+{
+    graphic.reset();
+
+    quint32 magic;
+    quint16 version;
+
+    stream >> magic >> version;
+
+    if ( stream.status() == QDataStream::Ok &&
+        ( magic != qwtStreamMagic || version > qwtStreamVersion ) )
+    {
+        stream.setStatus( QDataStream::ReadCorruptData );
+    }
+
+    if ( stream.status() != QDataStream::Ok )
+        return stream;
+
+    QwtGraphic::PrivateData *data = graphic.d_data;
+
+    QSizeF defaultSize;
+    quint32 renderHints, commandTypes;
+
+    stream >> defaultSize >> renderHints >> commandTypes
+        >> data->boundingRect >> data->pointRect;
+
+    data->defaultSize = defaultSize;
+    data->renderHints = static_cast< QwtGraphic::RenderHints >( renderHints );
+    data->commandTypes = static_cast< QwtGraphic::CommandTypes >( commandTypes );
+
+    qint32 numPathInfos;
+    stream >> numPathInfos;
+
+    for ( int i = 0; i < numPathInfos && stream.status() == QDataStream::Ok; i++ )
+    {
+        QRectF pointRect, boundingRect;
+        bool scalablePen;
+
+        stream >> pointRect >> boundingRect >> scalablePen;
+
+        data->pathInfos += QwtGraphic::PathInfo(
+            pointRect, boundingRect, scalablePen );
+    }
+
+    qint32 numCommands;
+    stream >> numCommands;
+
+    for ( int i = 0; i < numCommands && stream.status() == QDataStream::Ok; i++ )
+    {
+        QwtPainterCommand cmd;
+        stream >> cmd;
+
+        data->commands += cmd;
+        data->appendReplayCommand( cmd );
+    }
+
+    if ( stream.status() != QDataStream::Ok )
+        graphic.reset();
+
+    return stream;
+}
+
+#endif
@@ -18,6 +18,7 @@
 class QwtPainterCommand;
 class QPixmap;
 class QImage;
+class QDataStream;
 
 /*!
     \brief A paint device for scalable graphics
@@ -70,6 +71,20 @@ class QImage;
     scaling with a fixed aspect ratio always needs to be calculated from the
     control point rectangle.
 
+    Beside the recorded commands QwtGraphic maintains a shorter list of
+    commands for replaying the graphic. Consecutive state changes are merged
+    into one command and consecutive paths, that are painted with the same
+    state and do not overlap, are joined into one path.
+
+    When rendering to a widget with a translation to integral device
+    positions only, render() takes the graphic from an image, that has
+    been rendered for the size of the target rectangle before. These images are stored in a global cache,
+    that is shared by all copies of the graphic - see setRasterCacheLimit().
+
+    A graphic can be written to and read from a QDataStream. As the
+    geometries are stored together with the commands, reading a graphic
+    is much faster than recording it again.
+
     \sa QwtPainterCommand
  */
 class QWT_EXPORT QwtGraphic: public QwtNullPaintDevice
@@ -181,6 +196,10 @@ public:
 
     RenderHints renderHints() const;
 
+    static void setRasterCacheLimit( int kiloBytes );
+    static int rasterCacheLimit();
+    static void clearRasterCache();
+
 protected:
     virtual QSize sizeMetrics() const QWT_OVERRIDE;
 
@@ -195,6 +214,14 @@ protected:
     virtual void updateState( const QPaintEngineState & ) QWT_OVERRIDE;
 
 private:
+#ifndef QT_NO_DATASTREAM
+    friend QWT_EXPORT QDataStream &operator<<(
+        QDataStream &, const QwtGraphic & );
+
+    friend QWT_EXPORT QDataStream &operator>>(
+        QDataStream &, QwtGraphic & );
+#endif
+
     void renderGraphic( QPainter *, QTransform * ) const;
 
     void updateBoundingRect( const QRectF & );
@@ -206,6 +233,11 @@ private:
     PrivateData *d_data;
 };
 
+#ifndef QT_NO_DATASTREAM
+QWT_EXPORT QDataStream &operator<<( QDataStream &, const QwtGraphic & );
+QWT_EXPORT QDataStream &operator>>( QDataStream &, QwtGraphic & );
+#endif
+
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtGraphic::RenderHints )
 Q_DECLARE_OPERATORS_FOR_FLAGS( QwtGraphic::CommandTypes )
 Q_DECLARE_METATYPE( QwtGraphic )
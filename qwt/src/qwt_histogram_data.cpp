@@ -0,0 +1,586 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_histogram_data.h"
+#include "qwt_interval.h"
+#include "qwt_math.h"
+
+#include <qvector.h>
+#include <qmutex.h>
+#include <qnumeric.h>
+
+namespace
+{
+    enum
+    {
+        UnderflowIndex = -1,
+        IgnoredIndex = -2
+    };
+
+    /*
+        Parameters of the binning, that are copied, so that the
+        indexes can be calculated without holding the lock
+     */
+    class Binning
+    {
+    public:
+        Binning():
+            numBins( 0 ),
+            isLogarithmic( false ),
+            origin( 0.0 ),
+            factor( 0.0 )
+        {
+        }
+
+        inline double position( double value ) const
+        {
+            if ( isLogarithmic )
+                value = ( value > 0.0 ) ? std::log( value ) : -qInf();
+
+            return ( value - origin ) * factor;
+        }
+
+        inline double edge( int bin ) const
+        {
+            const double value = origin + bin / factor;
+            return isLogarithmic ? std::exp( value ) : value;
+        }
+
+        int numBins;
+        bool isLogarithmic;
+
+        // position = ( value - origin ) * factor, in linear or log scale
+        double origin;
+        double factor;
+    };
+}
+
+static void qwtBinIndexes( const Binning &binning,
+    const double *values, int numValues, int *indexes )
+{
+    /*
+        A loop without any dependencies between the iterations,
+        that can be vectorized by the compiler - at least for linear bins
+     */
+
+    const double numBins = binning.numBins;
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        const double pos = binning.position( values[i] );
+
+        int index;
+        if ( pos >= 0.0 )
+        {
+            // the upper boundary of the interval belongs to the last bin
+            index = ( pos < numBins ) ? int( pos )
+                : ( ( pos == numBins ) ? binning.numBins - 1 : binning.numBins );
+        }
+        else
+        {
+            index = ( pos < 0.0 ) ? UnderflowIndex : IgnoredIndex; // NaN
+        }
+
+        indexes[i] = index;
+    }
+}
+
+class QwtHistogramData::PrivateData
+{
+public:
+    PrivateData():
+        mode( QwtHistogramData::LinearBins ),
+        revision( 0 ),
+        maxVisibleBins( 0 ),
+        mergeShift( 0 ),
+        maxCount( 0.0 ),
+        totalCount( 0.0 ),
+        underflowCount( 0.0 ),
+        overflowCount( 0.0 )
+    {
+    }
+
+    inline int numMergedBins() const
+    {
+        const int n = binning.numBins;
+        return ( n + ( 1 << mergeShift ) - 1 ) >> mergeShift;
+    }
+
+    void updateMergedCounts()
+    {
+        mergedCounts.fill( 0.0, numMergedBins() );
+
+        for ( int i = 0; i < counts.size(); i++ )
+            mergedCounts[ i >> mergeShift ] += counts[i];
+
+        maxCount = 0.0;
+        for ( int i = 0; i < mergedCounts.size(); i++ )
+            maxCount = qwtMaxF( maxCount, mergedCounts[i] );
+    }
+
+    void accumulate( const int *indexes, int numIndexes )
+    {
+        const int numBins = binning.numBins;
+
+        double *c = counts.data();
+        double *mc = mergedCounts.data();
+
+        for ( int i = 0; i < numIndexes; i++ )
+        {
+            const int index = indexes[i];
+
+            if ( index >= 0 && index < numBins )
+            {
+                c[index] += 1.0;
+
+                double &mergedCount = mc[ index >> mergeShift ];
+                mergedCount += 1.0;
+
+                if ( mergedCount > maxCount )
+                    maxCount = mergedCount;
+
+                totalCount += 1.0;
+            }
+            else if ( index == UnderflowIndex )
+            {
+                underflowCount += 1.0;
+                totalCount += 1.0;
+            }
+            else if ( index == numBins )
+            {
+                overflowCount += 1.0;
+                totalCount += 1.0;
+            }
+        }
+    }
+
+    QMutex mutex;
+
+    QwtInterval interval;
+    QwtHistogramData::BinningMode mode;
+    Binning binning;
+
+    // incremented, whenever the binning changes
+    int revision;
+
+    int maxVisibleBins;
+    int mergeShift;
+
+    QVector<double> counts;
+    QVector<double> mergedCounts;
+
+    double maxCount; // of the merged bins
+    double totalCount;
+    double underflowCount;
+    double overflowCount;
+};
+
+/*!
+  \brief Constructor
+
+  The histogram has no bins and ignores all values until setBinning()
+  has been called.
+*/
+QwtHistogramData::QwtHistogramData()
+{
+    d_data = new PrivateData();
+}
+
+/*!
+  \brief Constructor
+
+  \param interval Interval of the bins
+  \param numBins Number of bins
+  \param mode Distribution of the bins
+
+  \sa setBinning()
+*/
+QwtHistogramData::QwtHistogramData( const QwtInterval &interval,
+    int numBins, BinningMode mode )
+{
+    d_data = new PrivateData();
+    setBinning( interval, numBins, mode );
+}
+
+//! Destructor
+QwtHistogramData::~QwtHistogramData()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Define the bins of the histogram
+
+  All counts are reset.
+
+  \param interval Interval of the bins. Values outside the interval
+                  are counted as underflow/overflow.
+  \param numBins Number of bins
+  \param mode Distribution of the bins
+
+  \sa interval(), numBins(), binningMode()
+*/
+void QwtHistogramData::setBinning( const QwtInterval &interval,
+    int numBins, BinningMode mode )
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    d_data->interval = interval.normalized();
+    d_data->mode = mode;
+
+    Binning binning;
+
+    double min = d_data->interval.minValue();
+    double max = d_data->interval.maxValue();
+
+    if ( mode == LogarithmicBins )
+    {
+        if ( min > 0.0 )
+        {
+            min = std::log( min );
+            max = std::log( max );
+        }
+        else
+        {
+            numBins = 0;
+        }
+
+        binning.isLogarithmic = true;
+    }
+
+    if ( numBins > 0 && max > min )
+    {
+        binning.numBins = numBins;
+        binning.origin = min;
+        binning.factor = numBins / ( max - min );
+    }
+
+    d_data->binning = binning;
+    d_data->revision++;
+
+    d_data->counts.fill( 0.0, binning.numBins );
+    d_data->mergeShift = 0;
+
+    d_data->totalCount = 0.0;
+    d_data->underflowCount = 0.0;
+    d_data->overflowCount = 0.0;
+
+    d_data->updateMergedCounts();
+}
+
+/*!
+  \return Interval of the bins
+  \sa setBinning()
+ */
+QwtInterval QwtHistogramData::interval() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->interval;
+}
+
+/*!
+  \return Number of bins of the base histogram
+  \sa setBinning(), size()
+ */
+int QwtHistogramData::numBins() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->binning.numBins;
+}
+
+/*!
+  \return Distribution of the bins
+  \sa setBinning()
+ */
+QwtHistogramData::BinningMode QwtHistogramData::binningMode() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->mode;
+}
+
+/*!
+  \brief Limit the number of bins inside the rectangle of interest
+
+  When the rectangle of interest contains more than numBins bins,
+  2, 4, 8 ... neighboured bins are merged. This way the base histogram
+  can have a much finer resolution, than what can be displayed for
+  the complete interval.
+
+  \param numBins Maximum for the number of visible bins. A value <= 0
+                 disables merging bins, what is the default setting.
+
+  \sa maxVisibleBins(), setRectOfInterest()
+ */
+void QwtHistogramData::setMaxVisibleBins( int numBins )
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    numBins = qMax( numBins, 0 );
+    if ( numBins != d_data->maxVisibleBins )
+    {
+        d_data->maxVisibleBins = numBins;
+
+        if ( numBins == 0 && d_data->mergeShift != 0 )
+        {
+            d_data->mergeShift = 0;
+            d_data->updateMergedCounts();
+        }
+    }
+}
+
+/*!
+  \return Maximum for the number of visible bins
+  \sa setMaxVisibleBins()
+ */
+int QwtHistogramData::maxVisibleBins() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->maxVisibleBins;
+}
+
+/*!
+  \brief Add a value to the histogram
+
+  \param value Value
+  \sa addValues()
+ */
+void QwtHistogramData::addValue( double value )
+{
+    addValues( &value, 1 );
+}
+
+/*!
+  \brief Add values to the histogram
+
+  The bins of the values are calculated without holding a lock,
+  so that adding values from a worker thread does not block
+  painting the histogram.
+
+  \param values Array of values
+  \param numValues Number of values
+
+  \note NaN values are ignored
+  \sa addValue(), clear()
+ */
+void QwtHistogramData::addValues( const double *values, int numValues )
+{
+    const int maxChunkSize = 4096;
+
+    int indexes[ maxChunkSize ];
+
+    for ( int from = 0; from < numValues; from += maxChunkSize )
+    {
+        const int chunkSize = qMin( maxChunkSize, numValues - from );
+
+        Binning binning;
+        int revision;
+
+        {
+            QMutexLocker locker( &d_data->mutex );
+
+            binning = d_data->binning;
+            revision = d_data->revision;
+        }
+
+        if ( binning.numBins == 0 )
+            return;
+
+        qwtBinIndexes( binning, values + from, chunkSize, indexes );
+
+        QMutexLocker locker( &d_data->mutex );
+
+        if ( revision != d_data->revision )
+        {
+            // the binning has been changed in the meantime
+            from -= maxChunkSize;
+            continue;
+        }
+
+        d_data->accumulate( indexes, chunkSize );
+    }
+}
+
+/*!
+  \brief Add values to the histogram
+
+  \param values Values
+  \sa addValue(), clear()
+ */
+void QwtHistogramData::addValues( const QVector<double> &values )
+{
+    addValues( values.constData(), values.size() );
+}
+
+/*!
+  \brief Reset all counts
+  \sa addValues()
+ */
+void QwtHistogramData::clear()
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    d_data->counts.fill( 0.0 );
+    d_data->mergedCounts.fill( 0.0 );
+
+    d_data->maxCount = 0.0;
+    d_data->totalCount = 0.0;
+    d_data->underflowCount = 0.0;
+    d_data->overflowCount = 0.0;
+}
+
+/*!
+  \param bin Index of a bin of the base histogram
+  \return Number of values in the bin
+  \sa binCounts(), numBins()
+ */
+double QwtHistogramData::binCount( int bin ) const
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    if ( bin < 0 || bin >= d_data->counts.size() )
+        return 0.0;
+
+    return d_data->counts[bin];
+}
+
+/*!
+  \return Counts of all bins of the base histogram
+  \sa binCount(), numBins()
+ */
+QVector<double> QwtHistogramData::binCounts() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->counts;
+}
+
+/*!
+  \return Number of all values, that have been added
+          since the last clear() or setBinning()
+ */
+double QwtHistogramData::totalCount() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->totalCount;
+}
+
+/*!
+  \return Number of values below the interval
+  \sa overflowCount(), interval()
+ */
+double QwtHistogramData::underflowCount() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->underflowCount;
+}
+
+/*!
+  \return Number of values above the interval
+  \sa underflowCount(), interval()
+ */
+double QwtHistogramData::overflowCount() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->overflowCount;
+}
+
+/*!
+  \return Number of visible bins, what is the number of bins of the
+          base histogram divided by the number of merged bins
+  \sa numBins(), setMaxVisibleBins()
+ */
+size_t QwtHistogramData::size() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->mergedCounts.size();
+}
+
+/*!
+  \param index Index of a visible bin
+  \return Interval and count of the bin
+ */
+QwtIntervalSample QwtHistogramData::sample( size_t index ) const
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    const int i = static_cast<int>( index );
+    if ( i < 0 || i >= d_data->mergedCounts.size() )
+        return QwtIntervalSample();
+
+    const Binning &binning = d_data->binning;
+
+    const int bin1 = i << d_data->mergeShift;
+    const int bin2 = qMin( ( i + 1 ) << d_data->mergeShift, binning.numBins );
+
+    // avoiding rounding errors at the boundaries
+    const double min = ( bin1 == 0 )
+        ? d_data->interval.minValue() : binning.edge( bin1 );
+
+    const double max = ( bin2 == binning.numBins )
+        ? d_data->interval.maxValue() : binning.edge( bin2 );
+
+    return QwtIntervalSample( d_data->mergedCounts[i], min, max );
+}
+
+/*!
+  \return Bounding rectangle of the visible bins
+
+  The maximum of the bins is updated, whenever values are added,
+  so that no iteration over the bins is necessary.
+ */
+QRectF QwtHistogramData::boundingRect() const
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    if ( d_data->binning.numBins == 0 )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+    const QwtInterval &interval = d_data->interval;
+
+    return QRectF( interval.minValue(), 0.0,
+        interval.width(), d_data->maxCount );
+}
+
+/*!
+  \brief Merge bins according to the visible area
+
+  \param rect Rectangle of interest
+  \sa setMaxVisibleBins(), QwtPlotSeriesItem::updateScaleDiv()
+ */
+void QwtHistogramData::setRectOfInterest( const QRectF &rect )
+{
+    QMutexLocker locker( &d_data->mutex );
+
+    const Binning &binning = d_data->binning;
+    if ( d_data->maxVisibleBins <= 0 || binning.numBins == 0 )
+        return;
+
+    double pos1 = binning.position( rect.left() );
+    double pos2 = binning.position( rect.right() );
+
+    if ( qIsNaN( pos1 ) || qIsNaN( pos2 ) )
+        return;
+
+    pos1 = qBound( 0.0, pos1, double( binning.numBins ) );
+    pos2 = qBound( 0.0, pos2, double( binning.numBins ) );
+
+    const int numVisible = qwtCeil( qAbs( pos2 - pos1 ) );
+
+    int shift = 0;
+    while ( ( ( numVisible + ( 1 << shift ) - 1 ) >> shift ) > d_data->maxVisibleBins
+        && ( 1 << shift ) < binning.numBins )
+    {
+        shift++;
+    }
+
+    if ( shift != d_data->mergeShift )
+    {
+        d_data->mergeShift = shift;
+        d_data->updateMergedCounts();
+    }
+}
@@ -0,0 +1,118 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_HISTOGRAM_DATA_H
+#define QWT_HISTOGRAM_DATA_H
+
+#include "qwt_global.h"
+#include "qwt_series_data.h"
+
+class QwtInterval;
+template <typename T> class QVector;
+
+/*!
+  \brief Histogram of raw values, that are binned incrementally
+
+  QwtHistogramData counts raw values into a fixed number of bins, that
+  are equidistant in linear or logarithmic scale. The values can be
+  added in batches - also from a worker thread - without having to
+  recalculate the histogram from scratch.
+
+  When setMaxVisibleBins() is enabled, the bins inside the rectangle
+  of interest ( QwtPlotSeriesItem::updateScaleDiv() ) are merged
+  into coarser bins, so that zooming in shows the details of the
+  base histogram, while zooming out reduces the number of columns.
+
+  The bounding rectangle is maintained, while values are added, so
+  that autoscaling does not need to iterate over the bins.
+
+  \par Example
+  \code
+    QwtHistogramData *histogramData =
+        new QwtHistogramData( QwtInterval( 0.0, 100.0 ), 10000 );
+    histogramData->setMaxVisibleBins( 200 );
+
+    QwtPlotHistogram *histogram = new QwtPlotHistogram();
+    histogram->setSamples( histogramData );
+
+    ...
+
+    // f.e. in a worker thread
+    histogramData->addValues( values.constData(), values.size() );
+  \endcode
+  \endpar
+
+  \note Adding values and reading the bins is serialized by a mutex.
+        Changing the binning has to be done from the thread, that is
+        painting the plot.
+
+  \note The rectangle of interest is evaluated for a vertical
+        histogram, where the bins are on the x axis.
+
+  \sa QwtPlotHistogram
+*/
+class QWT_EXPORT QwtHistogramData: public QwtSeriesData<QwtIntervalSample>
+{
+public:
+    //! Distribution of the bins
+    enum BinningMode
+    {
+        //! Bins of equal width
+        LinearBins,
+
+        /*!
+          Bins of equal width in logarithmic scale. The interval of the
+          histogram needs to be positive.
+         */
+        LogarithmicBins
+    };
+
+    QwtHistogramData();
+    QwtHistogramData( const QwtInterval &, int numBins,
+        BinningMode = LinearBins );
+
+    virtual ~QwtHistogramData();
+
+    void setBinning( const QwtInterval &, int numBins,
+        BinningMode = LinearBins );
+
+    QwtInterval interval() const;
+    int numBins() const;
+    BinningMode binningMode() const;
+
+    void setMaxVisibleBins( int );
+    int maxVisibleBins() const;
+
+    void addValue( double );
+    void addValues( const double *values, int numValues );
+    void addValues( const QVector<double> & );
+
+    void clear();
+
+    double binCount( int bin ) const;
+    QVector<double> binCounts() const;
+
+    double totalCount() const;
+    double underflowCount() const;
+    double overflowCount() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QwtIntervalSample sample( size_t index ) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual void setRectOfInterest( const QRectF & ) QWT_OVERRIDE;
+
+private:
+    Q_DISABLE_COPY( QwtHistogramData )
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -0,0 +1,1036 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_list_legend.h"
+#include "qwt_plot_item.h"
+#include "qwt_painter.h"
+#include "qwt_graphic.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+
+#include <qapplication.h>
+#include <qabstractscrollarea.h>
+#include <qscrollbar.h>
+#include <qpainter.h>
+#include <qpixmap.h>
+#include <qevent.h>
+#include <qlayout.h>
+#include <qstyle.h>
+#include <qstyleoption.h>
+#include <qdrawutil.h>
+#include <qfontmetrics.h>
+#include <qmargins.h>
+#include <qvector.h>
+#include <qlist.h>
+#include <qhash.h>
+
+static const int ButtonFrame = 2;
+static const int Margin = 2;
+
+static QSize qwtButtonShift( const QWidget *w )
+{
+    QStyleOption option;
+    option.init( w );
+
+    const int ph = w->style()->pixelMetric(
+        QStyle::PM_ButtonShiftHorizontal, &option, w );
+    const int pv = w->style()->pixelMetric(
+        QStyle::PM_ButtonShiftVertical, &option, w );
+    return QSize( ph, pv );
+}
+
+static inline const void *qwtItemKey( const QVariant &itemInfo )
+{
+    // QwtPlot::itemToInfo() wraps the pointer of the plot item,
+    // what can be used as key for a hash table. For other
+    // type of infos we have to fall back to a linear lookup.
+
+    if ( itemInfo.userType() == qMetaTypeId<QwtPlotItem *>() )
+        return itemInfo.value<QwtPlotItem *>();
+
+    return NULL;
+}
+
+static inline QwtText qwtEntryTitle( const QwtLegendData &data )
+{
+    QwtText title = data.title();
+    title.setRenderFlags( Qt::AlignLeft | Qt::AlignVCenter
+        | Qt::TextExpandTabs );
+
+    return title;
+}
+
+static inline QSize qwtIconSize( const QwtLegendData &data )
+{
+    const QSizeF sz = data.icon().defaultSize();
+    return QSize( qwtCeil( sz.width() ), qwtCeil( sz.height() ) );
+}
+
+namespace
+{
+    class LegendEntry
+    {
+    public:
+        LegendEntry():
+            isChecked( false ),
+            row( -1 )
+        {
+        }
+
+        QwtLegendData data;
+
+        QwtText title;
+        QSize textSize; // invalid, when not calculated yet
+        QSize iconSize;
+
+        // rendered from data.icon(), when being painted the first time
+        QPixmap icon;
+
+        bool isChecked;
+        int row; // -1, when being filtered out
+    };
+
+    class LegendItem
+    {
+    public:
+        QVariant itemInfo;
+        QVector<LegendEntry> entries;
+    };
+
+    class LegendRow
+    {
+    public:
+        LegendItem *item;
+        int index;
+    };
+}
+
+class QwtListLegend::PrivateData
+{
+public:
+    PrivateData():
+        itemMode( QwtLegendData::ReadOnly ),
+        spacing( Margin ),
+        isLayoutDirty( true ),
+        isLayoutPending( false ),
+        rowHeight( 0 ),
+        contentsWidth( 0 ),
+        buttonFrame( 0 ),
+        pressedRow( -1 ),
+        view( NULL )
+    {
+    }
+
+    ~PrivateData()
+    {
+        qDeleteAll( items );
+    }
+
+    LegendItem *findItem( const QVariant &itemInfo ) const
+    {
+        const void *key = qwtItemKey( itemInfo );
+        if ( key )
+            return itemHash.value( key, NULL );
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            if ( items[i]->itemInfo == itemInfo )
+                return items[i];
+        }
+
+        return NULL;
+    }
+
+    void insertItem( LegendItem *item )
+    {
+        const void *key = qwtItemKey( item->itemInfo );
+        if ( key )
+            itemHash.insert( key, item );
+
+        items += item;
+    }
+
+    void removeItem( LegendItem *item )
+    {
+        const void *key = qwtItemKey( item->itemInfo );
+        if ( key )
+            itemHash.remove( key );
+
+        items.removeOne( item );
+        delete item;
+
+        pressedRow = -1;
+    }
+
+    inline QwtLegendData::Mode entryMode( const LegendEntry &entry ) const
+    {
+        // use the default mode, when there is no specific
+        // hint from the legend data
+
+        if ( entry.data.hasRole( QwtLegendData::ModeRole ) )
+            return entry.data.mode();
+
+        return itemMode;
+    }
+
+    inline bool isRow( int row ) const
+    {
+        return row >= 0 && row < rows.size();
+    }
+
+    void layoutRows( const QFont & );
+    void updateRow( int row );
+
+    void drawRow( QPainter *, const QWidget *,
+        int row, const QRectF &, bool isExport );
+
+    QwtLegendData::Mode itemMode;
+    int spacing;
+    QString filter;
+
+    QList<LegendItem *> items;
+    QHash<const void *, LegendItem *> itemHash;
+
+    // the rows are calculated from the items, when being needed
+    bool isLayoutDirty;
+    bool isLayoutPending;
+
+    QVector<LegendRow> rows;
+    int rowHeight;
+    int contentsWidth;
+    int buttonFrame;
+
+    int pressedRow;
+
+    class ListView;
+    ListView *view;
+};
+
+class QwtListLegend::PrivateData::ListView QWT_FINAL: public QAbstractScrollArea
+{
+public:
+    explicit ListView( QwtListLegend *listLegend ):
+        QAbstractScrollArea( listLegend ),
+        legend( listLegend )
+    {
+        viewport()->setObjectName( "QwtListLegendViewport" );
+        viewport()->setAutoFillBackground( false );
+    }
+
+    virtual bool event( QEvent *event ) QWT_OVERRIDE
+    {
+        if ( event->type() == QEvent::PolishRequest )
+            setFocusPolicy( Qt::NoFocus );
+
+        return QAbstractScrollArea::event( event );
+    }
+
+protected:
+    virtual void paintEvent( QPaintEvent *event ) QWT_OVERRIDE
+    {
+        QPainter painter( viewport() );
+        painter.setClipRegion( event->region() );
+
+        legend->drawRows( &painter, event->rect() );
+    }
+
+    virtual void resizeEvent( QResizeEvent *event ) QWT_OVERRIDE
+    {
+        QAbstractScrollArea::resizeEvent( event );
+        legend->updateScrollBars();
+    }
+
+    virtual void scrollContentsBy( int dx, int dy ) QWT_OVERRIDE
+    {
+        Q_UNUSED( dx )
+        Q_UNUSED( dy )
+
+        viewport()->update();
+    }
+
+    virtual void mousePressEvent( QMouseEvent *event ) QWT_OVERRIDE
+    {
+        if ( event->button() == Qt::LeftButton )
+        {
+            legend->pressRow( legend->rowAt(
+                viewport()->mapTo( legend, event->pos() ) ) );
+            return;
+        }
+
+        QAbstractScrollArea::mousePressEvent( event );
+    }
+
+    virtual void mouseReleaseEvent( QMouseEvent *event ) QWT_OVERRIDE
+    {
+        if ( event->button() == Qt::LeftButton )
+        {
+            legend->releaseRow( legend->rowAt(
+                viewport()->mapTo( legend, event->pos() ) ) );
+            return;
+        }
+
+        QAbstractScrollArea::mouseReleaseEvent( event );
+    }
+
+private:
+    QwtListLegend *legend;
+};
+
+void QwtListLegend::PrivateData::layoutRows( const QFont &font )
+{
+    if ( !isLayoutDirty )
+        return;
+
+    isLayoutDirty = false;
+
+    rows.clear();
+
+    int textHeight = QFontMetrics( font ).height();
+    int iconHeight = 0;
+    int width = 0;
+    bool hasButtons = false;
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        LegendItem *item = items[i];
+
+        for ( int j = 0; j < item->entries.size(); j++ )
+        {
+            LegendEntry &entry = item->entries[j];
+            entry.row = -1;
+
+            if ( !filter.isEmpty() &&
+                !entry.title.text().contains( filter, Qt::CaseInsensitive ) )
+            {
+                continue;
+            }
+
+            if ( !entry.textSize.isValid() )
+            {
+                const QSizeF sz = entry.title.textSize( font );
+                entry.textSize = QSize( qwtCeil( sz.width() ), qwtCeil( sz.height() ) );
+            }
+
+            int w = entry.textSize.width();
+            if ( !entry.iconSize.isEmpty() )
+            {
+                w += entry.iconSize.width() + spacing;
+                iconHeight = qMax( iconHeight, entry.iconSize.height() );
+            }
+
+            width = qMax( width, w );
+            textHeight = qMax( textHeight, entry.textSize.height() );
+
+            if ( entryMode( entry ) != QwtLegendData::ReadOnly )
+                hasButtons = true;
+
+            LegendRow legendRow;
+            legendRow.item = item;
+            legendRow.index = j;
+
+            entry.row = rows.size();
+            rows += legendRow;
+        }
+    }
+
+    buttonFrame = hasButtons ? ButtonFrame : 0;
+
+    rowHeight = qMax( textHeight, iconHeight ) + 2 * ( Margin + buttonFrame );
+    contentsWidth = width + 2 * ( Margin + buttonFrame );
+}
+
+void QwtListLegend::PrivateData::updateRow( int row )
+{
+    if ( isLayoutDirty || !isRow( row ) )
+        return;
+
+    QWidget *viewport = view->viewport();
+
+    const int y = row * rowHeight - view->verticalScrollBar()->value();
+    viewport->update( 0, y, viewport->width(), rowHeight );
+}
+
+void QwtListLegend::PrivateData::drawRow( QPainter *painter,
+    const QWidget *widget, int row, const QRectF &rect, bool isExport )
+{
+    const LegendRow &legendRow = rows[row];
+    LegendEntry &entry = legendRow.item->entries[legendRow.index];
+
+    QRectF r = rect;
+
+    if ( !isExport )
+    {
+        const QwtLegendData::Mode mode = entryMode( entry );
+
+        const bool isDown =
+            ( mode == QwtLegendData::Checkable && entry.isChecked ) ||
+            ( mode == QwtLegendData::Clickable && row == pressedRow );
+
+        if ( isDown )
+        {
+            qDrawWinButton( painter, rect.toRect(), widget->palette(), true );
+
+            const QSize shift = qwtButtonShift( widget );
+            r.translate( shift.width(), shift.height() );
+        }
+    }
+
+    double x = r.x() + buttonFrame + Margin;
+
+    if ( !entry.iconSize.isEmpty() )
+    {
+        const QRectF iconRect( x, r.center().y() - 0.5 * entry.iconSize.height(),
+            entry.iconSize.width(), entry.iconSize.height() );
+
+        if ( isExport )
+        {
+            entry.data.icon().render( painter, iconRect, Qt::KeepAspectRatio );
+        }
+        else
+        {
+            if ( entry.icon.isNull() )
+                entry.icon = entry.data.icon().toPixmap();
+
+            painter->drawPixmap( iconRect.topLeft(), entry.icon );
+        }
+
+        x += entry.iconSize.width() + spacing;
+    }
+
+    const QRectF titleRect( x, r.y(),
+        r.right() - x - Margin - buttonFrame, r.height() );
+
+    entry.title.draw( painter, titleRect );
+}
+
+/*!
+  Constructor
+  \param parent Parent widget
+*/
+QwtListLegend::QwtListLegend( QWidget *parent ):
+    QwtAbstractLegend( parent )
+{
+    setFrameStyle( NoFrame );
+
+    d_data = new QwtListLegend::PrivateData;
+
+    d_data->view = new QwtListLegend::PrivateData::ListView( this );
+    d_data->view->setObjectName( "QwtListLegendView" );
+    d_data->view->setFrameStyle( NoFrame );
+
+    QVBoxLayout *layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( d_data->view );
+}
+
+//! Destructor
+QwtListLegend::~QwtListLegend()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Set the default mode for the entries
+
+  The default mode is used for all entries, that have no
+  QwtLegendData::ModeRole in their legend data.
+  The default setting is QwtLegendData::ReadOnly.
+
+  \param mode Default item mode
+  \sa defaultItemMode(), clicked(), checked()
+*/
+void QwtListLegend::setDefaultItemMode( QwtLegendData::Mode mode )
+{
+    if ( mode != d_data->itemMode )
+    {
+        d_data->itemMode = mode;
+        d_data->pressedRow = -1;
+
+        scheduleLayout();
+    }
+}
+
+/*!
+  \return Default item mode
+  \sa setDefaultItemMode()
+*/
+QwtLegendData::Mode QwtListLegend::defaultItemMode() const
+{
+    return d_data->itemMode;
+}
+
+/*!
+  \brief Change the spacing between icon and title
+
+  \param spacing Spacing
+  \sa spacing()
+*/
+void QwtListLegend::setSpacing( int spacing )
+{
+    spacing = qMax( spacing, 0 );
+    if ( spacing != d_data->spacing )
+    {
+        d_data->spacing = spacing;
+        scheduleLayout();
+    }
+}
+
+/*!
+  \return Spacing between icon and title
+  \sa setSpacing()
+*/
+int QwtListLegend::spacing() const
+{
+    return d_data->spacing;
+}
+
+/*!
+  \brief Filter the entries by their titles
+
+  Only entries, where the title contains the filter
+  ( case insensitive ) are displayed. An empty filter, what
+  is the default setting, displays all entries.
+
+  \param filter Filter string
+  \sa filter(), rowCount()
+*/
+void QwtListLegend::setFilter( const QString &filter )
+{
+    if ( filter != d_data->filter )
+    {
+        d_data->filter = filter;
+        d_data->pressedRow = -1;
+
+        scheduleLayout();
+    }
+}
+
+/*!
+  \return Filter string
+  \sa setFilter()
+*/
+QString QwtListLegend::filter() const
+{
+    return d_data->filter;
+}
+
+/*!
+  \return Number of entries, including the filtered ones
+  \sa rowCount()
+*/
+int QwtListLegend::entryCount() const
+{
+    int count = 0;
+    for ( int i = 0; i < d_data->items.size(); i++ )
+        count += d_data->items[i]->entries.size();
+
+    return count;
+}
+
+/*!
+  \return Number of rows, that are displayed after filtering
+  \sa entryCount(), setFilter()
+*/
+int QwtListLegend::rowCount() const
+{
+    d_data->layoutRows( font() );
+    return d_data->rows.size();
+}
+
+/*!
+  \brief Find the row at a position
+
+  \param pos Position in coordinates of the legend
+  \return Row at pos, or -1, when there is no row at pos
+*/
+int QwtListLegend::rowAt( const QPoint &pos ) const
+{
+    d_data->layoutRows( font() );
+
+    const QWidget *viewport = d_data->view->viewport();
+
+    const QPoint p = viewport->mapFrom( this, pos );
+    if ( !viewport->rect().contains( p ) || d_data->rowHeight <= 0 )
+        return -1;
+
+    const int row = ( p.y() + d_data->view->verticalScrollBar()->value() )
+        / d_data->rowHeight;
+
+    return d_data->isRow( row ) ? row : -1;
+}
+
+/*!
+  \param row Row
+  \return Info of the item of the entry in a row
+  \sa legendIndex(), legendData(), QwtPlot::infoToItem()
+*/
+QVariant QwtListLegend::itemInfo( int row ) const
+{
+    d_data->layoutRows( font() );
+    if ( !d_data->isRow( row ) )
+        return QVariant();
+
+    return d_data->rows[row].item->itemInfo;
+}
+
+/*!
+  \param row Row
+  \return Index of the entry in the list of legend data of its item,
+          or -1 for an invalid row
+  \sa itemInfo(), legendData()
+*/
+int QwtListLegend::legendIndex( int row ) const
+{
+    d_data->layoutRows( font() );
+    if ( !d_data->isRow( row ) )
+        return -1;
+
+    return d_data->rows[row].index;
+}
+
+/*!
+  \param row Row
+  \return Legend data of the entry in a row
+  \sa itemInfo(), legendIndex()
+*/
+QwtLegendData QwtListLegend::legendData( int row ) const
+{
+    d_data->layoutRows( font() );
+    if ( !d_data->isRow( row ) )
+        return QwtLegendData();
+
+    const LegendRow &legendRow = d_data->rows[row];
+    return legendRow.item->entries[legendRow.index].data;
+}
+
+/*!
+  \brief Check/Uncheck an entry
+
+  The state is only displayed for entries in QwtLegendData::Checkable mode.
+  No checked() signal is emitted.
+
+  \param itemInfo Info of the item
+  \param on Checked, when true
+  \param index Index of the entry in the list of legend data of the item
+
+  \sa isChecked()
+*/
+void QwtListLegend::setChecked( const QVariant &itemInfo, bool on, int index )
+{
+    LegendItem *item = d_data->findItem( itemInfo );
+    if ( item == NULL || index < 0 || index >= item->entries.size() )
+        return;
+
+    LegendEntry &entry = item->entries[index];
+    if ( entry.isChecked != on )
+    {
+        entry.isChecked = on;
+        d_data->updateRow( entry.row );
+    }
+}
+
+/*!
+  \param itemInfo Info of the item
+  \param index Index of the entry in the list of legend data of the item
+
+  \return True, when the entry is checked
+  \sa setChecked()
+*/
+bool QwtListLegend::isChecked( const QVariant &itemInfo, int index ) const
+{
+    const LegendItem *item = d_data->findItem( itemInfo );
+    if ( item == NULL || index < 0 || index >= item->entries.size() )
+        return false;
+
+    return item->entries[index].isChecked;
+}
+
+//! \return Horizontal scrollbar
+QScrollBar *QwtListLegend::horizontalScrollBar() const
+{
+    return d_data->view->horizontalScrollBar();
+}
+
+//! \return Vertical scrollbar
+QScrollBar *QwtListLegend::verticalScrollBar() const
+{
+    return d_data->view->verticalScrollBar();
+}
+
+/*!
+  \brief Update the entries for an item
+
+  The legend data is stored only. The rows are rearranged, when the
+  geometry of an entry or the number of entries has changed. Otherwise
+  only rows, that are visible, are repainted.
+
+  \param itemInfo Info for an item
+  \param legendData List of legend entry attributes for the item
+ */
+void QwtListLegend::updateLegend( const QVariant &itemInfo,
+    const QList<QwtLegendData> &legendData )
+{
+    LegendItem *item = d_data->findItem( itemInfo );
+
+    if ( legendData.isEmpty() )
+    {
+        if ( item )
+        {
+            d_data->removeItem( item );
+            scheduleLayout();
+        }
+
+        return;
+    }
+
+    bool needsLayout = false;
+
+    if ( item == NULL )
+    {
+        item = new LegendItem;
+        item->itemInfo = itemInfo;
+
+        d_data->insertItem( item );
+        needsLayout = true;
+    }
+
+    if ( item->entries.size() != legendData.size() )
+    {
+        item->entries.resize( legendData.size() );
+        needsLayout = true;
+    }
+
+    for ( int i = 0; i < legendData.size(); i++ )
+    {
+        LegendEntry &entry = item->entries[i];
+        const QwtLegendData &data = legendData[i];
+
+        const QwtText title = qwtEntryTitle( data );
+        if ( title != entry.title )
+        {
+            entry.title = title;
+            entry.textSize = QSize();
+
+            needsLayout = true;
+        }
+
+        const QSize iconSize = qwtIconSize( data );
+        if ( iconSize != entry.iconSize )
+        {
+            entry.iconSize = iconSize;
+            needsLayout = true;
+        }
+
+        const QwtLegendData::Mode mode = d_data->entryMode( entry );
+
+        entry.data = data;
+        entry.icon = QPixmap();
+
+        if ( d_data->entryMode( entry ) != mode )
+            needsLayout = true;
+    }
+
+    if ( needsLayout )
+    {
+        scheduleLayout();
+    }
+    else
+    {
+        for ( int i = 0; i < item->entries.size(); i++ )
+            d_data->updateRow( item->entries[i].row );
+    }
+}
+
+/*!
+  \return Size hint
+  \note All rows are aligned in one column
+*/
+QSize QwtListLegend::sizeHint() const
+{
+    d_data->layoutRows( font() );
+
+    QSize hint( d_data->contentsWidth,
+        d_data->rows.size() * d_data->rowHeight );
+    hint += QSize( 2 * frameWidth(), 2 * frameWidth() );
+
+    return hint;
+}
+
+/*!
+  \return The preferred height, for a width.
+  \param width Width
+*/
+int QwtListLegend::heightForWidth( int width ) const
+{
+    Q_UNUSED( width )
+
+    d_data->layoutRows( font() );
+    return d_data->rows.size() * d_data->rowHeight + 2 * frameWidth();
+}
+
+/*!
+  Render the legend into a given rectangle.
+
+  Rows, that don't fit into rect are not rendered.
+
+  \param painter Painter
+  \param rect Bounding rectangle
+  \param fillBackground When true, fill rect with the widget background
+
+  \sa renderLegend() is used by QwtPlotRenderer - not by QwtListLegend itself
+*/
+void QwtListLegend::renderLegend( QPainter *painter,
+    const QRectF &rect, bool fillBackground ) const
+{
+    if ( d_data->items.isEmpty() )
+        return;
+
+    if ( fillBackground )
+    {
+        if ( autoFillBackground() ||
+            testAttribute( Qt::WA_StyledBackground ) )
+        {
+            QwtPainter::drawBackgound( painter, rect, this );
+        }
+    }
+
+    d_data->layoutRows( font() );
+
+    const QMargins m = contentsMargins();
+
+    const QRectF contentsRect = rect.adjusted(
+        m.left(), m.top(), -m.right(), -m.bottom() );
+
+    QFont legendFont = font();
+    legendFont.resolve( QFont::AllPropertiesResolved );
+
+    painter->save();
+
+    painter->setClipRect( contentsRect, Qt::IntersectClip );
+    painter->setFont( legendFont );
+    painter->setPen( palette().color( QPalette::Text ) );
+
+    const int rowHeight = d_data->rowHeight;
+
+    for ( int row = 0; row < d_data->rows.size(); row++ )
+    {
+        const QRectF rowRect( contentsRect.x(),
+            contentsRect.y() + row * rowHeight,
+            contentsRect.width(), rowHeight );
+
+        if ( rowRect.top() >= contentsRect.bottom() )
+            break;
+
+        d_data->drawRow( painter, this, row, rowRect, true );
+    }
+
+    painter->restore();
+}
+
+/*!
+  \return True, when no item is inserted
+  \note Entries, that are filtered out, are counted
+*/
+bool QwtListLegend::isEmpty() const
+{
+    return d_data->items.isEmpty();
+}
+
+/*!
+  Return the extent, that is needed for the scrollbars
+
+  \param orientation Orientation
+  \return The width of the vertical scrollbar for Qt::Horizontal and v.v.
+ */
+int QwtListLegend::scrollExtent( Qt::Orientation orientation ) const
+{
+    int extent = 0;
+
+    if ( orientation == Qt::Horizontal )
+        extent = verticalScrollBar()->sizeHint().width();
+    else
+        extent = horizontalScrollBar()->sizeHint().height();
+
+    return extent;
+}
+
+/*!
+  Rearrange the rows after the entries have been changed
+
+  \param event Event
+  \return See QwtAbstractLegend::event()
+*/
+bool QwtListLegend::event( QEvent *event )
+{
+    if ( event->type() == QEvent::LayoutRequest && d_data->isLayoutPending )
+    {
+        d_data->isLayoutPending = false;
+
+        updateScrollBars();
+        d_data->view->viewport()->update();
+
+        updateGeometry();
+
+        /*
+           updateGeometry() doesn't post LayoutRequest events, when
+           the legend is hidden. But we want the parent widget notified,
+           so it can show/hide the legend depending on its items.
+         */
+        if ( parentWidget() )
+        {
+            QApplication::postEvent( parentWidget(),
+                new QEvent( QEvent::LayoutRequest ) );
+        }
+    }
+
+    return QwtAbstractLegend::event( event );
+}
+
+/*!
+  Invalidate the cached sizes of the titles, when the font
+  or the style has changed
+
+  \param event Change event
+*/
+void QwtListLegend::changeEvent( QEvent *event )
+{
+    if ( event->type() == QEvent::FontChange ||
+        event->type() == QEvent::StyleChange )
+    {
+        for ( int i = 0; i < d_data->items.size(); i++ )
+        {
+            QVector<LegendEntry> &entries = d_data->items[i]->entries;
+            for ( int j = 0; j < entries.size(); j++ )
+                entries[j].textSize = QSize();
+        }
+
+        scheduleLayout();
+    }
+
+    QwtAbstractLegend::changeEvent( event );
+}
+
+void QwtListLegend::drawRows( QPainter *painter, const QRect &rect ) const
+{
+    d_data->layoutRows( font() );
+
+    const int rowHeight = d_data->rowHeight;
+    if ( d_data->rows.isEmpty() || rowHeight <= 0 )
+        return;
+
+    const int dx = horizontalScrollBar()->value();
+    const int dy = verticalScrollBar()->value();
+
+    // only the rows, that intersect with rect
+
+    const int firstRow = qMax( ( rect.top() + dy ) / rowHeight, 0 );
+    const int lastRow = qMin( ( rect.bottom() + dy ) / rowHeight,
+        d_data->rows.size() - 1 );
+
+    const int width = qMax( d_data->contentsWidth,
+        d_data->view->viewport()->width() );
+
+    painter->setFont( font() );
+    painter->setPen( palette().color( QPalette::Text ) );
+
+    for ( int row = firstRow; row <= lastRow; row++ )
+    {
+        const QRect rowRect( -dx, row * rowHeight - dy, width, rowHeight );
+        d_data->drawRow( painter, this, row, rowRect, false );
+    }
+}
+
+void QwtListLegend::pressRow( int row )
+{
+    if ( !d_data->isRow( row ) )
+        return;
+
+    const LegendRow &legendRow = d_data->rows[row];
+    LegendEntry &entry = legendRow.item->entries[legendRow.index];
+
+    switch ( d_data->entryMode( entry ) )
+    {
+        case QwtLegendData::Clickable:
+        {
+            d_data->pressedRow = row;
+            d_data->updateRow( row );
+
+            break;
+        }
+        case QwtLegendData::Checkable:
+        {
+            entry.isChecked = !entry.isChecked;
+            d_data->updateRow( row );
+
+            // slots might modify the legend: better copy the values
+            const QVariant itemInfo = legendRow.item->itemInfo;
+            const int index = legendRow.index;
+
+            Q_EMIT checked( itemInfo, entry.isChecked, index );
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void QwtListLegend::releaseRow( int row )
+{
+    const int pressedRow = d_data->pressedRow;
+    if ( !d_data->isRow( pressedRow ) )
+        return;
+
+    d_data->pressedRow = -1;
+    d_data->updateRow( pressedRow );
+
+    if ( row == pressedRow )
+    {
+        const LegendRow &legendRow = d_data->rows[row];
+
+        const QVariant itemInfo = legendRow.item->itemInfo;
+        const int index = legendRow.index;
+
+        Q_EMIT clicked( itemInfo, index );
+    }
+}
+
+void QwtListLegend::updateScrollBars()
+{
+    d_data->layoutRows( font() );
+
+    const QSize viewportSize = d_data->view->viewport()->size();
+    const int h = d_data->rows.size() * d_data->rowHeight;
+
+    QScrollBar *vScrollBar = verticalScrollBar();
+    vScrollBar->setRange( 0, qMax( h - viewportSize.height(), 0 ) );
+    vScrollBar->setPageStep( viewportSize.height() );
+    vScrollBar->setSingleStep( qMax( d_data->rowHeight, 1 ) );
+
+    QScrollBar *hScrollBar = horizontalScrollBar();
+    hScrollBar->setRange( 0,
+        qMax( d_data->contentsWidth - viewportSize.width(), 0 ) );
+    hScrollBar->setPageStep( viewportSize.width() );
+}
+
+void QwtListLegend::scheduleLayout()
+{
+    d_data->isLayoutDirty = true;
+
+    if ( !d_data->isLayoutPending )
+    {
+        // many updates in a row are collected into one relayout
+
+        d_data->isLayoutPending = true;
+        QApplication::postEvent( this, new QEvent( QEvent::LayoutRequest ) );
+    }
+}
+
+#if QWT_MOC_INCLUDE
+#include "moc_qwt_list_legend.cpp"
+#endif
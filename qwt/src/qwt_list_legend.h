@@ -0,0 +1,141 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_LIST_LEGEND_H
+#define QWT_LIST_LEGEND_H
+
+#include "qwt_global.h"
+#include "qwt_abstract_legend.h"
+#include "qwt_legend_data.h"
+
+#include <qvariant.h>
+
+class QScrollBar;
+class QString;
+class QPoint;
+
+/*!
+  \brief A legend for plots with many items
+
+  QwtLegend creates a QwtLegendLabel widget for each entry, what becomes
+  expensive, when a plot has thousands of items. QwtListLegend stores
+  the entries in a plain list and paints them one below the other
+  into a scrollable view:
+
+  - Only the rows inside the visible area are painted
+  - The icons are rendered from the QwtGraphic, when a row becomes
+    visible for the first time and are cached as pixmap
+  - updateLegend() stores the legend data only. The rows are
+    rearranged and repainted, when it is necessary for the
+    next paint event
+  - Entries can be filtered by their titles
+
+  All rows have the same height. Titles are not wrapped and are expected
+  to be single lines of text.
+
+  \code
+    QwtListLegend *legend = new QwtListLegend();
+    legend->setDefaultItemMode( QwtLegendData::Checkable );
+
+    plot->insertLegend( legend, QwtPlot::RightLegend );
+  \endcode
+
+  \sa QwtLegend, QwtPlot::insertLegend()
+*/
+class QWT_EXPORT QwtListLegend : public QwtAbstractLegend
+{
+    Q_OBJECT
+
+public:
+    explicit QwtListLegend( QWidget *parent = NULL );
+    virtual ~QwtListLegend();
+
+    void setDefaultItemMode( QwtLegendData::Mode );
+    QwtLegendData::Mode defaultItemMode() const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    void setFilter( const QString & );
+    QString filter() const;
+
+    int entryCount() const;
+    int rowCount() const;
+
+    int rowAt( const QPoint & ) const;
+
+    QVariant itemInfo( int row ) const;
+    int legendIndex( int row ) const;
+    QwtLegendData legendData( int row ) const;
+
+    void setChecked( const QVariant &itemInfo, bool on, int index = 0 );
+    bool isChecked( const QVariant &itemInfo, int index = 0 ) const;
+
+    QScrollBar *horizontalScrollBar() const;
+    QScrollBar *verticalScrollBar() const;
+
+    virtual QSize sizeHint() const QWT_OVERRIDE;
+    virtual int heightForWidth( int width ) const QWT_OVERRIDE;
+
+    virtual void renderLegend( QPainter *,
+        const QRectF &, bool fillBackground ) const QWT_OVERRIDE;
+
+    virtual bool isEmpty() const QWT_OVERRIDE;
+    virtual int scrollExtent( Qt::Orientation ) const QWT_OVERRIDE;
+
+    virtual bool event( QEvent * ) QWT_OVERRIDE;
+
+Q_SIGNALS:
+    /*!
+      A signal which is emitted when the user has clicked on
+      an entry, which is in QwtLegendData::Clickable mode.
+
+      \param itemInfo Info for the item of the selected entry
+      \param index Index of the entry in the list of legend data
+                   that is associated with the plot item
+
+      \note clicks are disabled as default
+      \sa setDefaultItemMode(), defaultItemMode(), QwtPlot::itemToInfo()
+     */
+    void clicked( const QVariant &itemInfo, int index );
+
+    /*!
+      A signal which is emitted when the user has clicked on
+      an entry, which is in QwtLegendData::Checkable mode
+
+      \param itemInfo Info for the item of the selected entry
+      \param on True when the entry is checked
+      \param index Index of the entry in the list of legend data
+                   that is associated with the plot item
+
+      \note clicks are disabled as default
+      \sa setDefaultItemMode(), defaultItemMode(), QwtPlot::itemToInfo()
+     */
+    void checked( const QVariant &itemInfo, bool on, int index );
+
+public Q_SLOTS:
+    virtual void updateLegend( const QVariant &,
+        const QList<QwtLegendData> & ) QWT_OVERRIDE;
+
+protected:
+    virtual void changeEvent( QEvent * ) QWT_OVERRIDE;
+
+private:
+    void drawRows( QPainter *, const QRect & ) const;
+    void pressRow( int row );
+    void releaseRow( int row );
+
+    void updateScrollBars();
+    void scheduleLayout();
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -13,32 +13,419 @@
 #include <qvector.h>
 #include <qnumeric.h>
 #include <qrect.h>
+#include <qsize.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+static inline int qwtValueSize( QwtMatrixRasterData::ValueType type )
+{
+    switch( type )
+    {
+        case QwtMatrixRasterData::UInt8:
+            return sizeof( quint8 );
+        case QwtMatrixRasterData::UInt16:
+            return sizeof( quint16 );
+        case QwtMatrixRasterData::Int32:
+            return sizeof( qint32 );
+        case QwtMatrixRasterData::Float:
+            return sizeof( float );
+        case QwtMatrixRasterData::Double:
+        default:
+            return sizeof( double );
+    }
+}
+
+template< typename T >
+static inline const T *qwtMatrixLine(
+    const uchar *matrix, int bytesPerLine, int row )
+{
+    return reinterpret_cast<const T *>(
+        matrix + static_cast<size_t>( row ) * bytesPerLine );
+}
+
+namespace
+{
+    class MatrixLevel
+    {
+    public:
+        MatrixLevel():
+            data( NULL ),
+            valueType( QwtMatrixRasterData::Double ),
+            bytesPerLine( 0 ),
+            numColumns( 0 ),
+            numRows( 0 ),
+            dx( 0.0 ),
+            dy( 0.0 )
+        {
+        }
+
+        inline double value( int row, int col ) const
+        {
+            switch( valueType )
+            {
+                case QwtMatrixRasterData::UInt8:
+                    return qwtMatrixLine<quint8>( data, bytesPerLine, row )[col];
+                case QwtMatrixRasterData::UInt16:
+                    return qwtMatrixLine<quint16>( data, bytesPerLine, row )[col];
+                case QwtMatrixRasterData::Int32:
+                    return qwtMatrixLine<qint32>( data, bytesPerLine, row )[col];
+                case QwtMatrixRasterData::Float:
+                    return qwtMatrixLine<float>( data, bytesPerLine, row )[col];
+                case QwtMatrixRasterData::Double:
+                default:
+                    return qwtMatrixLine<double>( data, bytesPerLine, row )[col];
+            }
+        }
+
+        const uchar *data;
+        QwtMatrixRasterData::ValueType valueType;
+        int bytesPerLine;
+
+        int numColumns;
+        int numRows;
+
+        double dx;
+        double dy;
+    };
+
+    class ReduceCommand
+    {
+    public:
+        MatrixLevel source;
+        QwtMatrixRasterData::ReductionMode mode;
+
+        double *values;
+        int numColumns;
+
+        // rows [ from, to ] of the reduced level
+        int from;
+        int to;
+    };
+}
+
+/*
+  The same algorithms as in QwtMatrixRasterData::value(), but the
+  positions in the matrix are calculated once for all rows/columns
+  and the inner loop works on the native type of the values.
+ */
+template< typename T >
+static void qwtSampleValues( const MatrixLevel &level,
+    QwtMatrixRasterData::ResampleMode resampleMode,
+    const QwtInterval &xInterval, const QwtInterval &yInterval,
+    const double *xValues, int numX,
+    const double *yValues, int numY, double *buffer )
+{
+    const double dx = level.dx;
+    const double dy = level.dy;
+
+    QVector<int> cols1( numX );
+    QVector<int> cols2( numX );
+    QVector<double> ratios( numX );
+
+    for ( int i = 0; i < numX; i++ )
+    {
+        const double x = xValues[i];
+
+        if ( !xInterval.contains( x ) )
+        {
+            cols1[i] = -1;
+            continue;
+        }
+
+        if ( resampleMode == QwtMatrixRasterData::BilinearInterpolation )
+        {
+            int col1 = qRound( ( x - xInterval.minValue() ) / dx ) - 1;
+            int col2 = col1 + 1;
+
+            if ( col1 < 0 )
+                col1 = col2;
+            else if ( col2 >= level.numColumns )
+                col2 = col1;
+
+            const double x2 = xInterval.minValue() + ( col2 + 0.5 ) * dx;
+
+            cols1[i] = col1;
+            cols2[i] = col2;
+            ratios[i] = ( x2 - x ) / dx;
+        }
+        else
+        {
+            const int col = int( ( x - xInterval.minValue() ) / dx );
+            cols1[i] = qMin( col, level.numColumns - 1 );
+        }
+    }
+
+    const int *c1 = cols1.constData();
+    const int *c2 = cols2.constData();
+    const double *rx = ratios.constData();
+
+    for ( int j = 0; j < numY; j++ )
+    {
+        const double y = yValues[j];
+        double *out = buffer + j * numX;
+
+        if ( !yInterval.contains( y ) )
+        {
+            for ( int i = 0; i < numX; i++ )
+                out[i] = qQNaN();
+
+            continue;
+        }
+
+        if ( resampleMode == QwtMatrixRasterData::BilinearInterpolation )
+        {
+            int row1 = qRound( ( y - yInterval.minValue() ) / dy ) - 1;
+            int row2 = row1 + 1;
+
+            if ( row1 < 0 )
+                row1 = row2;
+            else if ( row2 >= level.numRows )
+                row2 = row1;
+
+            const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * dy;
+            const double ry = ( y2 - y ) / dy;
+
+            const T *line1 = qwtMatrixLine<T>( level.data, level.bytesPerLine, row1 );
+            const T *line2 = qwtMatrixLine<T>( level.data, level.bytesPerLine, row2 );
+
+            for ( int i = 0; i < numX; i++ )
+            {
+                if ( c1[i] < 0 )
+                {
+                    out[i] = qQNaN();
+                    continue;
+                }
+
+                const double v11 = line1[ c1[i] ];
+                const double v21 = line1[ c2[i] ];
+                const double v12 = line2[ c1[i] ];
+                const double v22 = line2[ c2[i] ];
+
+                const double vr1 = rx[i] * v11 + ( 1.0 - rx[i] ) * v21;
+                const double vr2 = rx[i] * v12 + ( 1.0 - rx[i] ) * v22;
+
+                out[i] = ry * vr1 + ( 1.0 - ry ) * vr2;
+            }
+        }
+        else
+        {
+            int row = int( ( y - yInterval.minValue() ) / dy );
+            if ( row >= level.numRows )
+                row = level.numRows - 1;
+
+            const T *line = qwtMatrixLine<T>( level.data, level.bytesPerLine, row );
+
+            for ( int i = 0; i < numX; i++ )
+                out[i] = ( c1[i] >= 0 ) ? double( line[ c1[i] ] ) : qQNaN();
+        }
+    }
+}
+
+template< typename T >
+static void qwtReduceRows( const ReduceCommand &command )
+{
+    const MatrixLevel &source = command.source;
+
+    for ( int row = command.from; row <= command.to; row++ )
+    {
+        const int row1 = 2 * row;
+        const int row2 = qMin( row1 + 1, source.numRows - 1 );
+
+        const T *line1 = qwtMatrixLine<T>( source.data, source.bytesPerLine, row1 );
+        const T *line2 = qwtMatrixLine<T>( source.data, source.bytesPerLine, row2 );
+
+        double *out = command.values + row * command.numColumns;
+
+        for ( int col = 0; col < command.numColumns; col++ )
+        {
+            const int col1 = 2 * col;
+            const int col2 = qMin( col1 + 1, source.numColumns - 1 );
+
+            const double v11 = line1[col1];
+            const double v21 = line1[col2];
+            const double v12 = line2[col1];
+            const double v22 = line2[col2];
+
+            switch( command.mode )
+            {
+                case QwtMatrixRasterData::ReduceToMinimum:
+                {
+                    out[col] = qMin( qMin( v11, v21 ), qMin( v12, v22 ) );
+                    break;
+                }
+                case QwtMatrixRasterData::ReduceToMaximum:
+                {
+                    out[col] = qMax( qMax( v11, v21 ), qMax( v12, v22 ) );
+                    break;
+                }
+                default:
+                {
+                    // at the borders values might be duplicated
+                    const double w = ( col2 > col1 ) ? 1.0 : 0.0;
+                    const double h = ( row2 > row1 ) ? 1.0 : 0.0;
+
+                    const double sum = v11 + w * v21 + h * ( v12 + w * v22 );
+                    out[col] = sum / ( ( 1.0 + w ) * ( 1.0 + h ) );
+                }
+            }
+        }
+    }
+}
+
+static void qwtReduce( const ReduceCommand &command )
+{
+    switch( command.source.valueType )
+    {
+        case QwtMatrixRasterData::UInt8:
+            qwtReduceRows<quint8>( command );
+            break;
+        case QwtMatrixRasterData::UInt16:
+            qwtReduceRows<quint16>( command );
+            break;
+        case QwtMatrixRasterData::Int32:
+            qwtReduceRows<qint32>( command );
+            break;
+        case QwtMatrixRasterData::Float:
+            qwtReduceRows<float>( command );
+            break;
+        case QwtMatrixRasterData::Double:
+        default:
+            qwtReduceRows<double>( command );
+    }
+}
 
 class QwtMatrixRasterData::PrivateData
 {
 public:
     PrivateData():
-        resampleMode(QwtMatrixRasterData::NearestNeighbour),
-        numColumns(0)
+        resampleMode( QwtMatrixRasterData::NearestNeighbour ),
+        reductionMode( QwtMatrixRasterData::NoReduction ),
+        isExternal( false ),
+        isPyramidValid( false ),
+        activeLevel( 0 )
     {
     }
 
-    inline double value(int row, int col) const
+    inline const MatrixLevel &sampledLevel() const
     {
-        return values.data()[ row * numColumns + col ];
+        if ( activeLevel > 0 && activeLevel <= levels.size() )
+            return levels[ activeLevel - 1 ];
+
+        return matrix;
     }
 
+    void invalidatePyramid()
+    {
+        pyramid.clear();
+        levels.clear();
+
+        isPyramidValid = false;
+        activeLevel = 0;
+    }
+
+    void updatePyramid();
+
     QwtInterval intervals[3];
     QwtMatrixRasterData::ResampleMode resampleMode;
+    QwtMatrixRasterData::ReductionMode reductionMode;
 
     QVector<double> values;
-    int numColumns;
-    int numRows;
+    bool isExternal;
+
+    MatrixLevel matrix;
 
-    double dx;
-    double dy;
+    // reduced levels, each of them half of the size of the previous one
+    QVector< QVector<double> > pyramid;
+    QVector<MatrixLevel> levels;
+    bool isPyramidValid;
+
+    int activeLevel;
 };
 
+void QwtMatrixRasterData::PrivateData::updatePyramid()
+{
+    if ( isPyramidValid )
+        return;
+
+    pyramid.clear();
+    levels.clear();
+
+    isPyramidValid = true;
+
+    if ( reductionMode == QwtMatrixRasterData::NoReduction )
+        return;
+
+    MatrixLevel source = matrix;
+    while ( source.numColumns > 1 || source.numRows > 1 )
+    {
+        MatrixLevel level;
+        level.valueType = QwtMatrixRasterData::Double;
+        level.numColumns = ( source.numColumns + 1 ) / 2;
+        level.numRows = ( source.numRows + 1 ) / 2;
+        level.bytesPerLine = level.numColumns * sizeof( double );
+        level.dx = 2.0 * source.dx;
+        level.dy = 2.0 * source.dy;
+
+        QVector<double> reduced( level.numColumns * level.numRows );
+
+        ReduceCommand command;
+        command.source = source;
+        command.mode = reductionMode;
+        command.values = reduced.data();
+        command.numColumns = level.numColumns;
+
+#if QWT_USE_THREADS
+        const int minRowsPerThread = 64;
+
+        int numThreads = qMin( QThread::idealThreadCount(),
+            level.numRows / minRowsPerThread );
+        if ( numThreads <= 0 )
+            numThreads = 1;
+
+        const int numRowsPerThread = level.numRows / numThreads;
+
+        QVector< QFuture<void> > futures;
+        futures.reserve( numThreads - 1 );
+
+        for ( int i = 0; i < numThreads; i++ )
+        {
+            command.from = i * numRowsPerThread;
+
+            if ( i == numThreads - 1 )
+            {
+                command.to = level.numRows - 1;
+                qwtReduce( command );
+            }
+            else
+            {
+                command.to = command.from + numRowsPerThread - 1;
+                futures += QtConcurrent::run( &qwtReduce, command );
+            }
+        }
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+#else
+        command.from = 0;
+        command.to = level.numRows - 1;
+
+        qwtReduce( command );
+#endif
+
+        pyramid += reduced;
+
+        level.data = reinterpret_cast<const uchar *>( reduced.constData() );
+        levels += level;
+
+        source = level;
+    }
+}
+
 //! Constructor
 QwtMatrixRasterData::QwtMatrixRasterData()
 {
@@ -72,6 +459,46 @@ QwtMatrixRasterData::ResampleMode QwtMatrixRasterData::resampleMode() const
     return d_data->resampleMode;
 }
 
+/*!
+   \brief Set the algorithm for reducing the matrix
+
+   When the matrix is displayed in a resolution, that is lower than the
+   resolution of the matrix, point sampling leads to aliasing. Setting a
+   reduction mode enables a pyramid of matrices, where each level has
+   half of the size of the previous one. Its values are the minimum, maximum
+   or mean of the 4 corresponding values of the previous level.
+
+   The level, that is used for sampling, is selected in initRaster()
+   according to the resolution of the raster. As the levels are much smaller
+   than the value matrix, the performance of rendering zoomed out views
+   is improved significantly.
+
+   The default setting is NoReduction.
+
+   \param mode Reduction mode
+   \sa reductionMode(), initRaster()
+
+   \note When the values of an external buffer have been changed,
+         setValueMatrix() has to be called again to rebuild the pyramid.
+*/
+void QwtMatrixRasterData::setReductionMode( ReductionMode mode )
+{
+    if ( mode != d_data->reductionMode )
+    {
+        d_data->reductionMode = mode;
+        d_data->invalidatePyramid();
+    }
+}
+
+/*!
+   \return Algorithm for reducing the matrix
+   \sa setReductionMode()
+*/
+QwtMatrixRasterData::ReductionMode QwtMatrixRasterData::reductionMode() const
+{
+    return d_data->reductionMode;
+}
+
 /*!
    \brief Assign the bounding interval for an axis
 
@@ -127,7 +554,55 @@ void QwtMatrixRasterData::setValueMatrix(
     const QVector<double> &values, int numColumns )
 {
     d_data->values = values;
-    d_data->numColumns = qMax( numColumns, 0 );
+    d_data->matrix.numColumns = qMax( numColumns, 0 );
+
+    d_data->isExternal = false;
+    d_data->matrix.valueType = Double;
+    d_data->matrix.data = reinterpret_cast<const uchar *>( d_data->values.constData() );
+    d_data->matrix.bytesPerLine = d_data->matrix.numColumns * sizeof( double );
+
+    update();
+}
+
+/*!
+   \brief Assign an external buffer as value matrix
+
+   The values are not copied and the buffer has to stay valid as long as
+   it is assigned to the raster data. Resampling is done on the native type
+   of the values, so that f.e. 16 bit images from a camera can be displayed
+   without converting them into doubles.
+
+   \param values Pointer to the first value of the first row
+   \param type Type of the values
+   \param numColumns Number of columns
+   \param numRows Number of rows
+   \param bytesPerLine Distance between the first values of 2 rows in bytes.
+                       0 means, that the rows are stored without padding.
+
+   \note setValue() is not supported for external buffers
+   \sa rawValueMatrix(), valueType(), bytesPerLine(), setInterval()
+*/
+void QwtMatrixRasterData::setValueMatrix( const void *values, ValueType type,
+    int numColumns, int numRows, int bytesPerLine )
+{
+    d_data->values.clear();
+
+    numColumns = qMax( numColumns, 0 );
+    numRows = qMax( numRows, 0 );
+
+    const int minBytesPerLine = numColumns * qwtValueSize( type );
+
+    d_data->isExternal = true;
+    d_data->matrix.valueType = type;
+    d_data->matrix.data = static_cast<const uchar *>( values );
+    d_data->matrix.bytesPerLine = qMax( bytesPerLine, minBytesPerLine );
+
+    if ( values == NULL )
+        numColumns = numRows = 0;
+
+    d_data->matrix.numColumns = numColumns;
+    d_data->matrix.numRows = numRows;
+
     update();
 }
 
@@ -137,7 +612,47 @@ void QwtMatrixRasterData::setValueMatrix(
 */
 const QVector<double> QwtMatrixRasterData::valueMatrix() const
 {
-    return d_data->values;
+    if ( !d_data->isExternal )
+        return d_data->values;
+
+    QVector<double> values( d_data->matrix.numRows * d_data->matrix.numColumns );
+
+    double *v = values.data();
+    for ( int row = 0; row < d_data->matrix.numRows; row++ )
+    {
+        for ( int col = 0; col < d_data->matrix.numColumns; col++ )
+            *v++ = d_data->matrix.value( row, col );
+    }
+
+    return values;
+}
+
+/*!
+   \return Type of the values in the matrix
+   \sa setValueMatrix(), rawValueMatrix()
+*/
+QwtMatrixRasterData::ValueType QwtMatrixRasterData::valueType() const
+{
+    return d_data->matrix.valueType;
+}
+
+/*!
+   \return Pointer to the first value of the matrix,
+           that is of valueType()
+   \sa setValueMatrix(), valueType(), bytesPerLine()
+*/
+const void *QwtMatrixRasterData::rawValueMatrix() const
+{
+    return d_data->matrix.data;
+}
+
+/*!
+   \return Distance between the first values of 2 rows in bytes
+   \sa setValueMatrix(), rawValueMatrix()
+*/
+int QwtMatrixRasterData::bytesPerLine() const
+{
+    return d_data->matrix.bytesPerLine;
 }
 
 /*!
@@ -147,15 +662,24 @@ const QVector<double> QwtMatrixRasterData::valueMatrix() const
   \param col Column index
   \param value New value
 
+  \note Values of an external buffer can't be changed
   \sa value(), setValueMatrix()
 */
 void QwtMatrixRasterData::setValue( int row, int col, double value )
 {
-    if ( row >= 0 && row < d_data->numRows &&
-        col >= 0 && col < d_data->numColumns )
+    if ( d_data->isExternal )
+        return;
+
+    if ( row >= 0 && row < d_data->matrix.numRows &&
+        col >= 0 && col < d_data->matrix.numColumns )
     {
-        const int index = row * d_data->numColumns + col;
+        const int index = row * d_data->matrix.numColumns + col;
         d_data->values.data()[ index ] = value;
+
+        // data() might have detached the vector
+        d_data->matrix.data = reinterpret_cast<const uchar *>( d_data->values.constData() );
+
+        d_data->invalidatePyramid();
     }
 }
 
@@ -165,7 +689,7 @@ void QwtMatrixRasterData::setValue( int row, int col, double value )
 */
 int QwtMatrixRasterData::numColumns() const
 {
-    return d_data->numColumns;
+    return d_data->matrix.numColumns;
 }
 
 /*!
@@ -174,7 +698,7 @@ int QwtMatrixRasterData::numColumns() const
 */
 int QwtMatrixRasterData::numRows() const
 {
-    return d_data->numRows;
+    return d_data->matrix.numRows;
 }
 
 /*!
@@ -209,7 +733,7 @@ QRectF QwtMatrixRasterData::pixelHint( const QRectF &area ) const
         if ( intervalX.isValid() && intervalY.isValid() )
         {
             rect = QRectF( intervalX.minValue(), intervalY.minValue(),
-                d_data->dx, d_data->dy );
+                d_data->matrix.dx, d_data->matrix.dy );
         }
     }
 
@@ -232,39 +756,41 @@ double QwtMatrixRasterData::value( double x, double y ) const
     if ( !( xInterval.contains(x) && yInterval.contains(y) ) )
         return qQNaN();
 
+    const MatrixLevel &level = d_data->sampledLevel();
+
     double value;
 
     switch( d_data->resampleMode )
     {
         case BilinearInterpolation:
         {
-            int col1 = qRound( (x - xInterval.minValue() ) / d_data->dx ) - 1;
-            int row1 = qRound( (y - yInterval.minValue() ) / d_data->dy ) - 1;
+            int col1 = qRound( (x - xInterval.minValue() ) / level.dx ) - 1;
+            int row1 = qRound( (y - yInterval.minValue() ) / level.dy ) - 1;
             int col2 = col1 + 1;
             int row2 = row1 + 1;
 
             if ( col1 < 0 )
                 col1 = col2;
-            else if ( col2 >= d_data->numColumns )
+            else if ( col2 >= level.numColumns )
                 col2 = col1;
 
             if ( row1 < 0 )
                 row1 = row2;
-            else if ( row2 >= d_data->numRows )
+            else if ( row2 >= level.numRows )
                 row2 = row1;
 
-            const double v11 = d_data->value( row1, col1 );
-            const double v21 = d_data->value( row1, col2 );
-            const double v12 = d_data->value( row2, col1 );
-            const double v22 = d_data->value( row2, col2 );
+            const double v11 = level.value( row1, col1 );
+            const double v21 = level.value( row1, col2 );
+            const double v12 = level.value( row2, col1 );
+            const double v22 = level.value( row2, col2 );
 
             const double x2 = xInterval.minValue() +
-                ( col2 + 0.5 ) * d_data->dx;
+                ( col2 + 0.5 ) * level.dx;
             const double y2 = yInterval.minValue() +
-                ( row2 + 0.5 ) * d_data->dy;
+                ( row2 + 0.5 ) * level.dy;
 
-            const double rx = ( x2 - x ) / d_data->dx;
-            const double ry = ( y2 - y ) / d_data->dy;
+            const double rx = ( x2 - x ) / level.dx;
+            const double ry = ( y2 - y ) / level.dy;
 
             const double vr1 = rx * v11 + ( 1.0 - rx ) * v21;
             const double vr2 = rx * v12 + ( 1.0 - rx ) * v22;
@@ -276,42 +802,167 @@ double QwtMatrixRasterData::value( double x, double y ) const
         case NearestNeighbour:
         default:
         {
-            int row = int( (y - yInterval.minValue() ) / d_data->dy );
-            int col = int( (x - xInterval.minValue() ) / d_data->dx );
+            int row = int( (y - yInterval.minValue() ) / level.dy );
+            int col = int( (x - xInterval.minValue() ) / level.dx );
 
             // In case of intervals, where the maximum is included
             // we get out of bound for row/col, when the value for the
             // maximum is requested. Instead we return the value
             // from the last row/col
 
-            if ( row >= d_data->numRows )
-                row = d_data->numRows - 1;
+            if ( row >= level.numRows )
+                row = level.numRows - 1;
 
-            if ( col >= d_data->numColumns )
-                col = d_data->numColumns - 1;
+            if ( col >= level.numColumns )
+                col = level.numColumns - 1;
 
-            value = d_data->value( row, col );
+            value = level.value( row, col );
         }
     }
 
     return value;
 }
 
+/*!
+   \brief Sample the values of a grid
+
+   Reimplemented to calculate the positions in the matrix only once
+   for all rows and columns and to resample on the native type
+   of the values.
+
+   \param xValues X coordinates of the grid columns, in plot coordinates
+   \param numX Number of columns
+   \param yValues Y coordinates of the grid rows, in plot coordinates
+   \param numY Number of rows
+   \param buffer Buffer of at least numX * numY values
+
+   \sa value(), ResampleMode
+*/
+void QwtMatrixRasterData::values( const double *xValues, int numX,
+    const double *yValues, int numY, double *buffer ) const
+{
+    const MatrixLevel &level = d_data->sampledLevel();
+
+    if ( level.numColumns <= 0 || level.numRows <= 0 )
+    {
+        for ( int i = 0; i < numX * numY; i++ )
+            buffer[i] = qQNaN();
+
+        return;
+    }
+
+    const QwtInterval xInterval = interval( Qt::XAxis );
+    const QwtInterval yInterval = interval( Qt::YAxis );
+    const ResampleMode mode = d_data->resampleMode;
+
+    switch( level.valueType )
+    {
+        case UInt8:
+            qwtSampleValues<quint8>( level, mode, xInterval, yInterval,
+                xValues, numX, yValues, numY, buffer );
+            break;
+        case UInt16:
+            qwtSampleValues<quint16>( level, mode, xInterval, yInterval,
+                xValues, numX, yValues, numY, buffer );
+            break;
+        case Int32:
+            qwtSampleValues<qint32>( level, mode, xInterval, yInterval,
+                xValues, numX, yValues, numY, buffer );
+            break;
+        case Float:
+            qwtSampleValues<float>( level, mode, xInterval, yInterval,
+                xValues, numX, yValues, numY, buffer );
+            break;
+        case Double:
+        default:
+            qwtSampleValues<double>( level, mode, xInterval, yInterval,
+                xValues, numX, yValues, numY, buffer );
+    }
+}
+
+/*!
+   \brief Select the level of the pyramid for a raster
+
+   When a reduction mode is set, the level of the pyramid is selected,
+   where the size of the values is not larger than the size of
+   a pixel of the raster. Then value() and values() return the reduced
+   values until discardRaster() is called.
+
+   The pyramid is built, when it is needed for the first time.
+
+   \param area Area of the raster
+   \param raster Number of horizontal and vertical pixels
+
+   \sa setReductionMode(), discardRaster()
+*/
+void QwtMatrixRasterData::initRaster( const QRectF &area, const QSize &raster )
+{
+    d_data->activeLevel = 0;
+
+    if ( d_data->reductionMode == NoReduction )
+        return;
+
+    if ( area.isEmpty() || !raster.isValid() )
+        return;
+
+    const double pixelWidth = area.width() / raster.width();
+    const double pixelHeight = area.height() / raster.height();
+
+    double dx = d_data->matrix.dx;
+    double dy = d_data->matrix.dy;
+
+    if ( dx <= 0.0 || dy <= 0.0 )
+        return;
+
+    int level = 0;
+    while ( 2.0 * dx <= pixelWidth && 2.0 * dy <= pixelHeight )
+    {
+        dx *= 2.0;
+        dy *= 2.0;
+
+        level++;
+    }
+
+    if ( level > 0 )
+    {
+        d_data->updatePyramid();
+        d_data->activeLevel = qMin( level, d_data->levels.size() );
+    }
+}
+
+/*!
+   \brief Discard a raster
+
+   Reset to sampling from the value matrix
+
+   \sa initRaster()
+*/
+void QwtMatrixRasterData::discardRaster()
+{
+    d_data->activeLevel = 0;
+}
+
 void QwtMatrixRasterData::update()
 {
-    d_data->numRows = 0;
-    d_data->dx = 0.0;
-    d_data->dy = 0.0;
+    d_data->invalidatePyramid();
 
-    if ( d_data->numColumns > 0 )
+    d_data->matrix.dx = 0.0;
+    d_data->matrix.dy = 0.0;
+
+    if ( !d_data->isExternal )
     {
-        d_data->numRows = d_data->values.size() / d_data->numColumns;
+        d_data->matrix.numRows = 0;
+        if ( d_data->matrix.numColumns > 0 )
+            d_data->matrix.numRows = d_data->values.size() / d_data->matrix.numColumns;
+    }
 
+    if ( d_data->matrix.numColumns > 0 && d_data->matrix.numRows > 0 )
+    {
         const QwtInterval xInterval = interval( Qt::XAxis );
         const QwtInterval yInterval = interval( Qt::YAxis );
         if ( xInterval.isValid() )
-            d_data->dx = xInterval.width() / d_data->numColumns;
+            d_data->matrix.dx = xInterval.width() / d_data->matrix.numColumns;
         if ( yInterval.isValid() )
-            d_data->dy = yInterval.width() / d_data->numRows;
+            d_data->matrix.dy = yInterval.width() / d_data->matrix.numRows;
     }
 }
@@ -22,6 +22,10 @@ template <typename T> class QVector;
   equidistant values, that can be used by a QwtPlotRasterItem.
   It implements a couple of resampling algorithms, to provide
   values for positions, that or not on the value matrix.
+
+  The values can be stored as a vector of doubles, or the raster data
+  can refer to an external buffer of integer or floating point values
+  without copying them - f.e. the frames of a camera.
 */
 class QWT_EXPORT QwtMatrixRasterData: public QwtRasterData
 {
@@ -45,18 +49,69 @@ public:
         BilinearInterpolation
     };
 
+    /*!
+      \brief Algorithm for reducing the matrix for lower resolutions
+      \sa setReductionMode()
+     */
+    enum ReductionMode
+    {
+        //! The values are always sampled from the value matrix
+        NoReduction,
+
+        //! The minimum of the reduced values
+        ReduceToMinimum,
+
+        //! The maximum of the reduced values, preserving peaks
+        ReduceToMaximum,
+
+        //! The mean of the reduced values
+        ReduceToMean
+    };
+
+    /*!
+      \brief Type of the values in an external buffer
+      \sa setValueMatrix()
+     */
+    enum ValueType
+    {
+        //! unsigned 8 bit integers
+        UInt8,
+
+        //! unsigned 16 bit integers
+        UInt16,
+
+        //! signed 32 bit integers
+        Int32,
+
+        //! single precision floating point values
+        Float,
+
+        //! double precision floating point values
+        Double
+    };
+
     QwtMatrixRasterData();
     virtual ~QwtMatrixRasterData();
 
     void setResampleMode(ResampleMode mode);
     ResampleMode resampleMode() const;
 
+    void setReductionMode( ReductionMode );
+    ReductionMode reductionMode() const;
+
     void setInterval( Qt::Axis, const QwtInterval & );
     virtual QwtInterval interval( Qt::Axis axis) const QWT_OVERRIDE QWT_FINAL;
 
     void setValueMatrix( const QVector<double> &values, int numColumns );
+    void setValueMatrix( const void *values, ValueType,
+        int numColumns, int numRows, int bytesPerLine = 0 );
+
     const QVector<double> valueMatrix() const;
 
+    ValueType valueType() const;
+    const void *rawValueMatrix() const;
+    int bytesPerLine() const;
+
     void setValue( int row, int col, double value );
 
     int numColumns() const;
@@ -64,8 +119,14 @@ public:
 
     virtual QRectF pixelHint( const QRectF & ) const QWT_OVERRIDE;
 
+    virtual void initRaster( const QRectF &, const QSize &raster ) QWT_OVERRIDE;
+    virtual void discardRaster() QWT_OVERRIDE;
+
     virtual double value( double x, double y ) const QWT_OVERRIDE;
 
+    virtual void values( const double *xValues, int numX,
+        const double *yValues, int numY, double *buffer ) const QWT_OVERRIDE;
+
 private:
     void update();
 
@@ -14,11 +14,13 @@ class QwtNullPaintDevice::PrivateData
 {
 public:
     PrivateData():
-        mode( QwtNullPaintDevice::NormalMode )
+        mode( QwtNullPaintDevice::NormalMode ),
+        isAligning( false )
     {
     }
 
     QwtNullPaintDevice::Mode mode;
+    bool isAligning;
 };
 
 class QwtNullPaintDevice::PaintEngine QWT_FINAL: public QPaintEngine
@@ -396,6 +398,35 @@ QwtNullPaintDevice::Mode QwtNullPaintDevice::mode() const
     return d_data->mode;
 }
 
+/*!
+  En/Disable the rounding alignment of QwtPainter
+
+  QwtPainter doesn't align coordinates for unknown paint engines
+  like the one of the null paint device. When the recorded
+  paint operations are replayed on a raster device, the result
+  differs from painting to the raster device directly.
+  Enabling the alignment makes QwtPainter treat the null
+  paint device like a raster device.
+
+  The default setting is false.
+
+  \param on On/Off
+  \sa isAligning(), QwtPainter::isAligning()
+ */
+void QwtNullPaintDevice::setAligning( bool on )
+{
+    d_data->isAligning = on;
+}
+
+/*!
+  \return True, when QwtPainter aligns coordinates for the device
+  \sa setAligning()
+*/
+bool QwtNullPaintDevice::isAligning() const
+{
+    return d_data->isAligning;
+}
+
 //! See QPaintDevice::paintEngine()
 QPaintEngine *QwtNullPaintDevice::paintEngine() const
 {
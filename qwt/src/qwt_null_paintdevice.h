@@ -75,6 +75,9 @@ public:
     void setMode( Mode );
     Mode mode() const;
 
+    void setAligning( bool );
+    bool isAligning() const;
+
     virtual QPaintEngine *paintEngine() const QWT_OVERRIDE;
 
     virtual int metric( PaintDeviceMetric ) const QWT_OVERRIDE;
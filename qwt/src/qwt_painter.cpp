@@ -12,6 +12,7 @@
 #include "qwt_clipper.h"
 #include "qwt_color_map.h"
 #include "qwt_scale_map.h"
+#include "qwt_null_paintdevice.h"
 
 #include <qwidget.h>
 #include <qframe.h>
@@ -250,6 +251,9 @@ bool QwtPainter::isX11GraphicsSystem()
   coordinates to integers. Today these are all paint engines
   beside QPaintEngine::Pdf and QPaintEngine::SVG.
 
+  Unknown paint engines are not aligning, beside the engine of a
+  QwtNullPaintDevice, where QwtNullPaintDevice::isAligning() is enabled.
+
   If we have an integer based paint engine it is also
   checked if the painter has a transformation matrix,
   that rotates or scales.
@@ -268,8 +272,14 @@ bool QwtPainter::isAligning( const QPainter *painter )
 
         if ( type >= QPaintEngine::User )
         {
-            // we have no idea - better don't align
-            return false;
+            // we have no idea - better don't align, unless
+            // a null paint device tells us to do so
+
+            const QwtNullPaintDevice *nullDevice =
+                dynamic_cast< const QwtNullPaintDevice * >( painter->device() );
+
+            if ( nullDevice == NULL || !nullDevice->isAligning() )
+                return false;
         }
 
         switch ( type )
@@ -1202,12 +1212,6 @@ void QwtPainter::drawColorBar( QPainter *painter,
         const QwtScaleMap &scaleMap, Qt::Orientation orientation,
         const QRectF &rect )
 {
-    QVector<QRgb> colorTable;
-    if ( colorMap.format() == QwtColorMap::Indexed )
-        colorTable = colorMap.colorTable256();
-
-    QColor c;
-
     const QRect devRect = rect.toAlignedRect();
 
     /*
@@ -1221,42 +1225,61 @@ void QwtPainter::drawColorBar( QPainter *painter,
     QPainter pmPainter( &pixmap );
     pmPainter.translate( -devRect.x(), -devRect.y() );
 
+    QwtScaleMap sMap = scaleMap;
+
+    int from, to;
     if ( orientation == Qt::Horizontal )
     {
-        QwtScaleMap sMap = scaleMap;
         sMap.setPaintInterval( rect.left(), rect.right() );
 
-        for ( int x = devRect.left(); x <= devRect.right(); x++ )
-        {
-            const double value = sMap.invTransform( x );
-
-            if ( colorMap.format() == QwtColorMap::RGB )
-                c.setRgba( colorMap.rgb( interval, value ) );
-            else
-                c = colorTable[colorMap.colorIndex( 256, interval, value )];
-
-            pmPainter.setPen( c );
-            pmPainter.drawLine( x, devRect.top(), x, devRect.bottom() );
-        }
+        from = devRect.left();
+        to = devRect.right();
     }
     else // Vertical
     {
-        QwtScaleMap sMap = scaleMap;
         sMap.setPaintInterval( rect.bottom(), rect.top() );
 
-        for ( int y = devRect.top(); y <= devRect.bottom(); y++ )
-        {
-            const double value = sMap.invTransform( y );
+        from = devRect.top();
+        to = devRect.bottom();
+    }
 
-            if ( colorMap.format() == QwtColorMap::RGB )
-                c.setRgba( colorMap.rgb( interval, value ) );
-            else
-                c = colorTable[colorMap.colorIndex( 256, interval, value )];
+    // mapping all values at once is much faster than one by one
 
-            pmPainter.setPen( c );
-            pmPainter.drawLine( devRect.left(), y, devRect.right(), y );
-        }
+    const int numValues = qMax( to - from + 1, 0 );
+
+    QVector<double> values( numValues );
+    for ( int i = 0; i < numValues; i++ )
+        values[i] = sMap.invTransform( from + i );
+
+    QVector<QRgb> rgbs( numValues );
+    if ( colorMap.format() == QwtColorMap::RGB )
+    {
+        colorMap.rgbValues( interval,
+            values.constData(), numValues, rgbs.data() );
     }
+    else
+    {
+        const QVector<QRgb> colorTable = colorMap.colorTable256();
+
+        QVector<uchar> indexes( numValues );
+        colorMap.colorIndexes( 256, interval,
+            values.constData(), numValues, indexes.data() );
+
+        for ( int i = 0; i < numValues; i++ )
+            rgbs[i] = colorTable[ indexes[i] ];
+    }
+
+    for ( int i = 0; i < numValues; i++ )
+    {
+        pmPainter.setPen( QColor::fromRgba( rgbs[i] ) );
+
+        const int pos = from + i;
+        if ( orientation == Qt::Horizontal )
+            pmPainter.drawLine( pos, devRect.top(), pos, devRect.bottom() );
+        else
+            pmPainter.drawLine( devRect.left(), pos, devRect.right(), pos );
+    }
+
     pmPainter.end();
 
     drawPixmap( painter, rect, pixmap );
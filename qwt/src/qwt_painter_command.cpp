@@ -9,6 +9,9 @@
 
 #include "qwt_painter_command.h"
 
+#include <qpainterpath.h>
+#include <qdatastream.h>
+
 //! Construct an invalid command
 QwtPainterCommand::QwtPainterCommand():
     d_type( Invalid )
@@ -235,3 +238,242 @@ QwtPainterCommand::StateData* QwtPainterCommand::stateData()
 {
     return d_stateData;
 }
+
+#ifndef QT_NO_DATASTREAM
+
+/*!
+  \brief Write a paint command to a stream
+
+  Only the attributes, that are relevant for the type of
+  the command are written. For state changes these are the
+  attributes indicated by the dirty flags.
+
+  \param stream Output stream
+  \param cmd Paint command
+
+  \return Reference to the stream
+  \sa operator>>(QDataStream &, QwtPainterCommand &)
+ */
+QDataStream &operator<<( QDataStream &stream, const QwtPainterCommand &cmd )
+{
+    stream << qint8( cmd.type() );
+
+    switch( cmd.type() )
+    {
+        case QwtPainterCommand::Path:
+        {
+            stream << *cmd.path();
+            break;
+        }
+        case QwtPainterCommand::Pixmap:
+        {
+            const QwtPainterCommand::PixmapData *data = cmd.pixmapData();
+            stream << data->rect << data->pixmap << data->subRect;
+            break;
+        }
+        case QwtPainterCommand::Image:
+        {
+            const QwtPainterCommand::ImageData *data = cmd.imageData();
+            stream << data->rect << data->image << data->subRect
+                << quint32( data->flags );
+            break;
+        }
+        case QwtPainterCommand::State:
+        {
+            const QwtPainterCommand::StateData *data = cmd.stateData();
+            const QPaintEngine::DirtyFlags flags = data->flags;
+
+            stream << quint32( flags );
+
+            if ( flags & QPaintEngine::DirtyPen )
+                stream << data->pen;
+
+            if ( flags & QPaintEngine::DirtyBrush )
+                stream << data->brush;
+
+            if ( flags & QPaintEngine::DirtyBrushOrigin )
+                stream << data->brushOrigin;
+
+            if ( flags & QPaintEngine::DirtyFont )
+                stream << data->font;
+
+            if ( flags & QPaintEngine::DirtyBackground )
+                stream << qint8( data->backgroundMode ) << data->backgroundBrush;
+
+            if ( flags & QPaintEngine::DirtyTransform )
+                stream << data->transform;
+
+            if ( flags & QPaintEngine::DirtyClipEnabled )
+                stream << data->isClipEnabled;
+
+            if ( flags & QPaintEngine::DirtyClipRegion )
+                stream << data->clipRegion << qint8( data->clipOperation );
+
+            if ( flags & QPaintEngine::DirtyClipPath )
+                stream << data->clipPath << qint8( data->clipOperation );
+
+            if ( flags & QPaintEngine::DirtyHints )
+                stream << quint32( data->renderHints );
+
+            if ( flags & QPaintEngine::DirtyCompositionMode )
+                stream << qint32( data->compositionMode );
+
+            if ( flags & QPaintEngine::DirtyOpacity )
+                stream << double( data->opacity );
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    return stream;
+}
+
+/*!
+  \brief Read a paint command from a stream
+
+  \param stream Input stream
+  \param cmd Paint command
+
+  \return Reference to the stream
+  \sa operator<<(QDataStream &, const QwtPainterCommand &)
+ */
+QDataStream &operator>>( QDataStream &stream, QwtPainterCommand &cmd )
+{
+    cmd.reset();
+
+    qint8 type;
+    stream >> type;
+
+    switch( type )
+    {
+        case QwtPainterCommand::Path:
+        {
+            QPainterPath path;
+            stream >> path;
+
+            cmd.d_path = new QPainterPath( path );
+            break;
+        }
+        case QwtPainterCommand::Pixmap:
+        {
+            QwtPainterCommand::PixmapData *data =
+                new QwtPainterCommand::PixmapData();
+
+            stream >> data->rect >> data->pixmap >> data->subRect;
+
+            cmd.d_pixmapData = data;
+            break;
+        }
+        case QwtPainterCommand::Image:
+        {
+            QwtPainterCommand::ImageData *data =
+                new QwtPainterCommand::ImageData();
+
+            quint32 flags;
+            stream >> data->rect >> data->image >> data->subRect >> flags;
+
+            data->flags = Qt::ImageConversionFlags( flags );
+
+            cmd.d_imageData = data;
+            break;
+        }
+        case QwtPainterCommand::State:
+        {
+            QwtPainterCommand::StateData *data =
+                new QwtPainterCommand::StateData();
+
+            quint32 dirtyFlags;
+            stream >> dirtyFlags;
+
+            const QPaintEngine::DirtyFlags flags =
+                static_cast< QPaintEngine::DirtyFlags >( dirtyFlags );
+
+            data->flags = flags;
+
+            if ( flags & QPaintEngine::DirtyPen )
+                stream >> data->pen;
+
+            if ( flags & QPaintEngine::DirtyBrush )
+                stream >> data->brush;
+
+            if ( flags & QPaintEngine::DirtyBrushOrigin )
+                stream >> data->brushOrigin;
+
+            if ( flags & QPaintEngine::DirtyFont )
+                stream >> data->font;
+
+            if ( flags & QPaintEngine::DirtyBackground )
+            {
+                qint8 mode;
+                stream >> mode >> data->backgroundBrush;
+
+                data->backgroundMode = static_cast< Qt::BGMode >( mode );
+            }
+
+            if ( flags & QPaintEngine::DirtyTransform )
+                stream >> data->transform;
+
+            if ( flags & QPaintEngine::DirtyClipEnabled )
+                stream >> data->isClipEnabled;
+
+            if ( flags & QPaintEngine::DirtyClipRegion )
+            {
+                qint8 operation;
+                stream >> data->clipRegion >> operation;
+
+                data->clipOperation = static_cast< Qt::ClipOperation >( operation );
+            }
+
+            if ( flags & QPaintEngine::DirtyClipPath )
+            {
+                qint8 operation;
+                stream >> data->clipPath >> operation;
+
+                data->clipOperation = static_cast< Qt::ClipOperation >( operation );
+            }
+
+            if ( flags & QPaintEngine::DirtyHints )
+            {
+                quint32 hints;
+                stream >> hints;
+
+                data->renderHints = static_cast< QPainter::RenderHints >( hints );
+            }
+
+            if ( flags & QPaintEngine::DirtyCompositionMode )
+            {
+                qint32 mode;
+                stream >> mode;
+
+                data->compositionMode =
+                    static_cast< QPainter::CompositionMode >( mode );
+            }
+
+            if ( flags & QPaintEngine::DirtyOpacity )
+            {
+                double opacity;
+                stream >> opacity;
+
+                data->opacity = opacity;
+            }
+
+            cmd.d_stateData = data;
+            break;
+        }
+        default:
+        {
+            if ( type != QwtPainterCommand::Invalid )
+                stream.setStatus( QDataStream::ReadCorruptData );
+
+            return stream;
+        }
+    }
+
+    cmd.d_type = static_cast< QwtPainterCommand::Type >( type );
+
+    return stream;
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include <qpolygon.h>
 
 class QPainterPath;
+class QDataStream;
 
 /*!
   QwtPainterCommand represents the attributes of a paint operation
@@ -124,6 +125,11 @@ public:
     const StateData* stateData() const;
 
 private:
+#ifndef QT_NO_DATASTREAM
+    friend QWT_EXPORT QDataStream &operator>>(
+        QDataStream &, QwtPainterCommand & );
+#endif
+
     void copy( const QwtPainterCommand & );
     void reset();
 
@@ -138,6 +144,11 @@ private:
     };
 };
 
+#ifndef QT_NO_DATASTREAM
+QWT_EXPORT QDataStream &operator<<( QDataStream &, const QwtPainterCommand & );
+QWT_EXPORT QDataStream &operator>>( QDataStream &, QwtPainterCommand & );
+#endif
+
 //! \return Type of the command
 inline QwtPainterCommand::Type QwtPainterCommand::type() const
 {
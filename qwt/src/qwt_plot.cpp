@@ -23,6 +23,7 @@
 #include <qpointer.h>
 #include <qapplication.h>
 #include <qcoreevent.h>
+#include <qset.h>
 
 static inline void qwtEnableLegendItems( QwtPlot *plot, bool on )
 {
@@ -84,9 +85,25 @@ static void qwtSetTabOrder(
     }
 }
 
+static QwtTextLabel *qwtCreateLabel( QwtPlot *plot, const char *name )
+{
+    QwtTextLabel *label = new QwtTextLabel( plot );
+    label->setObjectName( name );
+
+    QwtText text;
+    text.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
+    label->setText( text );
+
+    // updateLayout() shows labels with a text
+    label->hide();
+
+    return label;
+}
+
 class QwtPlot::PrivateData
 {
 public:
+    // labels are created, when a text is assigned
     QPointer<QwtTextLabel> titleLabel;
     QPointer<QwtTextLabel> footerLabel;
     QPointer<QWidget> canvas;
@@ -94,6 +111,9 @@ public:
     QwtPlotLayout *layout;
 
     bool autoReplot;
+
+    // items, that have called QwtPlotItem::legendChanged()
+    QSet<const QwtPlotItem *> pendingLegendItems;
 };
 
 /*!
@@ -140,21 +160,17 @@ void QwtPlot::initPlot( const QwtText &title )
     d_data->autoReplot = false;
 
     // title
-    d_data->titleLabel = new QwtTextLabel( this );
-    d_data->titleLabel->setObjectName( "QwtPlotTitle" );
-    d_data->titleLabel->setFont( QFont( fontInfo().family(), 14, QFont::Bold ) );
+    d_data->titleLabel = NULL;
 
-    QwtText text( title );
-    text.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
-    d_data->titleLabel->setText( text );
+    if ( !title.isEmpty() )
+    {
+        QwtText text( title );
+        text.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
+        titleLabel()->setText( text );
+    }
 
     // footer
-    d_data->footerLabel = new QwtTextLabel( this );
-    d_data->footerLabel->setObjectName( "QwtPlotFooter" );
-
-    QwtText footer;
-    footer.setRenderFlags( Qt::AlignCenter | Qt::TextWordWrap );
-    d_data->footerLabel->setText( footer );
+    d_data->footerLabel = NULL;
 
     // legend
     d_data->legend = NULL;
@@ -173,9 +189,12 @@ void QwtPlot::initPlot( const QwtText &title )
     resize( 200, 200 );
 
     QList<QWidget *> focusChain;
-    focusChain << this << d_data->titleLabel << axisWidget( xTop )
-        << axisWidget( yLeft ) << d_data->canvas << axisWidget( yRight )
-        << axisWidget( xBottom ) << d_data->footerLabel;
+    focusChain << this;
+
+    if ( d_data->titleLabel )
+        focusChain << d_data->titleLabel;
+
+    focusChain << axisWidget( yLeft ) << d_data->canvas << axisWidget( xBottom );
 
     for ( int i = 0; i < focusChain.size() - 1; i++ )
         qwtSetTabOrder( focusChain[i], focusChain[i+1], false );
@@ -324,9 +343,9 @@ bool QwtPlot::autoReplot() const
 */
 void QwtPlot::setTitle( const QString &title )
 {
-    if ( title != d_data->titleLabel->text().text() )
+    if ( title != this->title().text() )
     {
-        d_data->titleLabel->setText( title );
+        titleLabel()->setText( title );
         updateLayout();
     }
 }
@@ -337,9 +356,9 @@ void QwtPlot::setTitle( const QString &title )
 */
 void QwtPlot::setTitle( const QwtText &title )
 {
-    if ( title != d_data->titleLabel->text() )
+    if ( title != this->title() )
     {
-        d_data->titleLabel->setText( title );
+        titleLabel()->setText( title );
         updateLayout();
     }
 }
@@ -347,19 +366,37 @@ void QwtPlot::setTitle( const QwtText &title )
 //! \return Title of the plot
 QwtText QwtPlot::title() const
 {
-    return d_data->titleLabel->text();
+    if ( d_data->titleLabel )
+        return d_data->titleLabel->text();
+
+    return QwtText();
 }
 
-//! \return Title label widget.
+/*!
+  \return Title label widget.
+  \note The label is created on demand
+*/
 QwtTextLabel *QwtPlot::titleLabel()
 {
+    if ( d_data->titleLabel.isNull() )
+    {
+        QwtTextLabel *label = qwtCreateLabel( this, "QwtPlotTitle" );
+        label->setFont( QFont( fontInfo().family(), 14, QFont::Bold ) );
+
+        d_data->titleLabel = label;
+        insertIntoFocusChain( label );
+    }
+
     return d_data->titleLabel;
 }
 
-//! \return Title label widget.
+/*!
+  \return Title label widget.
+  \note The label is created on demand
+*/
 const QwtTextLabel *QwtPlot::titleLabel() const
 {
-    return d_data->titleLabel;
+    return const_cast< QwtPlot * >( this )->titleLabel();
 }
 
 /*!
@@ -368,9 +405,9 @@ const QwtTextLabel *QwtPlot::titleLabel() const
 */
 void QwtPlot::setFooter( const QString &text )
 {
-    if ( text != d_data->footerLabel->text().text() )
+    if ( text != footer().text() )
     {
-        d_data->footerLabel->setText( text );
+        footerLabel()->setText( text );
         updateLayout();
     }
 }
@@ -381,9 +418,9 @@ void QwtPlot::setFooter( const QString &text )
 */
 void QwtPlot::setFooter( const QwtText &text )
 {
-    if ( text != d_data->footerLabel->text() )
+    if ( text != footer() )
     {
-        d_data->footerLabel->setText( text );
+        footerLabel()->setText( text );
         updateLayout();
     }
 }
@@ -391,19 +428,67 @@ void QwtPlot::setFooter( const QwtText &text )
 //! \return Text of the footer
 QwtText QwtPlot::footer() const
 {
-    return d_data->footerLabel->text();
+    if ( d_data->footerLabel )
+        return d_data->footerLabel->text();
+
+    return QwtText();
 }
 
-//! \return Footer label widget.
+/*!
+  \return Footer label widget.
+  \note The label is created on demand
+*/
 QwtTextLabel *QwtPlot::footerLabel()
 {
+    if ( d_data->footerLabel.isNull() )
+    {
+        QwtTextLabel *label = qwtCreateLabel( this, "QwtPlotFooter" );
+
+        d_data->footerLabel = label;
+        insertIntoFocusChain( label );
+    }
+
     return d_data->footerLabel;
 }
 
-//! \return Footer label widget.
+/*!
+  \return Footer label widget.
+  \note The label is created on demand
+*/
 const QwtTextLabel *QwtPlot::footerLabel() const
 {
-    return d_data->footerLabel;
+    return const_cast< QwtPlot * >( this )->footerLabel();
+}
+
+/*
+  Insert a widget, that has been created on demand, into the
+  focus chain: plot, title, xTop, yLeft, canvas, yRight, xBottom, footer
+ */
+void QwtPlot::insertIntoFocusChain( QWidget *widget )
+{
+    if ( d_data->canvas.isNull() )
+    {
+        // called from initPlot(), that builds the chain itself
+        return;
+    }
+
+    QWidget *previousInChain = this;
+
+    if ( widget == d_data->footerLabel.data() )
+    {
+        previousInChain = axisWidget( xBottom );
+    }
+    else if ( hasAxisWidget( yRight ) && widget == axisWidget( yRight ) )
+    {
+        previousInChain = d_data->canvas;
+    }
+    else if ( hasAxisWidget( xTop ) && widget == axisWidget( xTop ) )
+    {
+        if ( d_data->titleLabel )
+            previousInChain = d_data->titleLabel;
+    }
+
+    qwtSetTabOrder( previousInChain, widget, false );
 }
 
 /*!
@@ -534,10 +619,14 @@ void QwtPlot::resizeEvent( QResizeEvent *e )
   or if any curves are attached to raw data, the plot has to
   be refreshed explicitly in order to make changes visible.
 
+  Pending updates of the legend are processed before.
+
   \sa updateAxes(), setAutoReplot()
 */
 void QwtPlot::replot()
 {
+    updatePendingLegends();
+
     bool doAutoReplot = autoReplot();
     setAutoReplot( false );
 
@@ -582,28 +671,40 @@ void QwtPlot::updateLayout()
 
     // resize and show the visible widgets
 
-    if ( !d_data->titleLabel->text().isEmpty() )
+    if ( d_data->titleLabel )
     {
-        d_data->titleLabel->setGeometry( titleRect );
-        if ( !d_data->titleLabel->isVisibleTo( this ) )
-            d_data->titleLabel->show();
+        if ( !d_data->titleLabel->text().isEmpty() )
+        {
+            d_data->titleLabel->setGeometry( titleRect );
+            if ( !d_data->titleLabel->isVisibleTo( this ) )
+                d_data->titleLabel->show();
+        }
+        else
+        {
+            d_data->titleLabel->hide();
+        }
     }
-    else
-        d_data->titleLabel->hide();
 
-    if ( !d_data->footerLabel->text().isEmpty() )
+    if ( d_data->footerLabel )
     {
-        d_data->footerLabel->setGeometry( footerRect );
-        if ( !d_data->footerLabel->isVisibleTo( this ) )
-            d_data->footerLabel->show();
-    }
-    else
-    {
-        d_data->footerLabel->hide();
+        if ( !d_data->footerLabel->text().isEmpty() )
+        {
+            d_data->footerLabel->setGeometry( footerRect );
+            if ( !d_data->footerLabel->isVisibleTo( this ) )
+                d_data->footerLabel->show();
+        }
+        else
+        {
+            d_data->footerLabel->hide();
+        }
     }
 
     for ( int axisId = 0; axisId < axisCnt; axisId++ )
     {
+        // don't create the widgets of axes, that have never been enabled
+        if ( !hasAxisWidget( axisId ) )
+            continue;
+
         QwtScaleWidget* scaleWidget = axisWidget( axisId );
 
         if ( axisEnabled( axisId ) )
@@ -971,7 +1072,12 @@ void QwtPlot::insertLegend( QwtAbstractLegend *legend,
             {
                 case LeftLegend:
                 {
-                    previousInChain = axisWidget( QwtPlot::xTop );
+                    if ( hasAxisWidget( QwtPlot::xTop ) )
+                        previousInChain = axisWidget( QwtPlot::xTop );
+                    else if ( d_data->titleLabel )
+                        previousInChain = d_data->titleLabel;
+                    else
+                        previousInChain = this;
                     break;
                 }
                 case TopLegend:
@@ -981,12 +1087,18 @@ void QwtPlot::insertLegend( QwtAbstractLegend *legend,
                 }
                 case RightLegend:
                 {
-                    previousInChain = axisWidget( QwtPlot::yRight );
+                    if ( hasAxisWidget( QwtPlot::yRight ) )
+                        previousInChain = axisWidget( QwtPlot::yRight );
+                    else
+                        previousInChain = d_data->canvas;
                     break;
                 }
                 case BottomLegend:
                 {
-                    previousInChain = footerLabel();
+                    if ( d_data->footerLabel )
+                        previousInChain = d_data->footerLabel;
+                    else
+                        previousInChain = axisWidget( QwtPlot::xBottom );
                     break;
                 }
             }
@@ -1002,7 +1114,10 @@ void QwtPlot::insertLegend( QwtAbstractLegend *legend,
 /*!
   Emit legendDataChanged() for all plot item
 
-  \sa QwtPlotItem::legendData(), legendDataChanged()
+  The icons, that are cached by the items, are created again.
+
+  \sa QwtPlotItem::legendData(), QwtPlotItem::invalidateLegendIcon(),
+      legendDataChanged()
  */
 void QwtPlot::updateLegend()
 {
@@ -1017,14 +1132,20 @@ void QwtPlot::updateLegend()
 /*!
   Emit legendDataChanged() for a plot item
 
+  The icon, that is cached by the item, is created again.
+
   \param plotItem Plot item
-  \sa QwtPlotItem::legendData(), legendDataChanged()
+  \sa QwtPlotItem::legendData(), QwtPlotItem::invalidateLegendIcon(),
+      legendDataChanged()
  */
 void QwtPlot::updateLegend( const QwtPlotItem *plotItem )
 {
     if ( plotItem == NULL )
         return;
 
+    d_data->pendingLegendItems.remove( plotItem );
+    plotItem->invalidateLegendIcon();
+
     QList<QwtLegendData> legendData;
 
     if ( plotItem->testItemAttribute( QwtPlotItem::Legend ) )
@@ -1034,6 +1155,62 @@ void QwtPlot::updateLegend( const QwtPlotItem *plotItem )
     Q_EMIT legendDataChanged( itemInfo, legendData );
 }
 
+/*!
+  \brief Schedule an update of the legend for a plot item
+
+  All updates, that are scheduled before control returns to the
+  event loop, are collected and processed once by updatePendingLegends().
+
+  \param plotItem Plot item
+  \sa QwtPlotItem::legendChanged(), updateLegend()
+ */
+void QwtPlot::scheduleLegendUpdate( const QwtPlotItem *plotItem )
+{
+    if ( plotItem == NULL )
+        return;
+
+    if ( d_data->pendingLegendItems.isEmpty() )
+    {
+        ( void )QMetaObject::invokeMethod(
+            this, "updatePendingLegends", Qt::QueuedConnection );
+    }
+
+    d_data->pendingLegendItems.insert( plotItem );
+}
+
+/*!
+  Emit legendDataChanged() for all plot items, that have
+  scheduled an update of the legend
+
+  The pending updates are processed, when control returns to the
+  event loop or when replotting. Code, that needs an updated legend
+  without running an event loop - f.e. QwtPlotRenderer - has to
+  call this method itself.
+
+  \sa scheduleLegendUpdate(), QwtPlotItem::legendChanged()
+ */
+void QwtPlot::updatePendingLegends()
+{
+    if ( d_data->pendingLegendItems.isEmpty() )
+        return;
+
+    // legends might schedule updates, while being updated
+
+    const QSet<const QwtPlotItem *> pendingItems = d_data->pendingLegendItems;
+    d_data->pendingLegendItems.clear();
+
+    // iterating over the items list keeps the order of the items
+    // and ignores items, that have been detached in between
+
+    const QwtPlotItemList itmList = itemList();
+    for ( QwtPlotItemIterator it = itmList.begin();
+        it != itmList.end(); ++it )
+    {
+        if ( pendingItems.contains( *it ) )
+            updateLegend( *it );
+    }
+}
+
 /*!
   \brief Update all plot items interested in legend attributes
 
@@ -1091,9 +1268,14 @@ void QwtPlot::attachItem( QwtPlotItem *plotItem, bool on )
     }
 
     if ( on )
+    {
         insertItem( plotItem );
+    }
     else
+    {
         removeItem( plotItem );
+        d_data->pendingLegendItems.remove( plotItem );
+    }
 
     Q_EMIT itemAttached( plotItem, on );
 
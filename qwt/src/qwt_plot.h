@@ -209,6 +209,7 @@ public:
 
     const QwtScaleWidget *axisWidget( int axisId ) const;
     QwtScaleWidget *axisWidget( int axisId );
+    bool hasAxisWidget( int axisId ) const;
 
     void setAxisLabelAlignment( int axisId, Qt::Alignment );
     void setAxisLabelRotation( int axisId, double rotation );
@@ -283,6 +284,7 @@ Q_SIGNALS:
 public Q_SLOTS:
     virtual void replot();
     void autoRefresh();
+    void updatePendingLegends();
 
 protected:
     static bool axisValid( int axisId );
@@ -296,11 +298,15 @@ private Q_SLOTS:
 private:
     friend class QwtPlotItem;
     void attachItem( QwtPlotItem *, bool );
+    void scheduleLegendUpdate( const QwtPlotItem * );
 
     void initAxesData();
     void deleteAxesData();
     void updateScaleDiv();
 
+    void createAxisWidget( int axisId ) const;
+    void insertIntoFocusChain( QWidget * );
+
     void initPlot( const QwtText &title );
 
     class AxisData;
@@ -9,8 +9,11 @@
 
 #include "qwt_plot_abstract_barchart.h"
 #include "qwt_scale_map.h"
+#include "qwt_column_symbol.h"
 #include "qwt_math.h"
 
+#include <qvector.h>
+
 static inline double qwtTransformWidth(
     const QwtScaleMap &map, double value, double width )
 {
@@ -22,6 +25,123 @@ static inline double qwtTransformWidth(
     return qAbs( v2 - v1 );
 }
 
+static inline bool qwtIsVisible( const QRectF &r, const QRectF &canvasRect )
+{
+    return ( r.right() >= canvasRect.left() - 1.0 )
+        && ( r.left() <= canvasRect.right() + 1.0 )
+        && ( r.bottom() >= canvasRect.top() - 1.0 )
+        && ( r.top() <= canvasRect.bottom() + 1.0 );
+}
+
+static inline QwtColumnRect qwtMergedColumn(
+    QwtColumnRect::Direction direction, double pos,
+    double min, double max )
+{
+    QwtColumnRect column;
+    column.direction = direction;
+
+    if ( column.orientation() == Qt::Vertical )
+    {
+        column.hInterval = QwtInterval( pos, pos );
+        column.vInterval = QwtInterval( min, max );
+    }
+    else
+    {
+        column.hInterval = QwtInterval( min, max );
+        column.vInterval = QwtInterval( pos, pos );
+    }
+
+    return column;
+}
+
+static QVector<QwtColumnRect> qwtAggregatedColumns(
+    const QVector<QwtColumnRect> &columns, const QRectF &canvasRect )
+{
+    QVector<QwtColumnRect> aggregated;
+    aggregated.reserve( columns.size() );
+
+    /*
+      Consecutive columns, that are not wider than a pixel and
+      are mapped into the same pixel column are merged into
+      a column of zero width - what is painted as one pixel.
+     */
+
+    bool pending = false;
+    Qt::Orientation pendingOrientation = Qt::Vertical;
+    double pendingPos = 0.0;
+    double pendingMin = 0.0;
+    double pendingMax = 0.0;
+    QwtColumnRect::Direction pendingDirection = QwtColumnRect::BottomToTop;
+
+    for ( int i = 0; i < columns.size(); i++ )
+    {
+        const QwtColumnRect &column = columns[i];
+        const QRectF r = column.toRect();
+
+        if ( !qwtIsVisible( r, canvasRect ) )
+            continue;
+
+        const Qt::Orientation orientation = column.orientation();
+
+        double pos1, pos2, v1, v2;
+        if ( orientation == Qt::Vertical )
+        {
+            pos1 = r.left();
+            pos2 = r.right();
+            v1 = r.top();
+            v2 = r.bottom();
+        }
+        else
+        {
+            pos1 = r.top();
+            pos2 = r.bottom();
+            v1 = r.left();
+            v2 = r.right();
+        }
+
+        const bool isThin = ( pos2 - pos1 ) < 1.0;
+        const double pos = qwtFloor( 0.5 * ( pos1 + pos2 ) );
+
+        if ( pending )
+        {
+            if ( isThin && pos == pendingPos
+                && orientation == pendingOrientation )
+            {
+                pendingMin = qwtMinF( pendingMin, v1 );
+                pendingMax = qwtMaxF( pendingMax, v2 );
+
+                continue;
+            }
+
+            aggregated += qwtMergedColumn( pendingDirection,
+                pendingPos, pendingMin, pendingMax );
+            pending = false;
+        }
+
+        if ( isThin )
+        {
+            pending = true;
+            pendingOrientation = orientation;
+            pendingDirection = column.direction;
+            pendingPos = pos;
+            pendingMin = v1;
+            pendingMax = v2;
+        }
+        else
+        {
+            aggregated += column;
+        }
+    }
+
+    if ( pending )
+    {
+        aggregated += qwtMergedColumn( pendingDirection,
+            pendingPos, pendingMin, pendingMax );
+    }
+
+    return aggregated;
+}
+
 class QwtPlotAbstractBarChart::PrivateData
 {
 public:
@@ -34,6 +154,8 @@ public:
     {
     }
 
+    QwtPlotAbstractBarChart::PaintAttributes paintAttributes;
+
     QwtPlotAbstractBarChart::LayoutPolicy layoutPolicy;
     double layoutHint;
     int spacing;
@@ -210,6 +332,32 @@ double QwtPlotAbstractBarChart::baseline() const
     return d_data->baseline;
 }
 
+/*!
+  Specify an attribute how to draw the chart
+
+  \param attribute Paint attribute
+  \param on On/Off
+  \sa testPaintAttribute()
+*/
+void QwtPlotAbstractBarChart::setPaintAttribute(
+    PaintAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->paintAttributes |= attribute;
+    else
+        d_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa PaintAttribute, setPaintAttribute()
+*/
+bool QwtPlotAbstractBarChart::testPaintAttribute(
+    PaintAttribute attribute ) const
+{
+    return ( d_data->paintAttributes & attribute );
+}
+
 /*!
    Calculate the width for a sample in paint device coordinates
 
@@ -264,6 +412,35 @@ double QwtPlotAbstractBarChart::sampleWidth( const QwtScaleMap &map,
     return width;
 }
 
+/*!
+   Draw a series of columns with the same symbol in one batch
+
+   Columns outside of the canvas are skipped and consecutive columns,
+   that are not wider than a pixel and are mapped into the same pixel
+   column are merged.
+
+   \param painter Painter
+   \param canvasRect Contents rectangle of the canvas
+   \param symbol Symbol for all columns
+   \param columns Directed rectangles of the columns in paint
+                  device coordinates
+
+   \sa AggregateBars, QwtColumnSymbol::drawColumns()
+*/
+void QwtPlotAbstractBarChart::drawColumns( QPainter *painter,
+    const QRectF &canvasRect, const QwtColumnSymbol *symbol,
+    const QVector<QwtColumnRect> &columns ) const
+{
+    if ( symbol == NULL || columns.isEmpty() )
+        return;
+
+    const QVector<QwtColumnRect> aggregated =
+        qwtAggregatedColumns( columns, canvasRect );
+
+    symbol->drawColumns( painter,
+        aggregated.constData(), aggregated.size() );
+}
+
 /*!
    \brief Calculate a hint for the canvas margin
 
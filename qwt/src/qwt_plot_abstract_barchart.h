@@ -13,6 +13,10 @@
 #include "qwt_global.h"
 #include "qwt_plot_seriesitem.h"
 
+class QwtColumnSymbol;
+class QwtColumnRect;
+template <typename T> class QVector;
+
 /*!
   \brief Abstract base class for bar chart items
 
@@ -59,6 +63,31 @@ public:
         FixedSampleSize
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        \sa setPaintAttribute(), testPaintAttribute()
+     */
+    enum PaintAttribute
+    {
+        /*!
+          Bars, that are painted with the default symbol are collected
+          and painted in one batch for each symbol ( see
+          QwtColumnSymbol::drawColumns() ). Bars, that are not wider than
+          a pixel and are mapped into the same pixel column, are merged
+          into one bar from their minimum to their maximum.
+
+          Bars outside of the canvas are not painted at all.
+
+          This is intended for charts with a huge number of samples on
+          raster devices. drawSample() and drawBar() are not called for
+          bars being painted in a batch.
+         */
+        AggregateBars = 0x01
+    };
+
+    //! Paint attributes
+    typedef QFlags<PaintAttribute> PaintAttributes;
+
     explicit QwtPlotAbstractBarChart( const QwtText &title );
     virtual ~QwtPlotAbstractBarChart();
 
@@ -77,6 +106,9 @@ public:
     void setBaseline( double );
     double baseline() const;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     virtual void getCanvasMarginHint(
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect, double &left, double &top,
@@ -88,9 +120,14 @@ protected:
         double canvasSize, double boundingSize,
         double value ) const;
 
+    void drawColumns( QPainter *, const QRectF &canvasRect,
+        const QwtColumnSymbol *, const QVector<QwtColumnRect> & ) const;
+
 private:
     class PrivateData;
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotAbstractBarChart::PaintAttributes )
+
 #endif
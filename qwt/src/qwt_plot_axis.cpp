@@ -31,6 +31,8 @@ public:
 
     QwtScaleDiv scaleDiv;
     QwtScaleEngine *scaleEngine;
+
+    // NULL, until the axis is enabled or its widget is accessed
     QwtScaleWidget *scaleWidget;
 };
 
@@ -42,41 +44,12 @@ void QwtPlot::initAxesData()
     for ( axisId = 0; axisId < axisCnt; axisId++ )
         d_axisData[axisId] = new AxisData;
 
-    d_axisData[yLeft]->scaleWidget =
-        new QwtScaleWidget( QwtScaleDraw::LeftScale, this );
-    d_axisData[yRight]->scaleWidget =
-        new QwtScaleWidget( QwtScaleDraw::RightScale, this );
-    d_axisData[xTop]->scaleWidget =
-        new QwtScaleWidget( QwtScaleDraw::TopScale, this );
-    d_axisData[xBottom]->scaleWidget =
-        new QwtScaleWidget( QwtScaleDraw::BottomScale, this );
-
-    d_axisData[yLeft]->scaleWidget->setObjectName( "QwtPlotAxisYLeft" );
-    d_axisData[yRight]->scaleWidget->setObjectName( "QwtPlotAxisYRight" );
-    d_axisData[xTop]->scaleWidget->setObjectName( "QwtPlotAxisXTop" );
-    d_axisData[xBottom]->scaleWidget->setObjectName( "QwtPlotAxisXBottom" );
-
-#if 1
-    // better find the font sizes from the application font
-    QFont fscl( fontInfo().family(), 10 );
-    QFont fttl( fontInfo().family(), 12, QFont::Bold );
-#endif
-
     for ( axisId = 0; axisId < axisCnt; axisId++ )
     {
         AxisData &d = *d_axisData[axisId];
 
         d.scaleEngine = new QwtLinearScaleEngine;
-
-        d.scaleWidget->setTransformation(
-            d.scaleEngine->transformation() );
-
-        d.scaleWidget->setFont( fscl );
-        d.scaleWidget->setMargin( 2 );
-
-        QwtText text = d.scaleWidget->title();
-        text.setFont( fttl );
-        d.scaleWidget->setTitle( text );
+        d.scaleWidget = NULL;
 
         d.doAutoScale = true;
 
@@ -95,6 +68,101 @@ void QwtPlot::initAxesData()
     d_axisData[yRight]->isEnabled = false;
     d_axisData[xBottom]->isEnabled = true;
     d_axisData[xTop]->isEnabled = false;
+
+    // the widgets of the disabled axes are created, when being needed
+
+    createAxisWidget( yLeft );
+    createAxisWidget( xBottom );
+}
+
+/*
+   Plots often display 2 axes only, but a QwtScaleWidget is
+   an expensive object. So the widget of an axis is created, when
+   it gets enabled or when one of its attributes is accessed.
+ */
+void QwtPlot::createAxisWidget( int axisId ) const
+{
+    AxisData &d = *d_axisData[axisId];
+    if ( d.scaleWidget )
+        return;
+
+    QwtScaleDraw::Alignment alignment;
+    const char *name;
+
+    switch( axisId )
+    {
+        case yLeft:
+        {
+            alignment = QwtScaleDraw::LeftScale;
+            name = "QwtPlotAxisYLeft";
+            break;
+        }
+        case yRight:
+        {
+            alignment = QwtScaleDraw::RightScale;
+            name = "QwtPlotAxisYRight";
+            break;
+        }
+        case xTop:
+        {
+            alignment = QwtScaleDraw::TopScale;
+            name = "QwtPlotAxisXTop";
+            break;
+        }
+        default:
+        {
+            alignment = QwtScaleDraw::BottomScale;
+            name = "QwtPlotAxisXBottom";
+            break;
+        }
+    }
+
+    QwtPlot *plot = const_cast< QwtPlot * >( this );
+
+    QwtScaleWidget *scaleWidget = new QwtScaleWidget( alignment, plot );
+    scaleWidget->setObjectName( name );
+
+#if 1
+    // better find the font sizes from the application font
+    QFont fscl( fontInfo().family(), 10 );
+    QFont fttl( fontInfo().family(), 12, QFont::Bold );
+#endif
+
+    scaleWidget->setTransformation( d.scaleEngine->transformation() );
+
+    scaleWidget->setFont( fscl );
+    scaleWidget->setMargin( 2 );
+
+    QwtText text = scaleWidget->title();
+    text.setFont( fttl );
+    scaleWidget->setTitle( text );
+
+    if ( d.isValid )
+    {
+        scaleWidget->setScaleDiv( d.scaleDiv );
+
+        int startDist, endDist;
+        scaleWidget->getBorderDistHint( startDist, endDist );
+        scaleWidget->setBorderDist( startDist, endDist );
+    }
+
+    // updateLayout() shows the widgets of the enabled axes
+    scaleWidget->hide();
+
+    d.scaleWidget = scaleWidget;
+
+    plot->insertIntoFocusChain( scaleWidget );
+}
+
+/*!
+  \return True, when the widget of an axis has been created
+  \param axisId Axis index
+
+  \sa axisWidget()
+*/
+bool QwtPlot::hasAxisWidget( int axisId ) const
+{
+    return axisValid( axisId ) && d_axisData[axisId]->scaleWidget != NULL;
 }
 
 void QwtPlot::deleteAxesData()
@@ -110,11 +178,18 @@ void QwtPlot::deleteAxesData()
 /*!
   \return Scale widget of the specified axis, or NULL if axisId is invalid.
   \param axisId Axis index
+
+  \note The widgets of axes, that have never been enabled, are created
+        on demand.
+  \sa hasAxisWidget()
 */
 const QwtScaleWidget *QwtPlot::axisWidget( int axisId ) const
 {
     if ( axisValid( axisId ) )
+    {
+        createAxisWidget( axisId );
         return d_axisData[axisId]->scaleWidget;
+    }
 
     return NULL;
 }
@@ -122,11 +197,18 @@ const QwtScaleWidget *QwtPlot::axisWidget( int axisId ) const
 /*!
   \return Scale widget of the specified axis, or NULL if axisId is invalid.
   \param axisId Axis index
+
+  \note The widgets of axes, that have never been enabled, are created
+        on demand.
+  \sa hasAxisWidget()
 */
 QwtScaleWidget *QwtPlot::axisWidget( int axisId )
 {
     if ( axisValid( axisId ) )
+    {
+        createAxisWidget( axisId );
         return d_axisData[axisId]->scaleWidget;
+    }
 
     return NULL;
 }
@@ -148,8 +230,8 @@ void QwtPlot::setAxisScaleEngine( int axisId, QwtScaleEngine *scaleEngine )
         delete d.scaleEngine;
         d.scaleEngine = scaleEngine;
 
-        d_axisData[axisId]->scaleWidget->setTransformation(
-            scaleEngine->transformation() );
+        if ( d.scaleWidget )
+            d.scaleWidget->setTransformation( scaleEngine->transformation() );
 
         d.isValid = false;
 
@@ -353,6 +435,10 @@ void QwtPlot::enableAxis( int axisId, bool tf )
     if ( axisValid( axisId ) && tf != d_axisData[axisId]->isEnabled )
     {
         d_axisData[axisId]->isEnabled = tf;
+
+        if ( tf )
+            createAxisWidget( axisId );
+
         updateLayout();
     }
 }
@@ -698,12 +784,15 @@ void QwtPlot::updateAxes()
             d.isValid = true;
         }
 
-        QwtScaleWidget *scaleWidget = axisWidget( axisId );
-        scaleWidget->setScaleDiv( d.scaleDiv );
+        QwtScaleWidget *scaleWidget = d.scaleWidget;
+        if ( scaleWidget )
+        {
+            scaleWidget->setScaleDiv( d.scaleDiv );
 
-        int startDist, endDist;
-        scaleWidget->getBorderDistHint( startDist, endDist );
-        scaleWidget->setBorderDist( startDist, endDist );
+            int startDist, endDist;
+            scaleWidget->getBorderDistHint( startDist, endDist );
+            scaleWidget->setBorderDist( startDist, endDist );
+        }
     }
 
     for ( it = itmList.begin(); it != itmList.end(); ++it )
@@ -15,6 +15,7 @@
 #include "qwt_legend_data.h"
 
 #include <qpainter.h>
+#include <qvector.h>
 
 class QwtPlotBarChart::PrivateData
 {
@@ -239,10 +240,51 @@ void QwtPlotBarChart::drawSeries( QPainter *painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    if ( testPaintAttribute( QwtPlotAbstractBarChart::AggregateBars ) )
     {
-        drawSample( painter, xMap, yMap,
-                    canvasRect, interval, i, sample( i ) );
+        QVector<QwtColumnRect> columns;
+        columns.reserve( to - from + 1 );
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QPointF sample = this->sample( i );
+
+            const QwtColumnRect barRect = columnRect( xMap, yMap,
+                canvasRect, interval, sample );
+
+            const QwtColumnSymbol *specialSym = specialSymbol( i, sample );
+            if ( specialSym )
+            {
+                specialSym->draw( painter, barRect );
+                delete specialSym;
+            }
+            else
+            {
+                columns += barRect;
+            }
+        }
+
+        if ( d_data->symbol )
+        {
+            drawColumns( painter, canvasRect, d_data->symbol, columns );
+        }
+        else
+        {
+            // we build a temporary default symbol
+            QwtColumnSymbol columnSymbol( QwtColumnSymbol::Box );
+            columnSymbol.setLineWidth( 1 );
+            columnSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+            drawColumns( painter, canvasRect, &columnSymbol, columns );
+        }
+    }
+    else
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                        canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
@@ -21,6 +21,7 @@
 #include "qwt_graphic.h"
 
 #include <qpainter.h>
+#include <qpainterpath.h>
 
 static inline QRectF qwtIntersectedClipRect( const QRectF &rect, QPainter *painter )
 {
@@ -38,6 +39,270 @@ static inline QRectF qwtIntersectedClipRect( const QRectF &rect, QPainter *paint
     return clipRect;
 }
 
+static void qwtAppendReversed( const QPolygonF &points, QPolygonF &polygon )
+{
+    const int numPoints = points.size();
+    polygon.reserve( polygon.size() + numPoints );
+
+    const QPointF *p = points.constData();
+    for ( int i = numPoints - 1; i >= 0; i-- )
+        polygon += p[i];
+}
+
+namespace
+{
+    /*
+      Sutherland-Hodgman clipping of a closed polygon, that remembers
+      for each vertex if the edge leading to it is part of the curve.
+      Edges, that close the polygon or run along the clip rectangle,
+      are no part of the outline.
+     */
+    class QwtOutlineClipper
+    {
+    public:
+        QwtOutlineClipper( const QRectF &clipRect ):
+            d_rect( clipRect )
+        {
+        }
+
+        void clipPolygon( QPolygonF &points, QVector<bool> &isOutline ) const
+        {
+            QPolygonF points2;
+            QVector<bool> isOutline2;
+
+            clipEdge( LeftEdge, points, isOutline, points2, isOutline2 );
+            clipEdge( RightEdge, points2, isOutline2, points, isOutline );
+            clipEdge( TopEdge, points, isOutline, points2, isOutline2 );
+            clipEdge( BottomEdge, points2, isOutline2, points, isOutline );
+        }
+
+    private:
+        enum Edge
+        {
+            LeftEdge,
+            RightEdge,
+            TopEdge,
+            BottomEdge
+        };
+
+        inline bool isInside( Edge edge, const QPointF &pos ) const
+        {
+            switch( edge )
+            {
+                case LeftEdge:
+                    return pos.x() >= d_rect.left();
+                case RightEdge:
+                    return pos.x() <= d_rect.right();
+                case TopEdge:
+                    return pos.y() >= d_rect.top();
+                default:
+                    return pos.y() <= d_rect.bottom();
+            }
+        }
+
+        inline QPointF intersection( Edge edge,
+            const QPointF &p1, const QPointF &p2 ) const
+        {
+            if ( edge == LeftEdge || edge == RightEdge )
+            {
+                const double x = ( edge == LeftEdge )
+                    ? d_rect.left() : d_rect.right();
+
+                const double dy = ( p1.y() - p2.y() ) / ( p1.x() - p2.x() );
+                return QPointF( x, p2.y() + ( x - p2.x() ) * dy );
+            }
+            else
+            {
+                const double y = ( edge == TopEdge )
+                    ? d_rect.top() : d_rect.bottom();
+
+                const double dx = ( p1.x() - p2.x() ) / ( p1.y() - p2.y() );
+                return QPointF( p2.x() + ( y - p2.y() ) * dx, y );
+            }
+        }
+
+        void clipEdge( Edge edge,
+            const QPolygonF &points, const QVector<bool> &isOutline,
+            QPolygonF &clippedPoints, QVector<bool> &clippedIsOutline ) const
+        {
+            clippedPoints.resize( 0 );
+            clippedIsOutline.resize( 0 );
+
+            const int numPoints = points.size();
+            if ( numPoints == 0 )
+                return;
+
+            const QPointF *p = points.constData();
+
+            QPointF p1 = p[numPoints - 1];
+            bool isInside1 = isInside( edge, p1 );
+
+            for ( int i = 0; i < numPoints; i++ )
+            {
+                const QPointF &p2 = p[i];
+                const bool isInside2 = isInside( edge, p2 );
+
+                if ( isInside2 )
+                {
+                    if ( !isInside1 )
+                    {
+                        // entering: we came along the clip rectangle
+                        clippedPoints += intersection( edge, p1, p2 );
+                        clippedIsOutline += false;
+                    }
+
+                    clippedPoints += p2;
+                    clippedIsOutline += isOutline[i];
+                }
+                else if ( isInside1 )
+                {
+                    clippedPoints += intersection( edge, p1, p2 );
+                    clippedIsOutline += isOutline[i];
+                }
+
+                p1 = p2;
+                isInside1 = isInside2;
+            }
+        }
+
+        const QRectF d_rect;
+    };
+}
+
+static void qwtDrawOutline( QPainter *painter,
+    const QPolygonF &points, const QVector<bool> &isOutline )
+{
+    const int numPoints = points.size();
+
+    // start behind an edge, that is no part of the outline
+
+    int start = 0;
+    while ( start < numPoints && isOutline[start] )
+        start++;
+
+    if ( start == numPoints )
+        start = 0;
+
+    QPolygonF polyline;
+
+    for ( int i = 1; i <= numPoints; i++ )
+    {
+        const int idx = ( start + i ) % numPoints;
+
+        if ( isOutline[idx] )
+        {
+            if ( polyline.isEmpty() )
+                polyline += points[ ( idx + numPoints - 1 ) % numPoints ];
+
+            polyline += points[idx];
+        }
+        else if ( !polyline.isEmpty() )
+        {
+            QwtPainter::drawPolyline( painter, polyline );
+            polyline.resize( 0 );
+        }
+    }
+
+    if ( !polyline.isEmpty() )
+        QwtPainter::drawPolyline( painter, polyline );
+}
+
+static QPolygonF qwtSamplePoints(
+    const QwtSeriesData<QPointF> *series, int from, int to )
+{
+    const int numSamples = to - from + 1;
+    if ( numSamples <= 0 )
+        return QPolygonF();
+
+    QPolygonF points( numSamples );
+    QPointF *p = points.data();
+
+    for ( int i = 0; i < numSamples; i++ )
+        p[i] = series->sample( from + i );
+
+    return points;
+}
+
+static QPolygonF qwtMappedPolygon( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QPolygonF &polygon )
+{
+    const int numPoints = polygon.size();
+
+    QPolygonF points( numPoints );
+    QPointF *p = points.data();
+
+    const QPointF *p0 = polygon.constData();
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        p[i].rx() = xMap.transform( p0[i].x() );
+        p[i].ry() = yMap.transform( p0[i].y() );
+    }
+
+    return points;
+}
+
+static QPainterPath qwtMappedPath( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QPainterPath &path )
+{
+    /*
+      For linear scales the mapped control points of a Bezier curve
+      are the control points of the mapped curve. For other
+      transformations the result is a good approximation.
+     */
+
+    QPainterPath mappedPath = path;
+
+    for ( int i = 0; i < mappedPath.elementCount(); i++ )
+    {
+        const QPainterPath::Element el = mappedPath.elementAt( i );
+
+        mappedPath.setElementPositionAt( i,
+            xMap.transform( el.x ), yMap.transform( el.y ) );
+    }
+
+    return mappedPath;
+}
+
+static QPolygonF qwtMappedCurve( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QPolygonF &polygon, const QPainterPath &path )
+{
+    if ( path.isEmpty() )
+        return qwtMappedPolygon( xMap, yMap, polygon );
+
+    QPolygonF points;
+
+    const QList<QPolygonF> subPaths =
+        qwtMappedPath( xMap, yMap, path ).toSubpathPolygons();
+
+    for ( int i = 0; i < subPaths.size(); i++ )
+        points += subPaths[i];
+
+    return points;
+}
+
+static void qwtFitCurve( const QwtCurveFitter *fitter,
+    const QPolygonF &points, QPolygonF &polygon, QPainterPath &path )
+{
+    if ( fitter->mode() == QwtCurveFitter::Path )
+        path = fitter->fitCurvePath( points );
+    else
+        polygon = fitter->fitCurve( points );
+}
+
+static inline bool qwtIsSameMap(
+    const QwtScaleMap &map1, const QwtScaleMap &map2 )
+{
+    if ( map1.s1() != map2.s1() || map1.s2() != map2.s2()
+        || map1.p1() != map2.p1() || map1.p2() != map2.p2() )
+    {
+        return false;
+    }
+
+    // catching different transformations for the same intervals
+    const double s = 0.5 * ( map1.s1() + map1.s2() );
+    return map1.transform( s ) == map2.transform( s );
+}
+
 static void qwtUpdateLegendIconSize( QwtPlotCurve *curve )
 {
     if ( curve->symbol() &&
@@ -61,6 +326,22 @@ static void qwtUpdateLegendIconSize( QwtPlotCurve *curve )
     }
 }
 
+/*
+    The size of a pixel of a device with the filter resolution
+    in painter coordinates. 0.0 means no filtering.
+ */
+static double qwtFilterTolerance( const QPainter *painter, int resolution )
+{
+    if ( resolution <= 0 || QwtPainter::roundingAlignment( painter ) )
+        return 0.0;
+
+    const double scale = std::sqrt( qAbs( painter->transform().determinant() ) );
+    if ( scale <= 0.0 )
+        return 0.0;
+
+    return double( painter->device()->logicalDpiX() ) / resolution / scale;
+}
+
 static int qwtVerifyRange( int size, int &i1, int &i2 )
 {
     if ( size < 1 )
@@ -78,15 +359,76 @@ static int qwtVerifyRange( int size, int &i1, int &i2 )
 class QwtPlotCurve::PrivateData
 {
 public:
+    class FitCache
+    {
+    public:
+        FitCache():
+            isValid( false ),
+            inPlotCoordinates( false ),
+            isFilled( false ),
+            from( 0 ),
+            to( -1 )
+        {
+        }
+
+        bool matches( int first, int last, bool filled ) const
+        {
+            return isValid && inPlotCoordinates && ( isFilled == filled )
+                && ( from == first ) && ( to == last );
+        }
+
+        bool matches( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+            const QRectF &rect, const QRectF &clip,
+            int first, int last, bool filled ) const
+        {
+            return isValid && !inPlotCoordinates && ( isFilled == filled )
+                && ( from == first ) && ( to == last )
+                && ( canvasRect == rect ) && ( clipRect == clip )
+                && qwtIsSameMap( this->xMap, xMap )
+                && qwtIsSameMap( this->yMap, yMap );
+        }
+
+        void invalidate()
+        {
+            isValid = false;
+
+            polygon = QPolygonF();
+            baselinePolygon = QPolygonF();
+
+            path = QPainterPath();
+            baselinePath = QPainterPath();
+        }
+
+        bool isValid;
+        bool inPlotCoordinates;
+        bool isFilled;
+
+        // the key, when fitting translated points
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRectF canvasRect;
+        QRectF clipRect;
+        int from;
+        int to;
+
+        QPolygonF polygon;
+        QPainterPath path;
+
+        QPolygonF baselinePolygon;
+        QPainterPath baselinePath;
+    };
+
     PrivateData():
         style( QwtPlotCurve::Lines ),
         baseline( 0.0 ),
         symbol( NULL ),
+        baselineSeries( NULL ),
         pen( Qt::black ),
         attributes( 0 ),
         paintAttributes(
             QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints ),
-        legendAttributes( 0 )
+        legendAttributes( 0 ),
+        filterResolution( 0 )
     {
         curveFitter = new QwtSplineCurveFitter;
     }
@@ -95,6 +437,7 @@ public:
     {
         delete symbol;
         delete curveFitter;
+        delete baselineSeries;
     }
 
     QwtPlotCurve::CurveStyle style;
@@ -102,6 +445,7 @@ public:
 
     const QwtSymbol *symbol;
     QwtCurveFitter *curveFitter;
+    QwtSeriesData<QPointF> *baselineSeries;
 
     QPen pen;
     QBrush brush;
@@ -110,6 +454,10 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    int filterResolution;
+
+    FitCache fitCache;
 };
 
 /*!
@@ -165,10 +513,17 @@ int QwtPlotCurve::rtti() const
 */
 void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
 {
+    if ( on == testPaintAttribute( attribute ) )
+        return;
+
     if ( on )
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    // the result of the curve fitter depends on the clipping
+    // and filtering of the points
+    invalidateCache();
 }
 
 /*!
@@ -180,6 +535,54 @@ bool QwtPlotCurve::testPaintAttribute( PaintAttribute attribute ) const
     return ( d_data->paintAttributes & attribute );
 }
 
+/*!
+  \brief Set the resolution for filtering points on vector devices
+
+  On paint devices, where QwtPainter doesn't align coordinates to
+  integers ( PDF, SVG ), all points of the curve are painted.
+  For huge datasets this results in documents, that are
+  large and slow to display.
+
+  A resolution > 0 enables filtering by the pixels of a raster device
+  with the given resolution, while the points keep their unrounded
+  positions:
+
+  - Lines\n
+    Consecutive points in the same column ( row ) of pixels are reduced
+    to 4 points ( first, minimum, maximum, last ) like it is done by
+    FilterPointsAggressive for raster devices.
+  - Dots and symbols\n
+    Only the first point of each pixel is painted. As overlapping
+    semi transparent or antialiased points would look different,
+    this is done for opaque points, when antialiasing is disabled, only.
+
+  So the size of the document depends on the resolution and
+  not on the number of points, while the result is identical
+  when being displayed up to this resolution.
+
+  The default setting is 0 ( = no filtering ).
+
+  \param resolution Resolution in dots per Inch (dpi)
+
+  \note Has no effect on devices, where coordinates are aligned
+  \note The Steps and Sticks styles and fitted curves are not filtered
+  \sa filterResolution(), QwtPlotRenderer::setFilterResolution(),
+      QwtPointMapper::setTolerance()
+ */
+void QwtPlotCurve::setFilterResolution( int resolution )
+{
+    d_data->filterResolution = qMax( resolution, 0 );
+}
+
+/*!
+  \return Resolution for filtering points on vector devices
+  \sa setFilterResolution()
+ */
+int QwtPlotCurve::filterResolution() const
+{
+    return d_data->filterResolution;
+}
+
 /*!
   Specify an attribute how to draw the legend icon
 
@@ -351,8 +754,11 @@ const QPen& QwtPlotCurve::pen() const
    last curve point to the baseline. So the curve data has to be sorted
    (ascending or descending).
 
+   For QwtPlotCurve::Lines the area between the curve and
+   a second series of points can be filled instead, see setBaselineSeries().
+
   \param brush New brush
-  \sa brush(), setBaseline(), baseline()
+  \sa brush(), setBaseline(), baseline(), setBaselineSeries()
 */
 void QwtPlotCurve::setBrush( const QBrush &brush )
 {
@@ -530,6 +936,17 @@ void QwtPlotCurve::drawLines( QPainter *painter,
         mapper.setFlag( QwtPointMapper::WeedOutIntermediatePoints,
             testPaintAttribute( FilterPointsAggressive ) );
     }
+    else if ( !doFit )
+    {
+        const double tolerance =
+            qwtFilterTolerance( painter, d_data->filterResolution );
+
+        if ( tolerance > 0.0 )
+        {
+            mapper.setFlag( QwtPointMapper::WeedOutIntermediatePoints, true );
+            mapper.setTolerance( tolerance );
+        }
+    }
 
     mapper.setFlag( QwtPointMapper::WeedOutPoints,
         testPaintAttribute( FilterPoints ) ||
@@ -551,64 +968,203 @@ void QwtPlotCurve::drawLines( QPainter *painter,
     }
     else
     {
-        QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
+        const bool doClip = d_data->paintAttributes & ClipPolygons;
+        const QwtSeriesData<QPointF> *baselineSeries =
+            doFill ? d_data->baselineSeries : NULL;
 
-        if ( doFill )
+        QPolygonF polyline;
+        QPolygonF baselinePoints;
+
+        /*
+          Only the complete curve is cached. Incremental updates
+          ( f.e. QwtPlotDirectPainter ) paint a range of points,
+          that would evict the cached result of the complete curve
+         */
+        const bool isComplete = ( from == 0 )
+            && ( to == static_cast<int>( dataSize() ) - 1 );
+
+        PrivateData::FitCache tmpCache;
+
+        if ( doFit && ( d_data->attributes & FittedInPlotCoordinates ) )
         {
-            if ( doFit )
+            const QwtCurveFitter *fitter = d_data->curveFitter;
+
+            PrivateData::FitCache &cache =
+                isComplete ? d_data->fitCache : tmpCache;
+
+            if ( !cache.matches( from, to, doFill ) )
             {
-                // it might be better to extend and draw the curvePath, but for
-                // the moment we keep an implementation, where we translate the
-                // path back to a polyline.
+                // fitting once, the result is valid for all scale maps
+
+                cache.invalidate();
+
+                qwtFitCurve( fitter, qwtSamplePoints( data(), from, to ),
+                    cache.polygon, cache.path );
 
-                polyline = d_data->curveFitter->fitCurve( polyline );
+                if ( baselineSeries )
+                {
+                    const int numBaselinePoints =
+                        static_cast<int>( baselineSeries->size() );
+
+                    qwtFitCurve( fitter, qwtSamplePoints( baselineSeries,
+                        0, numBaselinePoints - 1 ),
+                        cache.baselinePolygon, cache.baselinePath );
+                }
+
+                cache.from = from;
+                cache.to = to;
+                cache.inPlotCoordinates = true;
+                cache.isFilled = doFill;
+                cache.isValid = true;
             }
 
-            if ( painter->pen().style() != Qt::NoPen )
+            if ( !doFill && !cache.path.isEmpty() )
             {
-                // here we are wasting memory for the filled copy,
-                // do polygon clipping twice etc .. TODO
+                painter->drawPath( qwtMappedPath( xMap, yMap, cache.path ) );
+                return;
+            }
 
-                QPolygonF filled = polyline;
-                fillCurve( painter, xMap, yMap, canvasRect, filled );
-                filled.clear();
+            polyline = qwtMappedCurve( xMap, yMap, cache.polygon, cache.path );
 
-                if ( d_data->paintAttributes & ClipPolygons )
-                    QwtClipper::clipPolygonF( clipRect, polyline, false );
+            if ( baselineSeries )
+            {
+                baselinePoints = qwtMappedCurve( xMap, yMap,
+                    cache.baselinePolygon, cache.baselinePath );
+            }
+        }
+        else if ( doFit )
+        {
+            const QwtCurveFitter *fitter = d_data->curveFitter;
+
+            PrivateData::FitCache &cache =
+                ( isComplete && ( d_data->paintAttributes & CacheFitting ) )
+                ? d_data->fitCache : tmpCache;
+
+            if ( !cache.matches( xMap, yMap, canvasRect, clipRect, from, to, doFill ) )
+            {
+                cache.invalidate();
+
+                QPolygonF points = mapper.toPolygonF( xMap, yMap, data(), from, to );
+
+                if ( doFill )
+                {
+                    // it might be better to extend and draw the curvePath, but for
+                    // the moment we keep an implementation, where we translate the
+                    // path back to a polyline.
+
+                    cache.polygon = fitter->fitCurve( points );
 
-                QwtPainter::drawPolyline( painter, polyline );
+                    if ( baselineSeries && baselineSeries->size() > 0 )
+                    {
+                        points = mapper.toPolygonF( xMap, yMap,
+                            baselineSeries, 0, baselineSeries->size() - 1 );
+
+                        cache.baselinePolygon = fitter->fitCurve( points );
+                    }
+                }
+                else
+                {
+                    if ( doClip )
+                        QwtClipper::clipPolygonF( clipRect, points, false );
+
+                    qwtFitCurve( fitter, points, cache.polygon, cache.path );
+                }
+
+                cache.xMap = xMap;
+                cache.yMap = yMap;
+                cache.canvasRect = canvasRect;
+                cache.clipRect = clipRect;
+                cache.from = from;
+                cache.to = to;
+                cache.inPlotCoordinates = false;
+                cache.isFilled = doFill;
+                cache.isValid = true;
             }
-            else
+
+            if ( !doFill )
             {
-                fillCurve( painter, xMap, yMap, canvasRect, polyline );
+                if ( !cache.path.isEmpty() )
+                    painter->drawPath( cache.path );
+                else
+                    QwtPainter::drawPolyline( painter, cache.polygon );
+
+                return;
             }
+
+            polyline = cache.polygon;
+            baselinePoints = cache.baselinePolygon;
         }
         else
         {
-            if ( testPaintAttribute( ClipPolygons ) )
+            polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
+
+            if ( baselineSeries && baselineSeries->size() > 0 )
             {
-                QwtClipper::clipPolygonF( clipRect, polyline, false );
+                baselinePoints = mapper.toPolygonF( xMap, yMap,
+                    baselineSeries, 0, baselineSeries->size() - 1 );
             }
+        }
+
+        if ( doFill )
+        {
+            const bool doOutline = painter->pen().style() != Qt::NoPen;
+
+            /*
+              The area is closed and clipped as a whole in the same
+              buffer. The outline is taken from the edges of this
+              buffer, that belong to the curve.
+             */
+
+            const int numPoints = polyline.size();
 
-            if ( doFit )
+            if ( baselineSeries )
+                qwtAppendReversed( baselinePoints, polyline );
+            else
+                closePolyline( painter, xMap, yMap, polyline );
+
+            QVector<bool> isOutline;
+
+            if ( doOutline )
             {
-                if ( d_data->curveFitter->mode() == QwtCurveFitter::Path )
-                {
-                    const QPainterPath curvePath =
-                        d_data->curveFitter->fitCurvePath( polyline );
+                isOutline.fill( false, polyline.size() );
+                for ( int i = 1; i < numPoints; i++ )
+                    isOutline[i] = true;
+            }
 
-                    painter->drawPath( curvePath );
+            if ( doClip )
+            {
+                if ( doOutline )
+                {
+                    const QwtOutlineClipper clipper( clipRect );
+                    clipper.clipPolygon( polyline, isOutline );
                 }
                 else
                 {
-                    polyline = d_data->curveFitter->fitCurve( polyline );
-                    QwtPainter::drawPolyline( painter, polyline );
+                    QwtClipper::clipPolygonF( clipRect, polyline, true );
                 }
             }
-            else
+
+            if ( polyline.size() > 2 ) // a line can't be filled
             {
-                QwtPainter::drawPolyline( painter, polyline );
+                // closing it explicitly, so that fillCurve() takes it as it is
+
+                polyline += polyline.first();
+                if ( doOutline )
+                    isOutline += false;
+
+                QPolygonF filled = polyline; // shallow copy
+                fillCurve( painter, xMap, yMap, canvasRect, filled );
             }
+
+            if ( doOutline )
+                qwtDrawOutline( painter, polyline, isOutline );
+        }
+        else
+        {
+            if ( doClip )
+                QwtClipper::clipPolygonF( clipRect, polyline, false );
+
+            QwtPainter::drawPolyline( painter, polyline );
         }
     }
 }
@@ -699,12 +1255,21 @@ void QwtPlotCurve::drawDots( QPainter *painter,
     mapper.setBoundingRect( canvasRect );
     mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
 
-    if ( d_data->paintAttributes & FilterPoints )
+    // merging points is invisible for opaque, aliased points only
+
+    if ( ( color.alpha() == 255 )
+        && !( painter->renderHints() & QPainter::Antialiasing ) )
     {
-        if ( ( color.alpha() == 255 )
-            && !( painter->renderHints() & QPainter::Antialiasing ) )
+        if ( d_data->paintAttributes & FilterPoints )
+            mapper.setFlag( QwtPointMapper::WeedOutPoints, true );
+
+        const double tolerance =
+            qwtFilterTolerance( painter, d_data->filterResolution );
+
+        if ( tolerance > 0.0 )
         {
             mapper.setFlag( QwtPointMapper::WeedOutPoints, true );
+            mapper.setTolerance( tolerance );
         }
     }
 
@@ -869,6 +1434,7 @@ void QwtPlotCurve::setCurveAttribute( CurveAttribute attribute, bool on )
     else
         d_data->attributes &= ~attribute;
 
+    invalidateCache();
     itemChanged();
 }
 
@@ -893,7 +1459,9 @@ bool QwtPlotCurve::testCurveAttribute( CurveAttribute attribute ) const
 
   For situations, where curve fitting is used to improve the performance
   of painting huge series of points it might be better to execute the fitter
-  on the curve points once and to cache the result in the QwtSeriesData object.
+  on the curve points once and to cache the result in the QwtSeriesData object
+  or to enable the CacheFitting paint attribute or the FittedInPlotCoordinates
+  curve attribute.
 
   \param curveFitter() Curve fitter
   \sa Fitted
@@ -903,9 +1471,26 @@ void QwtPlotCurve::setCurveFitter( QwtCurveFitter *curveFitter )
     delete d_data->curveFitter;
     d_data->curveFitter = curveFitter;
 
+    invalidateCache();
     itemChanged();
 }
 
+/*!
+  Invalidate the cached result of the curve fitter
+
+  The cache is invalidated automatically, when the data, the curve fitter
+  or the curve attributes are changed. invalidateCache() is necessary
+  to indicate modifications of the samples, that happen behind the back
+  of the curve ( f.e. raw samples ) or changes of the parameters
+  of the curve fitter.
+
+  \sa CacheFitting, FittedInPlotCoordinates
+*/
+void QwtPlotCurve::invalidateCache()
+{
+    d_data->fitCache.invalidate();
+}
+
 /*!
   Get the curve fitter. If curve fitting is disabled NULL is returned.
 
@@ -927,6 +1512,11 @@ QwtCurveFitter *QwtPlotCurve::curveFitter() const
   \param canvasRect Contents rectangle of the canvas
   \param polygon Polygon - will be modified !
 
+  \note A polygon, where the first and the last point are identical,
+        is an area, that has already been closed and clipped by the caller.
+        drawLines() passes the area between the curve and the baseline
+        ( or the baseline series ) this way.
+
   \sa setBrush(), setBaseline(), setStyle()
 */
 void QwtPlotCurve::fillCurve( QPainter *painter,
@@ -936,7 +1526,12 @@ void QwtPlotCurve::fillCurve( QPainter *painter,
     if ( d_data->brush.style() == Qt::NoBrush )
         return;
 
-    closePolyline( painter, xMap, yMap, polygon );
+    const bool isClosed = ( polygon.count() > 2 )
+        && ( polygon.first() == polygon.last() );
+
+    if ( !isClosed )
+        closePolyline( painter, xMap, yMap, polygon );
+
     if ( polygon.count() <= 2 ) // a line can't be filled
         return;
 
@@ -944,7 +1539,7 @@ void QwtPlotCurve::fillCurve( QPainter *painter,
     if ( !brush.color().isValid() )
         brush.setColor( d_data->pen.color() );
 
-    if ( d_data->paintAttributes & ClipPolygons )
+    if ( !isClosed && ( d_data->paintAttributes & ClipPolygons ) )
     {
         const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
         QwtClipper::clipPolygonF( clipRect, polygon, true );
@@ -1032,7 +1627,31 @@ void QwtPlotCurve::drawSymbols( QPainter *painter, const QwtSymbol &symbol,
     const QRectF clipRect = qwtIntersectedClipRect( canvasRect, painter );
     mapper.setBoundingRect( clipRect );
 
-    const int chunkSize = 500;
+    int chunkSize = 500;
+
+    // like for dots, merging symbols is invisible for opaque,
+    // aliased symbols only
+
+    const bool isOpaque =
+        ( symbol.pen().style() == Qt::NoPen
+            || symbol.pen().color().alpha() == 255 )
+        && ( symbol.brush().style() == Qt::NoBrush
+            || symbol.brush().color().alpha() == 255 );
+
+    double tolerance = 0.0;
+    if ( isOpaque && !( painter->renderHints() & QPainter::Antialiasing ) )
+        tolerance = qwtFilterTolerance( painter, d_data->filterResolution );
+
+    if ( tolerance > 0.0 )
+    {
+        // symbols in the same pixel are merged, what needs
+        // to be done for all points at once
+
+        mapper.setFlag( QwtPointMapper::WeedOutPoints, true );
+        mapper.setTolerance( tolerance );
+
+        chunkSize = qMax( to - from + 1, 1 );
+    }
 
     for ( int i = from; i <= to; i += chunkSize )
     {
@@ -1080,6 +1699,69 @@ double QwtPlotCurve::baseline() const
     return d_data->baseline;
 }
 
+/*!
+  \brief Assign a series of points, that is used as baseline for filling
+
+  Instead of filling the area between the curve and a constant baseline(),
+  the area between the curve and the points of the series is filled.
+  This way a band between 2 curves can be displayed by a single
+  curve, without building a polygon of both series.
+
+  The points of the series are mapped ( and fitted, when the Fitted
+  attribute is enabled ) like the points of the curve. As the fill
+  algorithm simply connects the end points of both series, both
+  need to be sorted in the same direction.
+
+  The curve takes the ownership of the series. Passing NULL restores
+  filling against baseline().
+
+  \param series Baseline series
+  \sa baselineSeries(), setBaselineSamples(), setBrush(), setBaseline()
+  \note Implemented for QwtPlotCurve::Lines only
+*/
+void QwtPlotCurve::setBaselineSeries( QwtSeriesData<QPointF> *series )
+{
+    if ( series != d_data->baselineSeries )
+    {
+        delete d_data->baselineSeries;
+        d_data->baselineSeries = series;
+
+        invalidateCache();
+        itemChanged();
+    }
+}
+
+/*!
+  \return Series used as baseline for filling, or NULL when
+          the curve is filled against baseline()
+  \sa setBaselineSeries(), baseline()
+*/
+const QwtSeriesData<QPointF> *QwtPlotCurve::baselineSeries() const
+{
+    return d_data->baselineSeries;
+}
+
+/*!
+  Initialize the baseline series from an array of points
+
+  \param samples Vector of points
+  \sa setBaselineSeries()
+*/
+void QwtPlotCurve::setBaselineSamples( const QVector<QPointF> &samples )
+{
+    setBaselineSeries( new QwtPointSeriesData( samples ) );
+}
+
+/*!
+  Invalidate the cache of the curve fitter, when the data has changed
+  \sa invalidateCache()
+*/
+void QwtPlotCurve::dataChanged()
+{
+    invalidateCache();
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
   Find the closest curve point for a specific position
 
@@ -126,7 +126,21 @@ public:
           If painting in QwtPlotCurve::Fitted mode is slow it might be better
           to fit the points, before they are passed to QwtPlotCurve.
          */
-        Fitted = 0x02
+        Fitted = 0x02,
+
+        /*!
+          Only in combination with QwtPlotCurve::Fitted.
+
+          The curve fitter operates on the samples in plot coordinates
+          instead of the translated points. The fitted curve is calculated
+          once and cached, so that only the result needs to be mapped,
+          when the scales change.
+
+          \note Parameters of the fitter like the tolerance of
+                 QwtWeedingCurveFitter are in plot coordinates then.
+          \sa invalidateCache()
+         */
+        FittedInPlotCoordinates = 0x04
     };
 
     //! Curve attributes
@@ -223,6 +237,8 @@ public:
           The algorithm is very fast and effective for huge datasets, and can be used
           inside a replot cycle.
 
+          For vector devices ( PDF, SVG ) see setFilterResolution().
+
           \note Implemented for QwtPlotCurve::Lines only
           \note As this algo replaces many small lines by a long one
                 a nasty bug of the raster paint engine ( Qt 4.8, Qt 5.1 - 5.3 )
@@ -230,6 +246,22 @@ public:
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+          Cache the result of the curve fitter and reuse it as long as
+          neither the data, the scale maps nor the geometry of the canvas
+          have changed.
+
+          Only the result for all points of the curve is cached. Painting
+          a range of points ( f.e. QwtPlotDirectPainter ) fits this range
+          without touching the cache.
+
+          \note Modifications of the samples, that bypass setData() or
+                 setSamples() ( f.e. raw samples ) or modifications of the
+                 curve fitter need to be indicated by invalidateCache().
+          \sa Fitted, FittedInPlotCoordinates
+         */
+        CacheFitting = 0x20
     };
 
     //! Paint attributes
@@ -245,6 +277,9 @@ public:
     void setPaintAttribute( PaintAttribute, bool on = true );
     bool testPaintAttribute( PaintAttribute ) const;
 
+    void setFilterResolution( int );
+    int filterResolution() const;
+
     void setLegendAttribute( LegendAttribute, bool on = true );
     bool testLegendAttribute( LegendAttribute ) const;
 
@@ -292,6 +327,11 @@ public:
     void setBaseline( double );
     double baseline() const;
 
+    void setBaselineSeries( QwtSeriesData<QPointF> * );
+    const QwtSeriesData<QPointF> *baselineSeries() const;
+
+    void setBaselineSamples( const QVector<QPointF> & );
+
     void setStyle( CurveStyle style );
     CurveStyle style() const;
 
@@ -301,6 +341,8 @@ public:
     void setCurveFitter( QwtCurveFitter * );
     QwtCurveFitter *curveFitter() const;
 
+    void invalidateCache();
+
     virtual void drawSeries( QPainter *,
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect, int from, int to ) const QWT_OVERRIDE;
@@ -342,6 +384,8 @@ protected:
     void closePolyline( QPainter *,
         const QwtScaleMap &, const QwtScaleMap &, QPolygonF & ) const;
 
+    virtual void dataChanged() QWT_OVERRIDE;
+
 private:
     class PrivateData;
     PrivateData *d_data;
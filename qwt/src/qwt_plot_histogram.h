@@ -32,7 +32,7 @@ template <typename T> class QVector;
         While "image histograms" can be displayed by a QwtPlotCurve there
         is no applicable plot item for a "color histogram" yet.
 
-  \sa QwtPlotBarChart, QwtPlotMultiBarChart
+  \sa QwtPlotBarChart, QwtPlotMultiBarChart, QwtHistogramData
 */
 
 class QWT_EXPORT QwtPlotHistogram:
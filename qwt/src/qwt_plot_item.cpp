@@ -29,7 +29,8 @@ public:
         z( 0.0 ),
         xAxis( QwtPlot::xBottom ),
         yAxis( QwtPlot::yLeft ),
-        legendIconSize( 8, 8 )
+        legendIconSize( 8, 8 ),
+        isLegendIconValid( false )
     {
     }
 
@@ -50,6 +51,10 @@ public:
 
     QwtText title;
     QSize legendIconSize;
+
+    // legendIcon(), until legendChanged() is called
+    bool isLegendIconValid;
+    QwtGraphic legendIcon;
 };
 
 /*!
@@ -204,7 +209,9 @@ void QwtPlotItem::setTitle( const QwtText &title )
     {
         d_data->title = title;
 
-        legendChanged();
+        // the icon is not affected
+        if ( testItemAttribute( QwtPlotItem::Legend ) && d_data->plot )
+            d_data->plot->scheduleLegendUpdate( this );
 #if 0
         itemChanged();
 #endif
@@ -321,6 +328,8 @@ void QwtPlotItem::setRenderHint( RenderHint hint, bool on )
         else
             d_data->renderHints &= ~hint;
 
+        // icons might be antialiased
+        legendChanged();
         itemChanged();
     }
 }
@@ -396,11 +405,17 @@ QSize QwtPlotItem::legendIconSize() const
 
    The default implementation returns an invalid icon
 
+   The icon for the first entry is cached by legendData(). The cache
+   is invalidated by legendChanged(), QwtPlot::updateLegend() or
+   invalidateLegendIcon(). So implementations of legendIcon(), that
+   depend on attributes of derived classes, need to call legendChanged(),
+   when those attributes have been modified.
+
    \param index Index of the legend entry
                 ( usually there is only one )
    \param size Icon size
 
-   \sa setLegendIconSize(), legendData()
+   \sa setLegendIconSize(), legendData(), invalidateLegendIcon()
  */
 QwtGraphic QwtPlotItem::legendIcon(
     int index, const QSizeF &size ) const
@@ -411,6 +426,21 @@ QwtGraphic QwtPlotItem::legendIcon(
     return QwtGraphic();
 }
 
+/*!
+   \brief Invalidate the icon, that is cached by legendData()
+
+   The icon is created again by legendIcon(), when legendData()
+   is called the next time. In opposite to legendChanged() no
+   update of the legend is scheduled.
+
+   \sa legendIcon(), legendChanged(), QwtPlot::updateLegend()
+ */
+void QwtPlotItem::invalidateLegendIcon() const
+{
+    d_data->isLegendIconValid = false;
+    d_data->legendIcon = QwtGraphic();
+}
+
 /*!
    \brief Return a default icon from a brush
 
@@ -488,13 +518,25 @@ void QwtPlotItem::itemChanged()
 }
 
 /*!
-   Update the legend of the parent plot.
+   \brief Update the legend of the parent plot.
+
+   legendChanged() has to be called, when attributes have changed, that
+   affect the representation of the item on the legend. The icon is
+   created again, when legendData() is called the next time.
+
+   The legend is not updated immediately: all updates are collected and
+   processed once, when control returns to the event loop or with the next
+   replot. So changing several attributes of an item in a row results in
+   one update only.
+
    \sa QwtPlot::updateLegend(), itemChanged()
 */
 void QwtPlotItem::legendChanged()
 {
+    invalidateLegendIcon();
+
     if ( testItemAttribute( QwtPlotItem::Legend ) && d_data->plot )
-        d_data->plot->updateLegend( this );
+        d_data->plot->scheduleLegendUpdate( this );
 }
 
 /*!
@@ -621,7 +663,8 @@ void QwtPlotItem::getCanvasMarginHint( const QwtScaleMap &xMap,
    by the receiver that acts as the legend.
 
    The default implementation returns one entry with
-   the title() of the item and the legendIcon().
+   the title() of the item and the legendIcon(). The icon is
+   cached until legendChanged() is called.
 
    \return Data, that is needed to represent the item on the legend
    \sa title(), legendIcon(), QwtLegend, QwtPlotLegendItem
@@ -636,7 +679,13 @@ QList<QwtLegendData> QwtPlotItem::legendData() const
     data.setValue( QwtLegendData::TitleRole,
         QVariant::fromValue( label ));
 
-    const QwtGraphic graphic = legendIcon( 0, legendIconSize() );
+    if ( !d_data->isLegendIconValid )
+    {
+        d_data->legendIcon = legendIcon( 0, legendIconSize() );
+        d_data->isLegendIconValid = true;
+    }
+
+    const QwtGraphic &graphic = d_data->legendIcon;
     if ( !graphic.isNull() )
     {
         data.setValue( QwtLegendData::IconRole,
@@ -127,6 +127,9 @@ public:
         //! For QwtPlotVectorField
         Rtti_PlotVectorField,
 
+        //! For QwtPlotWaterfall
+        Rtti_PlotWaterfall,
+
         /*!
            Values >= Rtti_PlotUserItem are reserved for plot items
            not implemented in the Qwt library.
@@ -292,6 +295,7 @@ public:
     virtual QList<QwtLegendData> legendData() const;
 
     virtual QwtGraphic legendIcon( int index, const QSizeF  & ) const;
+    void invalidateLegendIcon() const;
 
 protected:
     QwtGraphic defaultIcon( const QBrush &, const QSizeF & ) const;
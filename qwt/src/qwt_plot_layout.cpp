@@ -20,9 +20,11 @@ class QwtPlotLayout::LayoutData
 {
 public:
     void init( const QwtPlot *, const QRectF &rect );
+    bool isEqual( const LayoutData & ) const;
 
     struct t_legendData
     {
+        bool isEnabled;
         int frameWidth;
         int hScrollExtent;
         int vScrollExtent;
@@ -46,6 +48,7 @@ public:
         bool isEnabled;
         const QwtScaleWidget *scaleWidget;
         QFont scaleFont;
+        QwtText scaleTitle;
         int start;
         int end;
         int baseLineOffset;
@@ -67,8 +70,16 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
 {
     // legend
 
+    legend.isEnabled = false;
+    legend.frameWidth = 0;
+    legend.hScrollExtent = 0;
+    legend.vScrollExtent = 0;
+    legend.hint = QSize();
+
     if ( plot->legend() )
     {
+        legend.isEnabled = !plot->legend()->isEmpty();
+
         legend.frameWidth = plot->legend()->frameWidth();
         legend.hScrollExtent =
             plot->legend()->scrollExtent( Qt::Horizontal );
@@ -91,7 +102,9 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
     title.frameWidth = 0;
     title.text = QwtText();
 
-    if ( plot->titleLabel() )
+    // the labels are created on demand: only when having a text
+
+    if ( !plot->title().isEmpty() )
     {
         const QwtTextLabel *label = plot->titleLabel();
         title.text = label->text();
@@ -106,7 +119,7 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
     footer.frameWidth = 0;
     footer.text = QwtText();
 
-    if ( plot->footerLabel() )
+    if ( !plot->footer().isEmpty() )
     {
         const QwtTextLabel *label = plot->footerLabel();
         footer.text = label->text();
@@ -129,6 +142,7 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
             scale[axis].scaleWidget = scaleWidget;
 
             scale[axis].scaleFont = scaleWidget->font();
+            scale[axis].scaleTitle = scaleWidget->title();
 
             scale[axis].start = scaleWidget->startBorderDist();
             scale[axis].end = scaleWidget->endBorderDist();
@@ -154,6 +168,9 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         else
         {
             scale[axis].isEnabled = false;
+            scale[axis].scaleWidget = NULL;
+            scale[axis].scaleFont = QFont();
+            scale[axis].scaleTitle = QwtText();
             scale[axis].start = 0;
             scale[axis].end = 0;
             scale[axis].baseLineOffset = 0;
@@ -172,10 +189,62 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
     canvas.contentsMargins[ QwtPlot::xBottom ] = m.bottom();
 }
 
+/*
+  Check if all layout relevant data is the same
+*/
+bool QwtPlotLayout::LayoutData::isEqual( const LayoutData &other ) const
+{
+    if ( legend.isEnabled != other.legend.isEnabled
+        || legend.frameWidth != other.legend.frameWidth
+        || legend.hScrollExtent != other.legend.hScrollExtent
+        || legend.vScrollExtent != other.legend.vScrollExtent
+        || legend.hint != other.legend.hint )
+    {
+        return false;
+    }
+
+    if ( title.frameWidth != other.title.frameWidth
+        || title.text != other.title.text )
+    {
+        return false;
+    }
+
+    if ( footer.frameWidth != other.footer.frameWidth
+        || footer.text != other.footer.text )
+    {
+        return false;
+    }
+
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+    {
+        const t_scaleData &s1 = scale[axis];
+        const t_scaleData &s2 = other.scale[axis];
+
+        if ( s1.isEnabled != s2.isEnabled
+            || s1.scaleWidget != s2.scaleWidget
+            || s1.start != s2.start
+            || s1.end != s2.end
+            || s1.baseLineOffset != s2.baseLineOffset
+            || s1.tickOffset != s2.tickOffset
+            || s1.dimWithoutTitle != s2.dimWithoutTitle
+            || s1.scaleFont != s2.scaleFont
+            || s1.scaleTitle != s2.scaleTitle )
+        {
+            return false;
+        }
+
+        if ( canvas.contentsMargins[axis] != other.canvas.contentsMargins[axis] )
+            return false;
+    }
+
+    return true;
+}
+
 class QwtPlotLayout::PrivateData
 {
 public:
     PrivateData():
+        isLayoutValid( false ),
         spacing( 5 )
     {
     }
@@ -188,6 +257,11 @@ public:
 
     QwtPlotLayout::LayoutData layoutData;
 
+    // input of the last activate()
+    bool isLayoutValid;
+    QRectF layoutRect;
+    QwtPlotLayout::Options layoutOptions;
+
     QwtPlot::LegendPosition legendPos;
     double legendRatio;
     unsigned int spacing;
@@ -241,6 +315,8 @@ void QwtPlotLayout::setCanvasMargin( int margin, int axis )
     }
     else if ( axis >= 0 && axis < QwtPlot::axisCnt )
         d_data->canvasMargin[axis] = margin;
+
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -266,6 +342,8 @@ void QwtPlotLayout::setAlignCanvasToScales( bool on )
 {
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->alignCanvasToScales[axis] = on;
+
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -289,6 +367,8 @@ void QwtPlotLayout::setAlignCanvasToScale( int axisId, bool on )
 {
     if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
         d_data->alignCanvasToScales[axisId] = on;
+
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -318,6 +398,7 @@ bool QwtPlotLayout::alignCanvasToScale( int axisId ) const
 void QwtPlotLayout::setSpacing( int spacing )
 {
     d_data->spacing = qMax( 0, spacing );
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -366,6 +447,8 @@ void QwtPlotLayout::setLegendPosition( QwtPlot::LegendPosition pos, double ratio
         default:
             break;
     }
+
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -425,6 +508,7 @@ double QwtPlotLayout::legendRatio() const
 void QwtPlotLayout::setTitleRect( const QRectF &rect )
 {
     d_data->titleRect = rect;
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -447,6 +531,7 @@ QRectF QwtPlotLayout::titleRect() const
 void QwtPlotLayout::setFooterRect( const QRectF &rect )
 {
     d_data->footerRect = rect;
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -471,6 +556,7 @@ QRectF QwtPlotLayout::footerRect() const
 void QwtPlotLayout::setLegendRect( const QRectF &rect )
 {
     d_data->legendRect = rect;
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -497,6 +583,8 @@ void QwtPlotLayout::setScaleRect( int axis, const QRectF &rect )
 {
     if ( axis >= 0 && axis < QwtPlot::axisCnt )
         d_data->scaleRect[axis] = rect;
+
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -525,6 +613,7 @@ QRectF QwtPlotLayout::scaleRect( int axis ) const
 void QwtPlotLayout::setCanvasRect( const QRectF &rect )
 {
     d_data->canvasRect = rect;
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -538,6 +627,10 @@ QRectF QwtPlotLayout::canvasRect() const
 
 /*!
   Invalidate the geometry of all components.
+
+  The next activate() recalculates the layout, even when
+  the parameters of the plot components have not changed.
+
   \sa activate()
 */
 void QwtPlotLayout::invalidate()
@@ -547,6 +640,8 @@ void QwtPlotLayout::invalidate()
 
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->scaleRect[axis] = QRect();
+
+    d_data->isLayoutValid = false;
 }
 
 /*!
@@ -663,8 +758,8 @@ QSize QwtPlotLayout::minimumSizeHint( const QwtPlot *plot ) const
     h += qMax( ch, minCanvasSize.height() );
 
     const QwtTextLabel *labels[2];
-    labels[0] = plot->titleLabel();
-    labels[1] = plot->footerLabel();
+    labels[0] = plot->title().isEmpty() ? NULL : plot->titleLabel();
+    labels[1] = plot->footer().isEmpty() ? NULL : plot->footerLabel();
 
     for ( int i = 0; i < 2; i++ )
     {
@@ -1260,6 +1355,12 @@ void QwtPlotLayout::alignScales( Options options,
 /*!
   \brief Recalculate the geometry of all components.
 
+  All parameters, that are relevant for the layout are extracted
+  from the plot and compared with those of the previous call. When
+  nothing has changed - f.e. when only tick labels have been replaced,
+  without changing the extent of the scales - the geometries of the
+  previous calculation are kept.
+
   \param plot Plot to be layout
   \param plotRect Rectangle where to place the components
   \param options Layout options
@@ -1270,17 +1371,27 @@ void QwtPlotLayout::alignScales( Options options,
 void QwtPlotLayout::activate( const QwtPlot *plot,
     const QRectF &plotRect, Options options )
 {
-    invalidate();
-
-    QRectF rect( plotRect );  // undistributed rest of the plot rect
-
     // We extract all layout relevant parameters from the widgets,
     // and save them to d_data->layoutData.
 
-    d_data->layoutData.init( plot, rect );
+    LayoutData layoutData;
+    layoutData.init( plot, plotRect );
+
+    if ( d_data->isLayoutValid && options == d_data->layoutOptions
+        && plotRect == d_data->layoutRect
+        && layoutData.isEqual( d_data->layoutData ) )
+    {
+        // nothing has changed since the previous layout
+        return;
+    }
+
+    invalidate();
+
+    d_data->layoutData = layoutData;
 
-    if ( !( options & IgnoreLegend )
-        && plot->legend() && !plot->legend()->isEmpty() )
+    QRectF rect( plotRect );  // undistributed rest of the plot rect
+
+    if ( !( options & IgnoreLegend ) && d_data->layoutData.legend.isEnabled )
     {
         d_data->legendRect = layoutLegend( options, rect );
 
@@ -1439,4 +1550,8 @@ void QwtPlotLayout::activate( const QwtPlot *plot,
 
         d_data->legendRect = alignLegend( d_data->canvasRect, d_data->legendRect );
     }
+
+    d_data->layoutRect = plotRect;
+    d_data->layoutOptions = options;
+    d_data->isLayoutValid = true;
 }
@@ -16,6 +16,7 @@
 #include "qwt_math.h"
 
 #include <qmap.h>
+#include <qvector.h>
 
 inline static bool qwtIsIncreasing(
     const QwtScaleMap &map, const QVector<double> &values )
@@ -32,6 +33,182 @@ inline static bool qwtIsIncreasing(
     return !isInverting;
 }
 
+namespace
+{
+    class BarRect
+    {
+    public:
+        int valueIndex;
+        QwtColumnRect rect;
+    };
+
+    /*
+      The bars of a sample are calculated one by one, so that
+      they can be painted without collecting them in a buffer
+     */
+    class SampleBars
+    {
+    public:
+        SampleBars( bool stacked, Qt::Orientation orientation,
+                double baseline, const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+                double sampleWidth, const QwtSetSample &sample ):
+            d_stacked( stacked ),
+            d_orientation( orientation ),
+            d_set( sample.set ),
+            d_index( 0 )
+        {
+            if ( d_set.isEmpty() )
+                return;
+
+            const QwtScaleMap &posMap =
+                ( orientation == Qt::Vertical ) ? xMap : yMap;
+
+            d_valueMap = ( orientation == Qt::Vertical ) ? &yMap : &xMap;
+
+            const double pos1 = posMap.transform( sample.value ) - 0.5 * sampleWidth;
+
+            if ( stacked )
+            {
+                d_sum = baseline;
+                d_borderFlags = QwtInterval::IncludeBorders;
+                d_increasing = qwtIsIncreasing( *d_valueMap, d_set );
+
+                const QwtInterval interval =
+                    QwtInterval( pos1, pos1 + sampleWidth ).normalized();
+
+                if ( orientation == Qt::Vertical )
+                {
+                    d_bar.rect.direction = d_increasing ?
+                        QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
+
+                    d_bar.rect.hInterval = interval;
+                }
+                else
+                {
+                    d_bar.rect.direction = d_increasing ?
+                        QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
+
+                    d_bar.rect.vInterval = interval;
+                }
+            }
+            else
+            {
+                d_base = d_valueMap->transform( baseline );
+                d_pos1 = pos1;
+                d_barWidth = sampleWidth / d_set.size();
+            }
+        }
+
+        inline bool next( BarRect &bar )
+        {
+            return d_stacked ? nextStacked( bar ) : nextGrouped( bar );
+        }
+
+    private:
+        bool nextGrouped( BarRect &bar )
+        {
+            if ( d_index >= d_set.size() )
+                return false;
+
+            const int i = d_index++;
+
+            const double p1 = d_pos1 + i * d_barWidth;
+            const double p2 = p1 + d_barWidth;
+
+            const double value = d_valueMap->transform( d_set[i] );
+
+            QwtColumnRect &barRect = bar.rect;
+
+            if ( d_orientation == Qt::Vertical )
+            {
+                barRect.direction = ( d_base < value ) ?
+                    QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
+
+                barRect.hInterval = QwtInterval( p1, p2 ).normalized();
+                if ( i != 0 )
+                    barRect.hInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
+
+                barRect.vInterval = QwtInterval( d_base, value ).normalized();
+            }
+            else
+            {
+                barRect.direction = ( d_base < value ) ?
+                    QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
+
+                barRect.hInterval = QwtInterval( d_base, value ).normalized();
+
+                barRect.vInterval = QwtInterval( p1, p2 );
+                if ( i != 0 )
+                    barRect.vInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
+            }
+
+            bar.valueIndex = i;
+            return true;
+        }
+
+        bool nextStacked( BarRect &bar )
+        {
+            while ( d_index < d_set.size() )
+            {
+                const int i = d_index++;
+
+                const double si = d_set[ i ];
+                if ( si == 0.0 )
+                    continue;
+
+                const double v1 = d_valueMap->transform( d_sum );
+                const double v2 = d_valueMap->transform( d_sum + si );
+
+                if ( ( v2 > v1 ) != d_increasing )
+                {
+                    // stacked bars need to be in the same direction
+                    continue;
+                }
+
+                QwtInterval interval = QwtInterval( v1, v2 ).normalized();
+                interval.setBorderFlags( d_borderFlags );
+
+                if ( d_orientation == Qt::Vertical )
+                    d_bar.rect.vInterval = interval;
+                else
+                    d_bar.rect.hInterval = interval;
+
+                d_bar.valueIndex = i;
+                bar = d_bar;
+
+                d_sum += si;
+
+                if ( d_increasing )
+                    d_borderFlags = QwtInterval::ExcludeMinimum;
+                else
+                    d_borderFlags = QwtInterval::ExcludeMaximum;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        const bool d_stacked;
+        const Qt::Orientation d_orientation;
+        const QVector<double> &d_set;
+        const QwtScaleMap *d_valueMap;
+
+        int d_index;
+
+        // grouped bars
+        double d_base;
+        double d_pos1;
+        double d_barWidth;
+
+        // stacked bars
+        BarRect d_bar;
+        bool d_increasing;
+        double d_sum;
+        QwtInterval::BorderFlag d_borderFlags;
+    };
+}
+
 class QwtPlotMultiBarChart::PrivateData
 {
 public:
@@ -390,10 +567,75 @@ void QwtPlotMultiBarChart::drawSeries( QPainter *painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    if ( testPaintAttribute( QwtPlotAbstractBarChart::AggregateBars ) )
+    {
+        // one series of columns for each value index
+
+        QVector< QVector<QwtColumnRect> > columns;
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtSetSample sample = this->sample( i );
+            if ( sample.set.size() <= 0 )
+                continue;
+
+            double sampleW;
+            if ( orientation() == Qt::Horizontal )
+            {
+                sampleW = sampleWidth( yMap, canvasRect.height(),
+                    interval.width(), sample.value );
+            }
+            else
+            {
+                sampleW = sampleWidth( xMap, canvasRect.width(),
+                    interval.width(), sample.value );
+            }
+
+            SampleBars bars( d_data->style == Stacked, orientation(),
+                baseline(), xMap, yMap, sampleW, sample );
+
+            BarRect bar;
+            while ( bars.next( bar ) )
+            {
+                const QwtColumnSymbol *specialSym =
+                    specialSymbol( i, bar.valueIndex );
+
+                if ( specialSym )
+                {
+                    specialSym->draw( painter, bar.rect );
+                    delete specialSym;
+                }
+                else
+                {
+                    if ( bar.valueIndex >= columns.size() )
+                        columns.resize( bar.valueIndex + 1 );
+
+                    columns[ bar.valueIndex ] += bar.rect;
+                }
+            }
+        }
+
+        // we build a temporary default symbol
+        QwtColumnSymbol defaultSymbol( QwtColumnSymbol::Box );
+        defaultSymbol.setLineWidth( 1 );
+        defaultSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+        for ( int valueIndex = 0; valueIndex < columns.size(); valueIndex++ )
+        {
+            const QwtColumnSymbol *sym = symbol( valueIndex );
+            if ( sym == NULL )
+                sym = &defaultSymbol;
+
+            drawColumns( painter, canvasRect, sym, columns[ valueIndex ] );
+        }
+    }
+    else
     {
-        drawSample( painter, xMap, yMap,
-            canvasRect, interval, i, sample( i ) );
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
@@ -465,64 +707,12 @@ void QwtPlotMultiBarChart::drawGroupedBars( QPainter *painter,
 {
     Q_UNUSED( canvasRect );
 
-    const int numBars = sample.set.size();
-    if ( numBars == 0 )
-        return;
+    SampleBars bars( false, orientation(), baseline(),
+        xMap, yMap, sampleWidth, sample );
 
-    if ( orientation() == Qt::Vertical )
-    {
-        const double barWidth = sampleWidth / numBars;
-
-        const double y1 = yMap.transform( baseline() );
-        const double x0 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            const double x1 = x0 + i * barWidth;
-            const double x2 = x1 + barWidth;
-
-            const double y2 = yMap.transform( sample.set[i] );
-
-            QwtColumnRect barRect;
-            barRect.direction = ( y1 < y2 ) ?
-                QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
-
-            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
-            if ( i != 0 )
-                barRect.hInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
-
-            barRect.vInterval = QwtInterval( y1, y2 ).normalized();
-
-            drawBar( painter, index, i, barRect );
-        }
-    }
-    else
-    {
-        const double barHeight = sampleWidth / numBars;
-
-        const double x1 = xMap.transform( baseline() );
-        const double y0 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            double y1 = y0 + i * barHeight;
-            double y2 = y1 + barHeight;
-
-            double x2 = xMap.transform( sample.set[i] );
-
-            QwtColumnRect barRect;
-            barRect.direction = x1 < x2 ?
-                QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
-
-            barRect.hInterval = QwtInterval( x1, x2 ).normalized();
-
-            barRect.vInterval = QwtInterval( y1, y2 );
-            if ( i != 0 )
-                barRect.vInterval.setBorderFlags( QwtInterval::ExcludeMinimum );
-
-            drawBar( painter, index, i, barRect );
-        }
-    }
+    BarRect bar;
+    while ( bars.next( bar ) )
+        drawBar( painter, index, bar.valueIndex, bar.rect );
 }
 
 /*!
@@ -545,97 +735,12 @@ void QwtPlotMultiBarChart::drawStackedBars( QPainter *painter,
 {
     Q_UNUSED( canvasRect ); // clipping the bars ?
 
-    const int numBars = sample.set.size();
-    if ( numBars == 0 )
-        return;
-
-    QwtInterval::BorderFlag borderFlags = QwtInterval::IncludeBorders;
-
-    if ( orientation() == Qt::Vertical )
-    {
-        const double x1 = xMap.transform( sample.value ) - 0.5 * sampleWidth;
-        const double x2 = x1 + sampleWidth;
-
-        const bool increasing = qwtIsIncreasing( yMap, sample.set );
+    SampleBars bars( true, orientation(), baseline(),
+        xMap, yMap, sampleWidth, sample );
 
-        QwtColumnRect bar;
-        bar.direction = increasing ?
-            QwtColumnRect::TopToBottom : QwtColumnRect::BottomToTop;
-
-        bar.hInterval = QwtInterval( x1, x2 ).normalized();
-
-        double sum = baseline();
-
-        for ( int i = 0; i < numBars; i++ )
-        {
-            const double si = sample.set[ i ];
-            if ( si == 0.0 )
-                continue;
-
-            const double y1 = yMap.transform( sum );
-            const double y2 = yMap.transform( sum + si );
-
-            if ( ( y2 > y1 ) != increasing )
-            {
-                // stacked bars need to be in the same direction
-                continue;
-            }
-
-            bar.vInterval = QwtInterval( y1, y2 ).normalized();
-            bar.vInterval.setBorderFlags( borderFlags );
-
-            drawBar( painter, index, i, bar );
-
-            sum += si;
-
-            if ( increasing )
-                borderFlags = QwtInterval::ExcludeMinimum;
-            else
-                borderFlags = QwtInterval::ExcludeMaximum;
-        }
-    }
-    else
-    {
-        const double y1 = yMap.transform( sample.value ) - 0.5 * sampleWidth;
-        const double y2 = y1 + sampleWidth;
-
-        const bool increasing = qwtIsIncreasing( xMap, sample.set );
-
-        QwtColumnRect bar;
-        bar.direction = increasing ?
-            QwtColumnRect::LeftToRight : QwtColumnRect::RightToLeft;
-        bar.vInterval = QwtInterval( y1, y2 ).normalized();
-
-        double sum = baseline();
-
-        for ( int i = 0; i < sample.set.size(); i++ )
-        {
-            const double si = sample.set[ i ];
-            if ( si == 0.0 )
-                continue;
-
-            const double x1 = xMap.transform( sum );
-            const double x2 = xMap.transform( sum + si );
-
-            if ( ( x2 > x1 ) != increasing )
-            {
-                // stacked bars need to be in the same direction
-                continue;
-            }
-
-            bar.hInterval = QwtInterval( x1, x2 ).normalized();
-            bar.hInterval.setBorderFlags( borderFlags );
-
-            drawBar( painter, index, i, bar );
-
-            sum += si;
-
-            if ( increasing )
-                borderFlags = QwtInterval::ExcludeMinimum;
-            else
-                borderFlags = QwtInterval::ExcludeMaximum;
-        }
-    }
+    BarRect bar;
+    while ( bars.next( bar ) )
+        drawBar( painter, index, bar.valueIndex, bar.rect );
 }
 
 /*!
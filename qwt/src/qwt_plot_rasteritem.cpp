@@ -631,6 +631,16 @@ void QwtPlotRasterItem::draw( QPainter *painter,
     qwtTransformMaps( painter->transform(), xMap, yMap, xxMap, yyMap );
 
     QRectF paintRect = painter->transform().mapRect( canvasRect );
+
+    if ( painter->hasClipping() )
+    {
+        // f.e. when rendering tiles: only the visible part is composed
+
+        paintRect &= painter->transform().mapRect( painter->clipBoundingRect() );
+        if ( paintRect.isEmpty() )
+            return;
+    }
+
     QRectF area = QwtScaleMap::invTransform( xxMap, yyMap, paintRect );
 
     const QRectF br = boundingRect();
@@ -9,6 +9,7 @@
 
 #include "qwt_plot_renderer.h"
 #include "qwt_plot.h"
+#include "qwt_plot_curve.h"
 #include "qwt_painter.h"
 #include "qwt_plot_layout.h"
 #include "qwt_abstract_legend.h"
@@ -27,6 +28,10 @@
 #include <qimagewriter.h>
 #include <qvariant.h>
 #include <qmargins.h>
+#include <qfile.h>
+#include <qdatastream.h>
+#include <qbytearray.h>
+#include <qvector.h>
 
 #ifndef QWT_NO_SVG
 #ifdef QT_SVG_LIB
@@ -121,17 +126,282 @@ static inline QFont qwtResolvedFont( const QWidget *widget )
     return font;
 }
 
+static inline bool qwtIsTiffFormat( const QString &format )
+{
+    return format == QLatin1String( "tif" ) || format == QLatin1String( "tiff" );
+}
+
+/*
+    PackBits compression of one row, like it is defined
+    in the TIFF 6.0 specification
+ */
+static void qwtPackBits( const uchar *data, int size, QByteArray &packed )
+{
+    int i = 0;
+    while ( i < size )
+    {
+        int run = 1;
+        while ( i + run < size && run < 128 && data[i + run] == data[i] )
+            run++;
+
+        if ( run > 1 )
+        {
+            packed += char( 1 - run );
+            packed += char( data[i] );
+
+            i += run;
+        }
+        else
+        {
+            // literal bytes up to the beginning of the next run
+
+            int j = i + 1;
+            while ( j < size && j - i < 128
+                && !( j + 1 < size && data[j] == data[j + 1] ) )
+            {
+                j++;
+            }
+
+            packed += char( j - i - 1 );
+            packed.append( reinterpret_cast< const char * >( data + i ), j - i );
+
+            i = j;
+        }
+    }
+}
+
+namespace
+{
+    /*
+        A writer for baseline TIFF files ( RGB, 8 bits per sample ),
+        that writes the image strip by strip. So only one strip
+        needs to be in memory.
+     */
+    class TiffWriter
+    {
+    public:
+        explicit TiffWriter( const QString &fileName ):
+            d_file( fileName ),
+            d_resolution( 0 ),
+            d_rowsPerStrip( 0 ),
+            d_isOk( false )
+        {
+        }
+
+        bool open( const QSize &size, int resolution, int rowsPerStrip )
+        {
+            if ( !d_file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+                return false;
+
+            d_isOk = true;
+
+            d_size = size;
+            d_resolution = resolution;
+            d_rowsPerStrip = rowsPerStrip;
+
+            d_stream.setDevice( &d_file );
+            d_stream.setByteOrder( QDataStream::LittleEndian );
+
+            // header, the offset of the directory is written in close()
+            d_stream << quint8( 'I' ) << quint8( 'I' )
+                << quint16( 42 ) << quint32( 0 );
+
+            return checkStatus();
+        }
+
+        bool writeStrip( const QImage &image )
+        {
+            if ( !d_isOk )
+                return false;
+
+            const int w = d_size.width();
+
+            QByteArray row( 3 * w, 0 );
+            uchar *rowData = reinterpret_cast< uchar * >( row.data() );
+
+            QByteArray packed;
+            packed.reserve( 4 * w );
+
+            for ( int y = 0; y < image.height(); y++ )
+            {
+                const QRgb *line =
+                    reinterpret_cast< const QRgb * >( image.constScanLine( y ) );
+
+                for ( int x = 0; x < w; x++ )
+                {
+                    rowData[3 * x] = qRed( line[x] );
+                    rowData[3 * x + 1] = qGreen( line[x] );
+                    rowData[3 * x + 2] = qBlue( line[x] );
+                }
+
+                // each row has to be packed separately
+                qwtPackBits( rowData, row.size(), packed );
+            }
+
+            // the strips and the directory behind them need to
+            // be addressable by 32 bit offsets
+
+            const qint64 directorySize =
+                directoryBytes( d_stripOffsets.size() + 1 );
+
+            if ( !isAddressable( packed.size() + directorySize ) )
+            {
+                d_isOk = false;
+                return false;
+            }
+
+            d_stripOffsets += quint32( d_file.pos() );
+            d_stripByteCounts += quint32( packed.size() );
+
+            d_stream.writeRawData( packed.constData(), packed.size() );
+
+            return checkStatus();
+        }
+
+        bool close()
+        {
+            const int numStrips = d_stripOffsets.size();
+
+            if ( !d_isOk || !isAddressable( directoryBytes( numStrips ) ) )
+            {
+                // no incomplete files
+                d_file.remove();
+                return false;
+            }
+
+            if ( d_file.pos() % 2 )
+                d_stream << quint8( 0 );
+
+            const quint32 bitsPerSampleOffset = quint32( d_file.pos() );
+            d_stream << quint16( 8 ) << quint16( 8 ) << quint16( 8 );
+
+            d_stream << quint16( 0 ); // padding
+
+            const quint32 resolutionOffset = quint32( d_file.pos() );
+            d_stream << quint32( d_resolution ) << quint32( 1 );
+
+            quint32 stripOffsets = d_stripOffsets.value( 0 );
+            quint32 stripByteCounts = d_stripByteCounts.value( 0 );
+
+            if ( numStrips > 1 )
+            {
+                stripOffsets = quint32( d_file.pos() );
+                for ( int i = 0; i < numStrips; i++ )
+                    d_stream << d_stripOffsets[i];
+
+                stripByteCounts = quint32( d_file.pos() );
+                for ( int i = 0; i < numStrips; i++ )
+                    d_stream << d_stripByteCounts[i];
+            }
+
+            const quint32 directoryOffset = quint32( d_file.pos() );
+
+            d_stream << quint16( 13 );
+
+            writeEntry( 256, Long, 1, d_size.width() ); // ImageWidth
+            writeEntry( 257, Long, 1, d_size.height() ); // ImageLength
+            writeEntry( 258, Short, 3, bitsPerSampleOffset ); // BitsPerSample
+            writeEntry( 259, Short, 1, 32773 ); // Compression: PackBits
+            writeEntry( 262, Short, 1, 2 ); // PhotometricInterpretation: RGB
+            writeEntry( 273, Long, numStrips, stripOffsets ); // StripOffsets
+            writeEntry( 277, Short, 1, 3 ); // SamplesPerPixel
+            writeEntry( 278, Long, 1, d_rowsPerStrip ); // RowsPerStrip
+            writeEntry( 279, Long, numStrips, stripByteCounts ); // StripByteCounts
+            writeEntry( 282, Rational, 1, resolutionOffset ); // XResolution
+            writeEntry( 283, Rational, 1, resolutionOffset ); // YResolution
+            writeEntry( 284, Short, 1, 1 ); // PlanarConfiguration: chunky
+            writeEntry( 296, Short, 1, 2 ); // ResolutionUnit: inch
+
+            d_stream << quint32( 0 ); // no further directories
+
+            d_file.seek( 4 );
+            d_stream << directoryOffset;
+
+            if ( !checkStatus() )
+            {
+                d_file.remove();
+                return false;
+            }
+
+            d_file.close();
+            return d_file.error() == QFile::NoError;
+        }
+
+    private:
+        enum FieldType
+        {
+            Short = 3,
+            Long = 4,
+            Rational = 5
+        };
+
+        bool checkStatus()
+        {
+            if ( d_stream.status() != QDataStream::Ok )
+                d_isOk = false;
+
+            return d_isOk;
+        }
+
+        static qint64 directoryBytes( int numStrips )
+        {
+            // padding, bits per sample, resolution,
+            // strip offsets and byte counts, directory
+
+            return 1 + 8 + 8 + 8 * qint64( numStrips ) + 2 + 13 * 12 + 4;
+        }
+
+        bool isAddressable( qint64 numBytes ) const
+        {
+            return d_file.pos() + numBytes <= qint64( 0xffffffff );
+        }
+
+        void writeEntry( quint16 tag, FieldType type,
+            quint32 count, quint32 value )
+        {
+            d_stream << tag << quint16( type ) << count;
+
+            if ( type == Short && count == 1 )
+            {
+                // values of type SHORT are left justified
+                d_stream << quint16( value ) << quint16( 0 );
+            }
+            else
+            {
+                d_stream << value;
+            }
+        }
+
+        QFile d_file;
+        QDataStream d_stream;
+
+        QSize d_size;
+        int d_resolution;
+        int d_rowsPerStrip;
+
+        QVector< quint32 > d_stripOffsets;
+        QVector< quint32 > d_stripByteCounts;
+
+        bool d_isOk;
+    };
+}
+
 class QwtPlotRenderer::PrivateData
 {
 public:
     PrivateData():
         discardFlags( QwtPlotRenderer::DiscardNone ),
-        layoutFlags( QwtPlotRenderer::DefaultLayout )
+        layoutFlags( QwtPlotRenderer::DefaultLayout ),
+        bandHeight( 0 ),
+        filterResolution( 0 )
     {
     }
 
     QwtPlotRenderer::DiscardFlags discardFlags;
     QwtPlotRenderer::LayoutFlags layoutFlags;
+
+    int bandHeight;
+    int filterResolution;
 };
 
 /*!
@@ -242,6 +512,62 @@ QwtPlotRenderer::LayoutFlags QwtPlotRenderer::layoutFlags() const
     return d_data->layoutFlags;
 }
 
+/*!
+  \brief Set the height of the bands for rendering large images
+
+  When rendering a plot in bands, the plot is rendered into images
+  of the size of a band one after the other. The clip rectangle
+  of each band is respected by the canvas, so that plot items
+  like QwtPlotRasterItem or QwtPlotCurve only render the part,
+  that is inside of the band.
+
+  The default setting is 0, what disables rendering in bands.
+
+  \param height Height of a band in pixels
+  \sa bandHeight(), renderTile(), renderDocument()
+*/
+void QwtPlotRenderer::setBandHeight( int height )
+{
+    d_data->bandHeight = qMax( height, 0 );
+}
+
+/*!
+  \return Height of the bands for rendering large images
+  \sa setBandHeight()
+*/
+int QwtPlotRenderer::bandHeight() const
+{
+    return d_data->bandHeight;
+}
+
+/*!
+  \brief Set the resolution for filtering the points of curves
+
+  When rendering to vector devices ( PDF, SVG ) all curves, that have
+  no filter resolution of their own, are filtered by the pixels of
+  a raster device with this resolution. Then the size of the
+  document and the time for exporting it depend on the resolution
+  instead of the number of points.
+
+  The default setting is 0 ( = no filtering ).
+
+  \param resolution Resolution in dots per Inch (dpi)
+  \sa filterResolution(), QwtPlotCurve::setFilterResolution()
+*/
+void QwtPlotRenderer::setFilterResolution( int resolution )
+{
+    d_data->filterResolution = qMax( resolution, 0 );
+}
+
+/*!
+  \return Resolution for filtering the points of curves
+  \sa setFilterResolution()
+*/
+int QwtPlotRenderer::filterResolution() const
+{
+    return d_data->filterResolution;
+}
+
 /*!
   Render a plot to a file
 
@@ -252,11 +578,13 @@ QwtPlotRenderer::LayoutFlags QwtPlotRenderer::layoutFlags() const
   \param fileName Path of the file, where the document will be stored
   \param sizeMM Size for the document in millimeters.
   \param resolution Resolution in dots per Inch (dpi)
+
+  \return True, when the document has been written successfully
 */
-void QwtPlotRenderer::renderDocument( QwtPlot *plot,
+bool QwtPlotRenderer::renderDocument( QwtPlot *plot,
     const QString &fileName, const QSizeF &sizeMM, int resolution )
 {
-    renderDocument( plot, fileName,
+    return renderDocument( plot, fileName,
         QFileInfo( fileName ).suffix(), sizeMM, resolution );
 }
 
@@ -277,20 +605,36 @@ void QwtPlotRenderer::renderDocument( QwtPlot *plot,
   Scalable vector graphic formats like PDF or SVG are superior to
   raster graphics formats.
 
+  When a band height has been set, TIFF files are written band by band
+  by a built-in writer ( PackBits compressed RGB, up to 4GB ). Then the
+  memory needed for rendering is limited by the size of a band, what
+  allows to export images, that are too large for a QImage. When
+  writing fails or the file would exceed 4GB no file is left behind.
+
   \param plot Plot widget
   \param fileName Path of the file, where the document will be stored
   \param format Format for the document
   \param sizeMM Size for the document in millimeters.
   \param resolution Resolution in dots per Inch (dpi)
 
-  \sa renderTo(), render(), QwtPainter::setRoundingAlignment()
+  \return True, when the document has been written successfully
+
+  \sa renderTo(), render(), setBandHeight(), setFilterResolution(),
+      QwtPainter::setRoundingAlignment()
 */
-void QwtPlotRenderer::renderDocument( QwtPlot *plot,
+bool QwtPlotRenderer::renderDocument( QwtPlot *plot,
     const QString &fileName, const QString &format,
     const QSizeF &sizeMM, int resolution )
 {
     if ( plot == NULL || sizeMM.isEmpty() || resolution <= 0 )
-        return;
+        return false;
+
+    // the legend has to be up to date, even when no
+    // event loop has been running since the last changes
+
+    plot->updatePendingLegends();
+
+    bool ok = false;
 
     QString title = plot->title().text();
     if ( title.isEmpty() )
@@ -315,6 +659,7 @@ void QwtPlotRenderer::renderDocument( QwtPlot *plot,
 
         QPainter painter( &pdfWriter );
         render( plot, &painter, documentRect );
+        ok = painter.end();
 #else
         QPrinter printer;
         printer.setOutputFormat( QPrinter::PdfFormat );
@@ -327,6 +672,7 @@ void QwtPlotRenderer::renderDocument( QwtPlot *plot,
 
         QPainter painter( &printer );
         render( plot, &painter, documentRect );
+        ok = painter.end();
 #endif
 #endif
     }
@@ -344,6 +690,7 @@ void QwtPlotRenderer::renderDocument( QwtPlot *plot,
 
         QPainter painter( &printer );
         render( plot, &painter, documentRect );
+        ok = painter.end();
 #endif
     }
     else if ( fmt == QLatin1String( "svg" ) )
@@ -357,8 +704,31 @@ void QwtPlotRenderer::renderDocument( QwtPlot *plot,
 
         QPainter painter( &generator );
         render( plot, &painter, documentRect );
+        ok = painter.end();
 #endif
     }
+    else if ( qwtIsTiffFormat( fmt ) && d_data->bandHeight > 0 )
+    {
+        const QSize imageSize = documentRect.toRect().size();
+
+        TiffWriter writer( fileName );
+        if ( writer.open( imageSize, resolution, d_data->bandHeight ) )
+        {
+            for ( int y = 0; y < imageSize.height(); y += d_data->bandHeight )
+            {
+                const int h = qMin( d_data->bandHeight, imageSize.height() - y );
+
+                const QImage band = renderTile( plot, imageSize, resolution,
+                    QRect( 0, y, imageSize.width(), h ) );
+
+                if ( !writer.writeStrip( band ) )
+                    break;
+            }
+
+            // close() fails and removes the file after an error
+            ok = writer.close();
+        }
+    }
     else
     {
         if ( QImageWriter::supportedImageFormats().indexOf(
@@ -376,9 +746,114 @@ void QwtPlotRenderer::renderDocument( QwtPlot *plot,
             render( plot, &painter, imageRect );
             painter.end();
 
-            image.save( fileName, format.toLatin1() );
+            ok = image.save( fileName, format.toLatin1() );
         }
     }
+
+    return ok;
+}
+
+/*!
+  \brief Render a tile of a plot image
+
+  The layout is calculated for the complete image, but only the part
+  inside of the tile is painted. Tiles can be used to render images,
+  that are too large for being kept in memory - f.e. when writing
+  them to a file piece by piece.
+
+  \code
+    QwtPlotRenderer renderer;
+
+    const QSize imageSize( 20000, 15000 );
+    for ( int y = 0; y < imageSize.height(); y += 500 )
+    {
+        const QRect band( 0, y, imageSize.width(), 500 );
+
+        const QImage image = renderer.renderTile( plot, imageSize, 300, band );
+        writer.writeRows( image ); // some application specific writer
+    }
+  \endcode
+
+  \param plot Plot to be rendered
+  \param imageSize Size of the complete image
+  \param resolution Resolution in dots per Inch (dpi)
+  \param tileRect Rectangle of the tile inside of the complete image
+
+  \return Image of the tile filled with a white background
+  \sa setBandHeight(), renderDocument(), render()
+*/
+QImage QwtPlotRenderer::renderTile( QwtPlot *plot, const QSize &imageSize,
+    int resolution, const QRect &tileRect ) const
+{
+    const QRect imageRect( QPoint( 0, 0 ), imageSize );
+    const QRect rect = tileRect & imageRect;
+
+    if ( plot == NULL || rect.isEmpty() || resolution <= 0 )
+        return QImage();
+
+    const int dotsPerMeter = qRound( resolution / 25.4 * 1000.0 );
+
+    QImage image( rect.size(), QImage::Format_ARGB32 );
+    image.setDotsPerMeterX( dotsPerMeter );
+    image.setDotsPerMeterY( dotsPerMeter );
+    image.fill( QColor( Qt::white ).rgb() );
+
+    QPainter painter( &image );
+    painter.translate( -rect.topLeft() );
+    painter.setClipRect( rect );
+
+    render( plot, &painter, imageRect );
+    painter.end();
+
+    return image;
+}
+
+/*!
+  \brief Record the plot for rendering it later
+
+  The renderer paints the plot to a QwtPlotSnapshot, that does not
+  refer to the plot afterwards. The snapshot can be converted into
+  an image or a document from any thread - with the same result as
+  renderDocument() for the same size and resolution.
+
+  \code
+    QwtPlotRenderer renderer;
+
+    const QwtPlotSnapshot snapshot = renderer.snapshot( plot,
+        QSizeF( 300, 200 ), 300, QwtPlotSnapshot::VectorTarget );
+
+    // might be done in a worker thread
+    snapshot.renderDocument( "plot.pdf" );
+  \endcode
+
+  \param plot Plot to be recorded
+  \param sizeMM Size for the document in millimeters.
+  \param resolution Resolution in dots per Inch (dpi)
+  \param target Type of device, where the snapshot will be replayed
+
+  \return Recorded plot
+  \note snapshot() has to be called from the GUI thread
+  \sa QwtPlotSnapshot::toImage(), QwtPlotSnapshot::renderDocument()
+*/
+QwtPlotSnapshot QwtPlotRenderer::snapshot( QwtPlot *plot,
+    const QSizeF &sizeMM, int resolution,
+    QwtPlotSnapshot::Target target ) const
+{
+    if ( plot == NULL || sizeMM.isEmpty() || resolution <= 0 )
+        return QwtPlotSnapshot();
+
+    QString title = plot->title().text();
+    if ( title.isEmpty() )
+        title = "Plot Document";
+
+    QwtPlotSnapshot snapshot( sizeMM, resolution, target );
+    snapshot.setTitle( title );
+
+    QPainter painter( &snapshot );
+    render( plot, &painter, snapshot.documentRect() );
+    painter.end();
+
+    return snapshot;
 }
 
 /*!
@@ -483,6 +958,9 @@ void QwtPlotRenderer::render( QwtPlot *plot,
         return;
     }
 
+    // legend updates, that are still waiting for the event loop
+    plot->updatePendingLegends();
+
     if ( !( d_data->discardFlags & DiscardBackground ) )
         QwtPainter::drawBackgound( painter, plotRect, plot );
 
@@ -517,9 +995,10 @@ void QwtPlotRenderer::render( QwtPlot *plot,
 
         if ( d_data->layoutFlags & FrameWithScales )
         {
-            QwtScaleWidget *scaleWidget = plot->axisWidget( axisId );
-            if ( scaleWidget )
+            if ( plot->hasAxisWidget( axisId ) )
             {
+                QwtScaleWidget *scaleWidget = plot->axisWidget( axisId );
+
                 baseLineDists[axisId] = scaleWidget->margin();
                 scaleWidget->setMargin( 0 );
             }
@@ -587,6 +1066,25 @@ void QwtPlotRenderer::render( QwtPlot *plot,
         buildCanvasMaps( plot, layout->canvasRect(), maps );
     }
 
+    // curves without a filter resolution of their own
+
+    QList<QwtPlotCurve *> filteredCurves;
+    if ( d_data->filterResolution > 0 )
+    {
+        const QwtPlotItemList curves =
+            plot->itemList( QwtPlotItem::Rtti_PlotCurve );
+
+        for ( QwtPlotItemIterator it = curves.begin(); it != curves.end(); ++it )
+        {
+            QwtPlotCurve *curve = static_cast< QwtPlotCurve *>( *it );
+            if ( curve->filterResolution() == 0 )
+            {
+                curve->setFilterResolution( d_data->filterResolution );
+                filteredCurves += curve;
+            }
+        }
+    }
+
     // now start painting
 
     painter->save();
@@ -595,13 +1093,13 @@ void QwtPlotRenderer::render( QwtPlot *plot,
     renderCanvas( plot, painter, layout->canvasRect(), maps );
 
     if ( !( d_data->discardFlags & DiscardTitle )
-        && ( !plot->titleLabel()->text().isEmpty() ) )
+        && ( !plot->title().isEmpty() ) )
     {
         renderTitle( plot, painter, layout->titleRect() );
     }
 
     if ( !( d_data->discardFlags & DiscardFooter )
-        && ( !plot->footerLabel()->text().isEmpty() ) )
+        && ( !plot->footer().isEmpty() ) )
     {
         renderFooter( plot, painter, layout->footerRect() );
     }
@@ -614,9 +1112,10 @@ void QwtPlotRenderer::render( QwtPlot *plot,
 
     for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
     {
-        QwtScaleWidget *scaleWidget = plot->axisWidget( axisId );
-        if ( scaleWidget )
+        if ( plot->axisEnabled( axisId ) )
         {
+            QwtScaleWidget *scaleWidget = plot->axisWidget( axisId );
+
             int baseDist = scaleWidget->margin();
 
             int startDist, endDist;
@@ -630,13 +1129,15 @@ void QwtPlotRenderer::render( QwtPlot *plot,
     painter->restore();
 
     // restore all setting to their original attributes.
+    for ( int i = 0; i < filteredCurves.size(); i++ )
+        filteredCurves[i]->setFilterResolution( 0 );
+
     for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
     {
         if ( d_data->layoutFlags & FrameWithScales )
         {
-            QwtScaleWidget *scaleWidget = plot->axisWidget( axisId );
-            if ( scaleWidget  )
-                scaleWidget->setMargin( baseLineDists[axisId] );
+            if ( plot->hasAxisWidget( axisId ) )
+                plot->axisWidget( axisId )->setMargin( baseLineDists[axisId] );
         }
 
         layout->setCanvasMargin( canvasMargins[axisId] );
@@ -847,7 +1348,7 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
         painter->restore();
         painter->save();
 
-        painter->setClipRect( canvasRect );
+        painter->setClipRect( canvasRect, Qt::IntersectClip );
         plot->drawItems( painter, canvasRect, maps );
 
         painter->restore();
@@ -868,9 +1369,9 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
         painter->save();
 
         if ( clipPath.isEmpty() )
-            painter->setClipRect( canvasRect );
+            painter->setClipRect( canvasRect, Qt::IntersectClip );
         else
-            painter->setClipPath( clipPath );
+            painter->setClipPath( clipPath, Qt::IntersectClip );
 
         plot->drawItems( painter, canvasRect, maps );
 
@@ -898,11 +1399,11 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
 
         if ( clipPath.isEmpty() )
         {
-            painter->setClipRect( innerRect );
+            painter->setClipRect( innerRect, Qt::IntersectClip );
         }
         else
         {
-            painter->setClipPath( clipPath );
+            painter->setClipPath( clipPath, Qt::IntersectClip );
         }
 
         if ( !( d_data->discardFlags & DiscardCanvasBackground ) )
@@ -1083,9 +1584,7 @@ bool QwtPlotRenderer::exportTo( QwtPlot *plot, const QString &documentName,
     if ( fileName.isEmpty() )
         return false;
 
-    renderDocument( plot, fileName, sizeMM, resolution );
-
-    return true;
+    return renderDocument( plot, fileName, sizeMM, resolution );
 }
 
 #if QWT_MOC_INCLUDE
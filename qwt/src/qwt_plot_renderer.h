@@ -11,6 +11,7 @@
 #define QWT_PLOT_RENDERER_H
 
 #include "qwt_global.h"
+#include "qwt_plot_snapshot.h"
 
 #include <qobject.h>
 #include <qsize.h>
@@ -20,6 +21,8 @@ class QwtScaleMap;
 class QRectF;
 class QPainter;
 class QPaintDevice;
+class QImage;
+class QRect;
 
 #ifndef QT_NO_PRINTER
 class QPrinter;
@@ -109,10 +112,16 @@ public:
     void setLayoutFlags( LayoutFlags flags );
     LayoutFlags layoutFlags() const;
 
-    void renderDocument( QwtPlot *, const QString &fileName,
+    void setBandHeight( int );
+    int bandHeight() const;
+
+    void setFilterResolution( int );
+    int filterResolution() const;
+
+    bool renderDocument( QwtPlot *, const QString &fileName,
         const QSizeF &sizeMM, int resolution = 85 );
 
-    void renderDocument( QwtPlot *,
+    bool renderDocument( QwtPlot *,
         const QString &fileName, const QString &format,
         const QSizeF &sizeMM, int resolution = 85 );
 
@@ -128,6 +137,13 @@ public:
 
     void renderTo( QwtPlot *, QPaintDevice & ) const;
 
+    QImage renderTile( QwtPlot *, const QSize &imageSize,
+        int resolution, const QRect &tileRect ) const;
+
+    QwtPlotSnapshot snapshot( QwtPlot *, const QSizeF &sizeMM,
+        int resolution = 85,
+        QwtPlotSnapshot::Target = QwtPlotSnapshot::RasterTarget ) const;
+
     virtual void render( QwtPlot *,
         QPainter *, const QRectF &plotRect ) const;
 
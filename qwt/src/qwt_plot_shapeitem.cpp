@@ -255,6 +255,9 @@ void QwtPlotShapeItem::setShape( const QPainterPath &shape )
             d_data->boundingRect = shape.boundingRect();
         }
 
+        if ( d_data->legendMode == QwtPlotShapeItem::LegendShape )
+            legendChanged();
+
         itemChanged();
     }
 }
@@ -299,6 +302,8 @@ void QwtPlotShapeItem::setPen( const QPen &pen )
     if ( pen != d_data->pen )
     {
         d_data->pen = pen;
+
+        legendChanged();
         itemChanged();
     }
 }
@@ -325,6 +330,8 @@ void QwtPlotShapeItem::setBrush( const QBrush &brush )
     if ( brush != d_data->brush )
     {
         d_data->brush = brush;
+
+        legendChanged();
         itemChanged();
     }
 }
@@ -0,0 +1,995 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_snapshot.h"
+#include "qwt_painter_command.h"
+#include "qwt_painter.h"
+
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qpaintengine.h>
+#include <qtransform.h>
+#include <qimage.h>
+#include <qpixmap.h>
+#include <qfont.h>
+#include <qline.h>
+#include <qpolygon.h>
+#include <qstring.h>
+#include <qstringlist.h>
+#include <qimagewriter.h>
+#include <qfileinfo.h>
+#include <qmargins.h>
+
+#if !defined(QT_NO_QFUTURE)
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+#define QWT_USE_THREADS 1
+#endif
+
+#ifndef QWT_NO_SVG
+#ifdef QT_SVG_LIB
+#define QWT_FORMAT_SVG 1
+#endif
+#endif
+
+#ifndef QT_NO_PDF
+#if QT_VERSION >= 0x050300
+#define QWT_PDF_WRITER 1
+#endif
+#endif
+
+#if QWT_FORMAT_SVG
+#include <qsvggenerator.h>
+#endif
+
+#if QWT_PDF_WRITER
+#include <qpdfwriter.h>
+#endif
+
+class QwtPlotSnapshot::Command
+{
+public:
+    enum Type
+    {
+        Rects,
+        RectsF,
+        Lines,
+        LinesF,
+        Ellipse,
+        EllipseF,
+        Path,
+        Points,
+        PointsF,
+        Polygon,
+        PolygonF,
+        Image,
+        TiledImage,
+        Text,
+        State
+    };
+
+    explicit Command( Type commandType = State, int drawMode = 0 ):
+        type( commandType ),
+        mode( drawMode )
+    {
+    }
+
+    Type type;
+
+    // polygon draw mode, image conversion or text render flags
+    int mode;
+
+    QVector< QRect > rects;
+    QVector< QRectF > rectsF;
+
+    QVector< QLine > lines;
+    QVector< QLineF > linesF;
+
+    QPolygon points;
+    QPolygonF pointsF;
+
+    QPainterPath path;
+    QImage image;
+
+    QString text;
+    QFont font;
+
+    QwtPainterCommand state;
+};
+
+static inline QBrush qwtImageBrush( const QBrush &brush )
+{
+    /*
+        A texture, that has been set as QPixmap, would be converted
+        in the thread, where the snapshot is replayed. But QPixmap
+        must not be used outside of the GUI thread.
+     */
+    if ( brush.style() != Qt::TexturePattern )
+        return brush;
+
+    QBrush b( brush );
+    b.setTextureImage( brush.textureImage() );
+
+    return b;
+}
+
+static void qwtExecState( QPainter *painter,
+    const QwtPainterCommand::StateData *data, const QTransform &transform )
+{
+    if ( data->flags & QPaintEngine::DirtyPen )
+        painter->setPen( data->pen );
+
+    if ( data->flags & QPaintEngine::DirtyBrush )
+        painter->setBrush( data->brush );
+
+    if ( data->flags & QPaintEngine::DirtyBrushOrigin )
+        painter->setBrushOrigin( data->brushOrigin );
+
+    if ( data->flags & QPaintEngine::DirtyFont )
+        painter->setFont( data->font );
+
+    if ( data->flags & QPaintEngine::DirtyBackground )
+    {
+        painter->setBackgroundMode( data->backgroundMode );
+        painter->setBackground( data->backgroundBrush );
+    }
+
+    if ( data->flags & QPaintEngine::DirtyTransform )
+        painter->setTransform( data->transform * transform );
+
+    if ( data->flags & QPaintEngine::DirtyClipEnabled )
+        painter->setClipping( data->isClipEnabled );
+
+    if ( data->flags & QPaintEngine::DirtyClipRegion )
+        painter->setClipRegion( data->clipRegion, data->clipOperation );
+
+    if ( data->flags & QPaintEngine::DirtyClipPath )
+        painter->setClipPath( data->clipPath, data->clipOperation );
+
+    if ( data->flags & QPaintEngine::DirtyHints )
+    {
+        for ( int i = 0; i < 8; i++ )
+        {
+            const QPainter::RenderHint hint =
+                static_cast< QPainter::RenderHint >( 1 << i );
+
+            painter->setRenderHint( hint, data->renderHints.testFlag( hint ) );
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyCompositionMode )
+        painter->setCompositionMode( data->compositionMode );
+
+    if ( data->flags & QPaintEngine::DirtyOpacity )
+        painter->setOpacity( data->opacity );
+}
+
+static void qwtExecPolygon( QPainter *painter,
+    const QPointF *points, int pointCount, int mode )
+{
+    switch( mode )
+    {
+        case QPaintEngine::PolylineMode:
+        {
+            // QwtPainter splits polylines for the raster paint engine
+            // like when painting the plot directly
+            QwtPainter::drawPolyline( painter, points, pointCount );
+            break;
+        }
+        case QPaintEngine::ConvexMode:
+        {
+            painter->drawConvexPolygon( points, pointCount );
+            break;
+        }
+        case QPaintEngine::WindingMode:
+        {
+            painter->drawPolygon( points, pointCount, Qt::WindingFill );
+            break;
+        }
+        default:
+        {
+            painter->drawPolygon( points, pointCount, Qt::OddEvenFill );
+        }
+    }
+}
+
+static void qwtExecPolygon( QPainter *painter,
+    const QPoint *points, int pointCount, int mode )
+{
+    switch( mode )
+    {
+        case QPaintEngine::PolylineMode:
+        {
+            QwtPainter::drawPolyline( painter, points, pointCount );
+            break;
+        }
+        case QPaintEngine::ConvexMode:
+        {
+            painter->drawConvexPolygon( points, pointCount );
+            break;
+        }
+        case QPaintEngine::WindingMode:
+        {
+            painter->drawPolygon( points, pointCount, Qt::WindingFill );
+            break;
+        }
+        default:
+        {
+            painter->drawPolygon( points, pointCount, Qt::OddEvenFill );
+        }
+    }
+}
+
+static void qwtExecText( QPainter *painter,
+    const QPointF &pos, const QString &text, const QFont &font, int flags )
+{
+    const QFont oldFont = painter->font();
+    const Qt::LayoutDirection oldDirection = painter->layoutDirection();
+
+    painter->setFont( font );
+    painter->setLayoutDirection( ( flags & QTextItem::RightToLeft )
+        ? Qt::RightToLeft : Qt::LeftToRight );
+
+    painter->drawText( pos, text );
+
+    painter->setLayoutDirection( oldDirection );
+    painter->setFont( oldFont );
+}
+
+static QImage qwtSnapshotImage( const QwtPlotSnapshot *snapshot )
+{
+    return snapshot->toImage();
+}
+
+static bool qwtSnapshotDocument(
+    const QwtPlotSnapshot *snapshot, const QString &fileName )
+{
+    return snapshot->renderDocument( fileName );
+}
+
+class QwtPlotSnapshot::PrivateData
+{
+public:
+    PrivateData():
+        resolution( 0 ),
+        target( QwtPlotSnapshot::RasterTarget )
+    {
+    }
+
+    QSizeF sizeMM;
+    int resolution;
+    QwtPlotSnapshot::Target target;
+
+    QString title;
+
+    QVector< QwtPlotSnapshot::Command > commands;
+};
+
+/*!
+  \brief Default constructor
+
+  Initializes a null snapshot
+  \sa isNull()
+ */
+QwtPlotSnapshot::QwtPlotSnapshot():
+    QwtNullPaintDevice()
+{
+    d_data = new PrivateData;
+}
+
+/*!
+  \brief Constructor
+
+  The snapshot is recorded by painting to it. Usually this is
+  done by QwtPlotRenderer::snapshot().
+
+  \code
+    QwtPlotSnapshot snapshot( QSizeF( 300, 200 ), 85 );
+
+    QPainter painter( &snapshot );
+    renderer.render( plot, &painter, snapshot.documentRect() );
+  \endcode
+
+  \param sizeMM Size of the document in millimeters
+  \param resolution Resolution in dots per Inch (dpi)
+  \param target Type of device, where the snapshot will be replayed
+
+  \sa QwtPlotRenderer::snapshot()
+ */
+QwtPlotSnapshot::QwtPlotSnapshot( const QSizeF &sizeMM,
+        int resolution, Target target ):
+    QwtNullPaintDevice()
+{
+    setAligning( target == RasterTarget );
+
+    d_data = new PrivateData;
+    d_data->sizeMM = sizeMM;
+    d_data->resolution = qMax( resolution, 0 );
+    d_data->target = target;
+}
+
+/*!
+  \brief Copy constructor
+
+  \param other Source
+  \sa operator=()
+ */
+QwtPlotSnapshot::QwtPlotSnapshot( const QwtPlotSnapshot &other ):
+    QwtNullPaintDevice()
+{
+    setAligning( other.isAligning() );
+    d_data = new PrivateData( *other.d_data );
+}
+
+//! Destructor
+QwtPlotSnapshot::~QwtPlotSnapshot()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Assignment operator
+
+  \param other Source
+  \return A reference of this object
+ */
+QwtPlotSnapshot& QwtPlotSnapshot::operator=( const QwtPlotSnapshot &other )
+{
+    setAligning( other.isAligning() );
+    *d_data = *other.d_data;
+
+    return *this;
+}
+
+/*!
+  \brief Clear all recorded paint operations
+  \sa isEmpty()
+ */
+void QwtPlotSnapshot::reset()
+{
+    d_data->commands.clear();
+}
+
+/*!
+  \return True, when the snapshot has no valid document size
+  \sa documentRect(), isEmpty()
+ */
+bool QwtPlotSnapshot::isNull() const
+{
+    return documentRect().isEmpty();
+}
+
+/*!
+  \return True, when no paint operations have been recorded
+  \sa isNull(), reset()
+ */
+bool QwtPlotSnapshot::isEmpty() const
+{
+    return d_data->commands.isEmpty();
+}
+
+/*!
+  \return Type of device, where the snapshot will be replayed
+ */
+QwtPlotSnapshot::Target QwtPlotSnapshot::target() const
+{
+    return d_data->target;
+}
+
+/*!
+  \return Size of the document in millimeters
+  \sa resolution(), documentRect()
+ */
+QSizeF QwtPlotSnapshot::sizeMM() const
+{
+    return d_data->sizeMM;
+}
+
+/*!
+  \return Resolution in dots per Inch (dpi)
+  \sa sizeMM(), metric()
+ */
+int QwtPlotSnapshot::resolution() const
+{
+    return d_data->resolution;
+}
+
+/*!
+  \brief Rectangle of the document in device coordinates
+
+  For raster targets the rectangle is rounded to integers like
+  it is done by QwtPlotRenderer::renderDocument() for images.
+
+  \return Rectangle, where the plot has to be rendered to
+  \sa sizeMM(), resolution()
+ */
+QRectF QwtPlotSnapshot::documentRect() const
+{
+    const double mmToInch = 1.0 / 25.4;
+    const QSizeF size = d_data->sizeMM * mmToInch * d_data->resolution;
+
+    QRectF rect( 0.0, 0.0, size.width(), size.height() );
+    if ( d_data->target == RasterTarget )
+        rect = rect.toRect();
+
+    return rect;
+}
+
+/*!
+  Set the title of documents, that are generated from the snapshot
+
+  \param title Document title
+  \sa title(), renderDocument()
+ */
+void QwtPlotSnapshot::setTitle( const QString &title )
+{
+    d_data->title = title;
+}
+
+/*!
+  \return Document title
+  \sa setTitle()
+ */
+QString QwtPlotSnapshot::title() const
+{
+    return d_data->title;
+}
+
+/*!
+  \brief Replay the recorded paint operations
+
+  The operations are painted in the coordinate system of the
+  painter. For an identical result the resolution of the paint
+  device has to be the same as the one of the snapshot.
+
+  \param painter Painter
+  \sa toImage(), renderDocument()
+ */
+void QwtPlotSnapshot::render( QPainter *painter ) const
+{
+    if ( painter == NULL || !painter->isActive() || isEmpty() )
+        return;
+
+    const QTransform transform = painter->transform();
+
+    painter->save();
+
+    const QVector< Command > &commands = d_data->commands;
+    for ( int i = 0; i < commands.size(); i++ )
+    {
+        const Command &cmd = commands[i];
+
+        switch( cmd.type )
+        {
+            case Command::Rects:
+            {
+                painter->drawRects( cmd.rects.constData(), cmd.rects.size() );
+                break;
+            }
+            case Command::RectsF:
+            {
+                painter->drawRects( cmd.rectsF.constData(), cmd.rectsF.size() );
+                break;
+            }
+            case Command::Lines:
+            {
+                painter->drawLines( cmd.lines.constData(), cmd.lines.size() );
+                break;
+            }
+            case Command::LinesF:
+            {
+                painter->drawLines( cmd.linesF.constData(), cmd.linesF.size() );
+                break;
+            }
+            case Command::Ellipse:
+            {
+                painter->drawEllipse( cmd.rects[0] );
+                break;
+            }
+            case Command::EllipseF:
+            {
+                painter->drawEllipse( cmd.rectsF[0] );
+                break;
+            }
+            case Command::Path:
+            {
+                painter->drawPath( cmd.path );
+                break;
+            }
+            case Command::Points:
+            {
+                painter->drawPoints( cmd.points.constData(), cmd.points.size() );
+                break;
+            }
+            case Command::PointsF:
+            {
+                painter->drawPoints( cmd.pointsF.constData(), cmd.pointsF.size() );
+                break;
+            }
+            case Command::Polygon:
+            {
+                qwtExecPolygon( painter,
+                    cmd.points.constData(), cmd.points.size(), cmd.mode );
+                break;
+            }
+            case Command::PolygonF:
+            {
+                qwtExecPolygon( painter,
+                    cmd.pointsF.constData(), cmd.pointsF.size(), cmd.mode );
+                break;
+            }
+            case Command::Image:
+            {
+                painter->drawImage( cmd.rectsF[0], cmd.image, cmd.rectsF[1],
+                    Qt::ImageConversionFlags( QFlag( cmd.mode ) ) );
+                break;
+            }
+            case Command::TiledImage:
+            {
+                const QRectF &rect = cmd.rectsF[0];
+
+                painter->save();
+                painter->setBrushOrigin( rect.topLeft() - cmd.pointsF[0] );
+                painter->fillRect( rect, QBrush( cmd.image ) );
+                painter->restore();
+
+                break;
+            }
+            case Command::Text:
+            {
+                qwtExecText( painter, cmd.pointsF[0],
+                    cmd.text, cmd.font, cmd.mode );
+                break;
+            }
+            case Command::State:
+            {
+                qwtExecState( painter, cmd.state.stateData(), transform );
+                break;
+            }
+        }
+    }
+
+    painter->restore();
+}
+
+/*!
+  \brief Render the snapshot to an image
+
+  The image has the size of the document rectangle and is filled
+  with a white background like in QwtPlotRenderer::renderDocument().
+
+  \return Image with the resolution of the snapshot
+  \note toImage() might be called from any thread
+  \sa toImages(), render()
+ */
+QImage QwtPlotSnapshot::toImage() const
+{
+    const QRect imageRect = documentRect().toRect();
+    if ( imageRect.isEmpty() )
+        return QImage();
+
+    const double mmToInch = 1.0 / 25.4;
+    const int dotsPerMeter = qRound( d_data->resolution * mmToInch * 1000.0 );
+
+    QImage image( imageRect.size(), QImage::Format_ARGB32 );
+    image.setDotsPerMeterX( dotsPerMeter );
+    image.setDotsPerMeterY( dotsPerMeter );
+    image.fill( QColor( Qt::white ).rgb() );
+
+    QPainter painter( &image );
+    render( &painter );
+    painter.end();
+
+    return image;
+}
+
+/*!
+  Render the snapshot to a file
+
+  The format of the document will be auto-detected from the
+  suffix of the file name.
+
+  \param fileName Path of the file, where the document will be stored
+  \return True, when the document has been written successfully
+
+  \sa renderDocuments()
+*/
+bool QwtPlotSnapshot::renderDocument( const QString &fileName ) const
+{
+    return renderDocument( fileName, QFileInfo( fileName ).suffix() );
+}
+
+/*!
+  Render the snapshot to a file
+
+  Supported formats are:
+
+  - pdf\n
+    Portable Document Format PDF ( Qt >= 5.3 )
+  - svg\n
+    Scalable Vector Graphics SVG
+  - all image formats supported by Qt\n
+    see QImageWriter::supportedImageFormats()
+
+  Postscript and the QPrinter based PDF generation of older Qt
+  versions are not available as QPrinter must not be used outside
+  of the GUI thread.
+
+  \param fileName Path of the file, where the document will be stored
+  \param format Format for the document
+  \return True, when the document has been written successfully
+
+  \note renderDocument() might be called from any thread
+  \sa renderDocuments(), QwtPlotRenderer::renderDocument()
+*/
+bool QwtPlotSnapshot::renderDocument(
+    const QString &fileName, const QString &format ) const
+{
+    if ( isNull() )
+        return false;
+
+    QString title = d_data->title;
+    if ( title.isEmpty() )
+        title = "Plot Document";
+
+    const QString fmt = format.toLower();
+    if ( fmt == QLatin1String( "pdf" ) )
+    {
+#if QWT_PDF_WRITER
+        QPdfWriter pdfWriter( fileName );
+        pdfWriter.setPageSize( QPageSize( d_data->sizeMM, QPageSize::Millimeter ) );
+        pdfWriter.setTitle( title );
+        pdfWriter.setPageMargins( QMarginsF() );
+        pdfWriter.setResolution( d_data->resolution );
+
+        QPainter painter;
+        if ( !painter.begin( &pdfWriter ) )
+            return false;
+
+        render( &painter );
+        return painter.end();
+#endif
+    }
+    else if ( fmt == QLatin1String( "svg" ) )
+    {
+#if QWT_FORMAT_SVG
+        QSvgGenerator generator;
+        generator.setTitle( title );
+        generator.setFileName( fileName );
+        generator.setResolution( d_data->resolution );
+        generator.setViewBox( documentRect() );
+
+        QPainter painter;
+        if ( !painter.begin( &generator ) )
+            return false;
+
+        render( &painter );
+        return painter.end();
+#endif
+    }
+    else
+    {
+        if ( QImageWriter::supportedImageFormats().indexOf(
+            format.toLatin1() ) >= 0 )
+        {
+            return toImage().save( fileName, format.toLatin1() );
+        }
+    }
+
+    return false;
+}
+
+/*!
+  \brief Render a list of snapshots to images
+
+  The images are rendered in parallel by the threads of the
+  global thread pool.
+
+  \param snapshots Snapshots
+  \return Images in the order of the snapshots
+
+  \sa toImage(), renderDocuments()
+ */
+QVector<QImage> QwtPlotSnapshot::toImages(
+    const QVector<QwtPlotSnapshot> &snapshots )
+{
+    QVector<QImage> images( snapshots.size() );
+
+#if QWT_USE_THREADS
+    QVector< QFuture<QImage> > futures;
+    futures.reserve( snapshots.size() );
+
+    for ( int i = 0; i < snapshots.size(); i++ )
+        futures += QtConcurrent::run( &qwtSnapshotImage, &snapshots[i] );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        images[i] = futures[i].result();
+#else
+    for ( int i = 0; i < snapshots.size(); i++ )
+        images[i] = qwtSnapshotImage( &snapshots[i] );
+#endif
+
+    return images;
+}
+
+/*!
+  \brief Render a list of snapshots to files
+
+  The documents are rendered in parallel by the threads of the
+  global thread pool. The format of a document is auto-detected
+  from the suffix of its file name.
+
+  renderDocuments() blocks, until all documents have been written.
+  It can be called from a worker thread to keep the GUI responsive.
+
+  \param snapshots Snapshots
+  \param fileNames File names, one for each snapshot
+
+  \return Success flags in the order of the snapshots
+  \sa renderDocument(), toImages()
+ */
+QVector<bool> QwtPlotSnapshot::renderDocuments(
+    const QVector<QwtPlotSnapshot> &snapshots, const QStringList &fileNames )
+{
+    QVector<bool> ok( snapshots.size(), false );
+
+    const int numDocuments = qMin( snapshots.size(), fileNames.size() );
+
+#if QWT_USE_THREADS
+    QVector< QFuture<bool> > futures;
+    futures.reserve( numDocuments );
+
+    for ( int i = 0; i < numDocuments; i++ )
+    {
+        futures += QtConcurrent::run( &qwtSnapshotDocument,
+            &snapshots[i], fileNames[i] );
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        ok[i] = futures[i].result();
+#else
+    for ( int i = 0; i < numDocuments; i++ )
+        ok[i] = qwtSnapshotDocument( &snapshots[i], fileNames[i] );
+#endif
+
+    return ok;
+}
+
+/*!
+  See QPaintDevice::metric()
+
+  The resolution of the snapshot is returned as logical and
+  physical dpi, so that fonts and the layout of the plot are
+  calculated for the resolution of the document.
+
+  \param deviceMetric Type of metric
+  \return Metric information for the given paint device metric.
+ */
+int QwtPlotSnapshot::metric( PaintDeviceMetric deviceMetric ) const
+{
+    if ( d_data->resolution > 0 )
+    {
+        switch ( deviceMetric )
+        {
+            case PdmPhysicalDpiX:
+            case PdmPhysicalDpiY:
+            case PdmDpiY:
+            case PdmDpiX:
+                return d_data->resolution;
+
+            default:
+                break;
+        }
+    }
+
+    return QwtNullPaintDevice::metric( deviceMetric );
+}
+
+/*!
+  \return Size of the document rectangle
+  \sa documentRect()
+ */
+QSize QwtPlotSnapshot::sizeMetrics() const
+{
+    return documentRect().toAlignedRect().size();
+}
+
+//! See QPaintEngine::drawRects()
+void QwtPlotSnapshot::drawRects( const QRect *rects, int count )
+{
+    Command cmd( Command::Rects );
+    cmd.rects.resize( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.rects[i] = rects[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawRects()
+void QwtPlotSnapshot::drawRects( const QRectF *rects, int count )
+{
+    Command cmd( Command::RectsF );
+    cmd.rectsF.resize( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.rectsF[i] = rects[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawLines()
+void QwtPlotSnapshot::drawLines( const QLine *lines, int count )
+{
+    Command cmd( Command::Lines );
+    cmd.lines.resize( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.lines[i] = lines[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawLines()
+void QwtPlotSnapshot::drawLines( const QLineF *lines, int count )
+{
+    Command cmd( Command::LinesF );
+    cmd.linesF.resize( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.linesF[i] = lines[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawEllipse()
+void QwtPlotSnapshot::drawEllipse( const QRectF &rect )
+{
+    Command cmd( Command::EllipseF );
+    cmd.rectsF += rect;
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawEllipse()
+void QwtPlotSnapshot::drawEllipse( const QRect &rect )
+{
+    Command cmd( Command::Ellipse );
+    cmd.rects += rect;
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawPath()
+void QwtPlotSnapshot::drawPath( const QPainterPath &path )
+{
+    Command cmd( Command::Path );
+    cmd.path = path;
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawPoints()
+void QwtPlotSnapshot::drawPoints( const QPointF *points, int count )
+{
+    Command cmd( Command::PointsF );
+    cmd.pointsF = QPolygonF( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.pointsF[i] = points[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawPoints()
+void QwtPlotSnapshot::drawPoints( const QPoint *points, int count )
+{
+    Command cmd( Command::Points );
+    cmd.points = QPolygon( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.points[i] = points[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawPolygon()
+void QwtPlotSnapshot::drawPolygon( const QPointF *points,
+    int count, QPaintEngine::PolygonDrawMode mode )
+{
+    Command cmd( Command::PolygonF, mode );
+    cmd.pointsF = QPolygonF( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.pointsF[i] = points[i];
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawPolygon()
+void QwtPlotSnapshot::drawPolygon( const QPoint *points,
+    int count, QPaintEngine::PolygonDrawMode mode )
+{
+    Command cmd( Command::Polygon, mode );
+    cmd.points = QPolygon( count );
+    for ( int i = 0; i < count; i++ )
+        cmd.points[i] = points[i];
+
+    d_data->commands += cmd;
+}
+
+/*!
+  \brief Store a pixmap command
+
+  The pixmap is converted into an image, that can
+  be painted in any thread.
+
+  \sa QPaintEngine::drawPixmap()
+ */
+void QwtPlotSnapshot::drawPixmap( const QRectF &rect,
+    const QPixmap &pixmap, const QRectF &subRect )
+{
+    drawImage( rect, pixmap.toImage(), subRect, Qt::AutoColor );
+}
+
+/*!
+  \brief Store a text command
+
+  The text is stored as plain text together with the
+  font of the text item.
+
+  \sa QPaintEngine::drawTextItem()
+ */
+void QwtPlotSnapshot::drawTextItem(
+    const QPointF &pos, const QTextItem &textItem )
+{
+    Command cmd( Command::Text, static_cast< int >( textItem.renderFlags() ) );
+    cmd.pointsF += pos;
+    cmd.text = textItem.text();
+    cmd.font = textItem.font();
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawTiledPixmap()
+void QwtPlotSnapshot::drawTiledPixmap( const QRectF &rect,
+    const QPixmap &pixmap, const QPointF &offset )
+{
+    Command cmd( Command::TiledImage );
+    cmd.rectsF += rect;
+    cmd.pointsF += offset;
+    cmd.image = pixmap.toImage();
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::drawImage()
+void QwtPlotSnapshot::drawImage( const QRectF &rect, const QImage &image,
+    const QRectF &subRect, Qt::ImageConversionFlags flags )
+{
+    Command cmd( Command::Image, static_cast< int >( flags ) );
+    cmd.rectsF += rect;
+    cmd.rectsF += subRect;
+    cmd.image = image;
+
+    d_data->commands += cmd;
+}
+
+//! See QPaintEngine::updateState()
+void QwtPlotSnapshot::updateState( const QPaintEngineState &state )
+{
+    Command cmd( Command::State );
+    cmd.state = QwtPainterCommand( state );
+
+    QwtPainterCommand::StateData *data = cmd.state.stateData();
+
+    if ( data->flags & QPaintEngine::DirtyPen )
+        data->pen.setBrush( qwtImageBrush( data->pen.brush() ) );
+
+    if ( data->flags & QPaintEngine::DirtyBrush )
+        data->brush = qwtImageBrush( data->brush );
+
+    if ( data->flags & QPaintEngine::DirtyBackground )
+        data->backgroundBrush = qwtImageBrush( data->backgroundBrush );
+
+    d_data->commands += cmd;
+}
@@ -0,0 +1,169 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_SNAPSHOT_H
+#define QWT_PLOT_SNAPSHOT_H
+
+#include "qwt_global.h"
+#include "qwt_null_paintdevice.h"
+
+#include <qvector.h>
+#include <qsize.h>
+
+class QPainter;
+class QImage;
+class QString;
+class QStringList;
+class QRectF;
+
+/*!
+  \brief A recorded plot, that can be rendered from any thread
+
+  QwtPlotRenderer accesses the widgets and items of a plot, what
+  can be done in the GUI thread only. QwtPlotSnapshot records the
+  paint operations of the renderer for a document of a specific size
+  and resolution, but does not refer to the plot afterwards.
+  So the plot might be modified or deleted, while the snapshot
+  is converted into an image or a document in a worker thread.
+
+  Recording the paint operations is cheap compared to rasterizing
+  them or writing compressed documents. So most of the work of
+  an export is moved out of the GUI thread.
+
+  When replaying a snapshot to a device of the same resolution,
+  the same QPainter operations are executed as when rendering
+  the plot directly. As QwtPainter aligns coordinates for raster
+  devices only, the target of the snapshot has to be known
+  in advance.
+
+  \code
+    QwtPlotRenderer renderer;
+
+    QVector<QwtPlotSnapshot> snapshots;
+    QStringList fileNames;
+
+    for ( int i = 0; i < plots.size(); i++ )
+    {
+        snapshots += renderer.snapshot( plots[i], QSizeF( 300, 200 ), 85,
+            QwtPlotSnapshot::VectorTarget );
+
+        fileNames += QString( "plot%1.pdf" ).arg( i );
+    }
+
+    // the plots might be modified from now on
+
+    QtConcurrent::run( &QwtPlotSnapshot::renderDocuments,
+        snapshots, fileNames );
+  \endcode
+
+  \note Text is replayed as plain text using the font of the recorded
+        text item. Pixmaps are stored as images as QPixmap must not
+        be used outside of the GUI thread.
+
+  \sa QwtPlotRenderer::snapshot()
+*/
+class QWT_EXPORT QwtPlotSnapshot: public QwtNullPaintDevice
+{
+public:
+    /*!
+      \brief Type of device, where the snapshot will be replayed
+      \sa target()
+     */
+    enum Target
+    {
+        //! Raster devices like QImage, where QwtPainter aligns coordinates
+        RasterTarget,
+
+        //! Vector devices like PDF or SVG
+        VectorTarget
+    };
+
+    QwtPlotSnapshot();
+    QwtPlotSnapshot( const QSizeF &sizeMM,
+        int resolution, Target = RasterTarget );
+
+    QwtPlotSnapshot( const QwtPlotSnapshot & );
+    virtual ~QwtPlotSnapshot();
+
+    QwtPlotSnapshot& operator=( const QwtPlotSnapshot & );
+
+    void reset();
+
+    bool isNull() const;
+    bool isEmpty() const;
+
+    Target target() const;
+    QSizeF sizeMM() const;
+    int resolution() const;
+
+    QRectF documentRect() const;
+
+    void setTitle( const QString & );
+    QString title() const;
+
+    void render( QPainter * ) const;
+
+    QImage toImage() const;
+
+    bool renderDocument( const QString &fileName ) const;
+    bool renderDocument( const QString &fileName,
+        const QString &format ) const;
+
+    static QVector<QImage> toImages( const QVector<QwtPlotSnapshot> & );
+
+    static QVector<bool> renderDocuments(
+        const QVector<QwtPlotSnapshot> &, const QStringList &fileNames );
+
+    virtual int metric( PaintDeviceMetric ) const QWT_OVERRIDE;
+
+protected:
+    virtual QSize sizeMetrics() const QWT_OVERRIDE;
+
+    virtual void drawRects( const QRect *, int ) QWT_OVERRIDE;
+    virtual void drawRects( const QRectF *, int ) QWT_OVERRIDE;
+
+    virtual void drawLines( const QLine *, int ) QWT_OVERRIDE;
+    virtual void drawLines( const QLineF *, int ) QWT_OVERRIDE;
+
+    virtual void drawEllipse( const QRectF & ) QWT_OVERRIDE;
+    virtual void drawEllipse( const QRect & ) QWT_OVERRIDE;
+
+    virtual void drawPath( const QPainterPath & ) QWT_OVERRIDE;
+
+    virtual void drawPoints( const QPointF *, int ) QWT_OVERRIDE;
+    virtual void drawPoints( const QPoint *, int ) QWT_OVERRIDE;
+
+    virtual void drawPolygon( const QPointF *, int,
+        QPaintEngine::PolygonDrawMode ) QWT_OVERRIDE;
+
+    virtual void drawPolygon( const QPoint *, int,
+        QPaintEngine::PolygonDrawMode ) QWT_OVERRIDE;
+
+    virtual void drawPixmap( const QRectF &,
+        const QPixmap &, const QRectF & ) QWT_OVERRIDE;
+
+    virtual void drawTextItem( const QPointF &,
+        const QTextItem & ) QWT_OVERRIDE;
+
+    virtual void drawTiledPixmap( const QRectF &,
+        const QPixmap &, const QPointF & ) QWT_OVERRIDE;
+
+    virtual void drawImage( const QRectF &, const QImage &,
+        const QRectF &, Qt::ImageConversionFlags ) QWT_OVERRIDE;
+
+    virtual void updateState( const QPaintEngineState & ) QWT_OVERRIDE;
+
+private:
+    class Command;
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -17,6 +17,7 @@
 #include <qimage.h>
 #include <qpen.h>
 #include <qpainter.h>
+#include <qmap.h>
 #include <qthread.h>
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
@@ -91,6 +92,24 @@ public:
 
     int maxRGBColorTableSize;
     QVector<QRgb> colorTable;
+
+    struct ContourCache
+    {
+        void invalidate()
+        {
+            area = QRectF();
+            raster = QSize();
+            lines.clear();
+            polylines.clear();
+        }
+
+        QRectF area;
+        QSize raster;
+        QwtRasterData::ContourLines lines;
+
+        // lines joined by the default implementation of drawContourLines()
+        QwtRasterData::ContourPolylines polylines;
+    } contourCache;
 };
 
 /*!
@@ -121,6 +140,26 @@ QwtPlotSpectrogram::~QwtPlotSpectrogram()
     delete d_data;
 }
 
+/*!
+   Invalidate the cache for the image and the contour lines
+
+   When the cache policy is QwtPlotRasterItem::PaintCache the contour lines
+   are cached in plot coordinates. They are recalculated, when the area or
+   the raster for the CONREC algorithm has changed - or after calling
+   invalidateCache(), what needs to be done, when the values of the
+   raster data have been modified.
+
+   The cache is also invalidated, when the cache policy is changed,
+   so that no contour lines are kept for QwtPlotRasterItem::NoCache.
+
+   \sa QwtPlotRasterItem::setCachePolicy()
+*/
+void QwtPlotSpectrogram::invalidateCache()
+{
+    QwtPlotRasterItem::invalidateCache();
+    d_data->contourCache.invalidate();
+}
+
 //! \return QwtPlotItem::Rtti_PlotSpectrogram
 int QwtPlotSpectrogram::rtti() const
 {
@@ -145,10 +184,10 @@ void QwtPlotSpectrogram::setDisplayMode( DisplayMode mode, bool on )
             d_data->displayMode |= mode;
         else
             d_data->displayMode &= ~mode;
-    }
 
-    legendChanged();
-    itemChanged();
+        legendChanged();
+        itemChanged();
+    }
 }
 
 /*!
@@ -309,6 +348,7 @@ void QwtPlotSpectrogram::setConrecFlag(
     else
         d_data->conrecFlags &= ~flag;
 
+    d_data->contourCache.invalidate();
     itemChanged();
 }
 
@@ -344,6 +384,8 @@ void QwtPlotSpectrogram::setContourLevels( const QList<double> &levels )
     d_data->contourLevels = levels;
     std::sort( d_data->contourLevels.begin(), d_data->contourLevels.end() );
 
+    d_data->contourCache.invalidate();
+
     legendChanged();
     itemChanged();
 }
@@ -551,66 +593,78 @@ void QwtPlotSpectrogram::renderTile(
 
     const bool hasGaps = !d_data->data->testAttribute( QwtRasterData::WithoutGaps );
 
-    if ( d_data->colorMap->format() == QwtColorMap::RGB )
-    {
-        const int numColors = d_data->colorTable.size();
-        const QRgb *rgbTable = d_data->colorTable.constData();
-        const QwtColorMap *colorMap = d_data->colorMap;
+    /*
+      The values are sampled in blocks of rows, so that the raster data
+      can retrieve them more efficiently, than one by one.
+     */
 
-        for ( int y = tile.top(); y <= tile.bottom(); y++ )
-        {
-            const double ty = yMap.invTransform( y );
+    const int numColumns = tile.width();
+    if ( numColumns <= 0 || tile.height() <= 0 )
+        return;
 
-            QRgb *line = reinterpret_cast<QRgb *>( image->scanLine( y ) );
-            line += tile.left();
+    QVector<double> xValues( numColumns );
+    for ( int i = 0; i < numColumns; i++ )
+        xValues[i] = xMap.invTransform( tile.left() + i );
 
-            for ( int x = tile.left(); x <= tile.right(); x++ )
-            {
-                const double tx = xMap.invTransform( x );
+    const int maxBlockSize = 65536;
+    const int numBlockRows = qBound( 1, maxBlockSize / numColumns, tile.height() );
 
-                const double value = d_data->data->value( tx, ty );
+    QVector<double> yValues( numBlockRows );
+    QVector<double> values( numBlockRows * numColumns );
 
-                if ( hasGaps && qwtIsNaN( value ) )
-                {
-                    *line++ = 0u;
-                }
-                else if ( numColors == 0 )
-                {
-                    *line++ = colorMap->rgb( range, value );
-                }
-                else
-                {
-                    const uint index = colorMap->colorIndex( numColors, range, value );
-                    *line++ = rgbTable[index];
-                }
-            }
-        }
-    }
-    else if ( d_data->colorMap->format() == QwtColorMap::Indexed )
+    const QwtColorMap *colorMap = d_data->colorMap;
+
+    const int numColors = d_data->colorTable.size();
+    const QRgb *rgbTable = d_data->colorTable.constData();
+
+    for ( int top = tile.top(); top <= tile.bottom(); top += numBlockRows )
     {
-        for ( int y = tile.top(); y <= tile.bottom(); y++ )
-        {
-            const double ty = yMap.invTransform( y );
+        const int numRows = qMin( numBlockRows, tile.bottom() - top + 1 );
 
-            unsigned char *line = image->scanLine( y );
-            line += tile.left();
+        for ( int i = 0; i < numRows; i++ )
+            yValues[i] = yMap.invTransform( top + i );
 
-            for ( int x = tile.left(); x <= tile.right(); x++ )
-            {
-                const double tx = xMap.invTransform( x );
+        d_data->data->values( xValues.constData(), numColumns,
+            yValues.constData(), numRows, values.data() );
 
-                const double value = d_data->data->value( tx, ty );
+        for ( int row = 0; row < numRows; row++ )
+        {
+            const double *v = values.constData() + row * numColumns;
+            const int y = top + row;
 
-                if ( hasGaps && qwtIsNaN( value ) )
+            if ( colorMap->format() == QwtColorMap::RGB )
+            {
+                QRgb *line = reinterpret_cast<QRgb *>( image->scanLine( y ) );
+                line += tile.left();
+
+                if ( numColors == 0 )
                 {
-                    *line++ = 0;
+                    colorMap->rgbValues( range, v, numColumns, line );
+                    continue;
                 }
-                else
+
+                for ( int i = 0; i < numColumns; i++ )
                 {
-                    const uint index = d_data->colorMap->colorIndex( 256, range, value );
-                    *line++ = static_cast<unsigned char>( index );
+                    const double value = v[i];
+
+                    if ( hasGaps && qwtIsNaN( value ) )
+                    {
+                        *line++ = 0u;
+                    }
+                    else
+                    {
+                        const uint index = colorMap->colorIndex( numColors, range, value );
+                        *line++ = rgbTable[index];
+                    }
                 }
             }
+            else if ( colorMap->format() == QwtColorMap::Indexed )
+            {
+                unsigned char *line = image->scanLine( y );
+                line += tile.left();
+
+                colorMap->colorIndexes( 256, range, v, numColumns, line );
+            }
         }
     }
 }
@@ -651,12 +705,17 @@ QSize QwtPlotSpectrogram::contourRasterSize(
 /*!
    Calculate contour lines
 
+   Like for the image the contour lines are calculated in several
+   threads, when the renderThreadCount() is not 1. Then the
+   non virtual QwtRasterData::contourLines() overload is used, that
+   divides the raster into bands.
+
    \param rect Rectangle, where to calculate the contour lines
    \param raster Raster, used by the CONREC algorithm
    \return Calculated contour lines
 
    \sa contourLevels(), setConrecFlag(),
-       QwtRasterData::contourLines()
+       QwtRasterData::contourLines(), QwtPlotItem::setRenderThreadCount()
 */
 QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
     const QRectF &rect, const QSize &raster ) const
@@ -664,8 +723,15 @@ QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
     if ( d_data->data == NULL )
         return QwtRasterData::ContourLines();
 
+    const uint numThreads = renderThreadCount();
+    if ( numThreads == 1 )
+    {
+        return d_data->data->contourLines( rect, raster,
+            d_data->contourLevels, d_data->conrecFlags );
+    }
+
     return d_data->data->contourLines( rect, raster,
-        d_data->contourLevels, d_data->conrecFlags );
+        d_data->contourLevels, d_data->conrecFlags, numThreads );
 }
 
 /*!
@@ -676,7 +742,13 @@ QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
    \param yMap Maps y-values into pixel coordinates.
    \param contourLines Contour lines
 
-   \sa renderContourLines(), defaultContourPen(), contourPen()
+   The default implementation joins the segments of the contour lines
+   to polylines and paints them using drawContourPolylines(). When the
+   contour lines are cached ( see QwtPlotRasterItem::PaintCache ) the
+   joined polylines are cached as well.
+
+   \sa renderContourLines(), defaultContourPen(), contourPen(),
+       QwtRasterData::joinedContourLines()
 */
 void QwtPlotSpectrogram::drawContourLines( QPainter *painter,
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -685,11 +757,52 @@ void QwtPlotSpectrogram::drawContourLines( QPainter *painter,
     if ( d_data->data == NULL )
         return;
 
+    PrivateData::ContourCache &cache = d_data->contourCache;
+
+    if ( &contourLines == &cache.lines )
+    {
+        // the lines from the cache, see draw()
+
+        if ( cache.polylines.isEmpty() )
+            cache.polylines = QwtRasterData::joinedContourLines( contourLines );
+
+        drawContourPolylines( painter, xMap, yMap, cache.polylines );
+    }
+    else
+    {
+        drawContourPolylines( painter, xMap, yMap,
+            QwtRasterData::joinedContourLines( contourLines ) );
+    }
+}
+
+/*!
+   Paint the contour lines, that have been joined to polylines
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param contourLines Contour lines
+
+   \sa renderContourLines(), QwtRasterData::joinedContourLines(),
+       defaultContourPen(), contourPen()
+*/
+void QwtPlotSpectrogram::drawContourPolylines( QPainter *painter,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QwtRasterData::ContourPolylines &contourLines ) const
+{
+    if ( d_data->data == NULL )
+        return;
+
     const int numLevels = d_data->contourLevels.size();
     for ( int l = 0; l < numLevels; l++ )
     {
         const double level = d_data->contourLevels[l];
 
+        QwtRasterData::ContourPolylines::const_iterator it =
+            contourLines.constFind( level );
+        if ( it == contourLines.constEnd() )
+            continue;
+
         QPen pen = defaultContourPen();
         if ( pen.style() == Qt::NoPen )
             pen = contourPen( level );
@@ -699,15 +812,19 @@ void QwtPlotSpectrogram::drawContourLines( QPainter *painter,
 
         painter->setPen( pen );
 
-        const QPolygonF &lines = contourLines[level];
-        for ( int i = 0; i < lines.size(); i += 2 )
+        const QVector<QPolygonF> &polylines = it.value();
+        for ( int i = 0; i < polylines.size(); i++ )
         {
-            const QPointF p1( xMap.transform( lines[i].x() ),
-                yMap.transform( lines[i].y() ) );
-            const QPointF p2( xMap.transform( lines[i+1].x() ),
-                yMap.transform( lines[i+1].y() ) );
+            const QPolygonF &polyline = polylines[i];
+
+            QPolygonF points( polyline.size() );
+            for ( int j = 0; j < polyline.size(); j++ )
+            {
+                points[j].rx() = xMap.transform( polyline[j].x() );
+                points[j].ry() = yMap.transform( polyline[j].y() );
+            }
 
-            QwtPainter::drawLine( painter, p1, p2 );
+            QwtPainter::drawPolyline( painter, points );
         }
     }
 }
@@ -753,10 +870,27 @@ void QwtPlotSpectrogram::draw( QPainter *painter,
         raster = raster.boundedTo( rasterRect.toRect().size() );
         if ( raster.isValid() )
         {
-            const QwtRasterData::ContourLines lines =
-                renderContourLines( area, raster );
+            if ( cachePolicy() == QwtPlotRasterItem::PaintCache )
+            {
+                PrivateData::ContourCache &cache = d_data->contourCache;
+                if ( cache.area != area || cache.raster != raster )
+                {
+                    cache.invalidate();
+
+                    cache.lines = renderContourLines( area, raster );
+                    cache.area = area;
+                    cache.raster = raster;
+                }
 
-            drawContourLines( painter, xMap, yMap, lines );
+                drawContourLines( painter, xMap, yMap, cache.lines );
+            }
+            else
+            {
+                const QwtRasterData::ContourLines lines =
+                    renderContourLines( area, raster );
+
+                drawContourLines( painter, xMap, yMap, lines );
+            }
         }
     }
 }
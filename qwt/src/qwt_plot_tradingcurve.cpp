@@ -15,6 +15,7 @@
 #include "qwt_math.h"
 
 #include <qpainter.h>
+#include <qvector.h>
 
 static inline bool qwtIsSampleInside( const QwtOHLCSample &sample,
     double tMin, double tMax, double vMin, double vMax )
@@ -28,6 +29,278 @@ static inline bool qwtIsSampleInside( const QwtOHLCSample &sample,
     return !isOffScreen;
 }
 
+namespace
+{
+    /*
+        Samples of the series, merged in groups of 2^level
+        consecutive samples
+     */
+    class MergedSample
+    {
+    public:
+        inline void init( const QwtOHLCSample &sample )
+        {
+            time1 = time2 = sample.time;
+
+            open = sample.open;
+            high = sample.high;
+            low = sample.low;
+            close = sample.close;
+        }
+
+        inline void merge( const MergedSample &other )
+        {
+            // other is following in time
+
+            time2 = other.time2;
+            close = other.close;
+
+            high = qwtMaxF( high, other.high );
+            low = qwtMinF( low, other.low );
+        }
+
+        double time1; // time of the first sample
+        double time2; // time of the last sample
+
+        double open;
+        double high;
+        double low;
+        double close;
+    };
+
+    class SamplePyramid
+    {
+    public:
+        void invalidate()
+        {
+            levels.clear();
+        }
+
+        bool isValid() const
+        {
+            return !levels.isEmpty();
+        }
+
+        void build( const QwtSeriesData<QwtOHLCSample> &series )
+        {
+            levels.clear();
+
+            const int numSamples = series.size();
+            if ( numSamples < 2 )
+                return;
+
+            // level 0 are the samples of the series, level k is stored at k - 1
+
+            QVector<MergedSample> merged( ( numSamples + 1 ) / 2 );
+            for ( int i = 0; i < merged.size(); i++ )
+            {
+                MergedSample &m = merged[i];
+                m.init( series.sample( 2 * i ) );
+
+                if ( 2 * i + 1 < numSamples )
+                {
+                    MergedSample next;
+                    next.init( series.sample( 2 * i + 1 ) );
+
+                    m.merge( next );
+                }
+            }
+
+            levels += merged;
+
+            while ( levels.last().size() > 1 )
+            {
+                const QVector<MergedSample> &lower = levels.last();
+
+                QVector<MergedSample> upper( ( lower.size() + 1 ) / 2 );
+                for ( int i = 0; i < upper.size(); i++ )
+                {
+                    upper[i] = lower[ 2 * i ];
+                    if ( 2 * i + 1 < lower.size() )
+                        upper[i].merge( lower[ 2 * i + 1 ] );
+                }
+
+                levels += upper;
+            }
+        }
+
+        QVector< QVector<MergedSample> > levels;
+    };
+
+    /*
+        Traverses the pyramid top down and merges all samples,
+        that are mapped into the same pixel column
+     */
+    class SampleAggregator
+    {
+    public:
+        SampleAggregator( const QwtSeriesData<QwtOHLCSample> &series,
+                const SamplePyramid &pyramid, const QwtScaleMap &timeMap,
+                int from, int to ):
+            d_series( series ),
+            d_pyramid( pyramid ),
+            d_timeMap( timeMap ),
+            d_from( from ),
+            d_to( to ),
+            d_hasBin( false )
+        {
+        }
+
+        QVector<QwtOHLCSample> aggregate()
+        {
+            const int topLevel = d_pyramid.levels.size();
+
+            for ( int i = d_from >> topLevel; i <= ( d_to >> topLevel ); i++ )
+                collect( topLevel, i );
+
+            flush();
+
+            return d_samples;
+        }
+
+    private:
+        inline int column( double time ) const
+        {
+            return qwtFloor( d_timeMap.transform( time ) );
+        }
+
+        void collect( int level, int index )
+        {
+            const qint64 first = qint64( index ) << level;
+            const qint64 last = ( qint64( index + 1 ) << level ) - 1;
+
+            if ( last < d_from || first > d_to )
+                return;
+
+            if ( level == 0 )
+            {
+                MergedSample sample;
+                sample.init( d_series.sample( index ) );
+
+                append( sample );
+                return;
+            }
+
+            if ( first >= d_from && last <= d_to )
+            {
+                const MergedSample &sample = d_pyramid.levels[ level - 1 ][ index ];
+                if ( column( sample.time1 ) == column( sample.time2 ) )
+                {
+                    append( sample );
+                    return;
+                }
+            }
+
+            collect( level - 1, 2 * index );
+            collect( level - 1, 2 * index + 1 );
+        }
+
+        void append( const MergedSample &sample )
+        {
+            const int col = column( sample.time1 );
+
+            if ( d_hasBin && col == d_column )
+            {
+                d_bin.merge( sample );
+                return;
+            }
+
+            flush();
+
+            d_bin = sample;
+            d_column = col;
+            d_hasBin = true;
+        }
+
+        void flush()
+        {
+            if ( !d_hasBin )
+                return;
+
+            double time = d_bin.time1;
+            if ( d_bin.time2 != d_bin.time1 )
+            {
+                const double pos = 0.5 * ( d_timeMap.transform( d_bin.time1 )
+                    + d_timeMap.transform( d_bin.time2 ) );
+
+                time = d_timeMap.invTransform( pos );
+            }
+
+            d_samples += QwtOHLCSample( time,
+                d_bin.open, d_bin.high, d_bin.low, d_bin.close );
+
+            d_hasBin = false;
+        }
+
+        const QwtSeriesData<QwtOHLCSample> &d_series;
+        const SamplePyramid &d_pyramid;
+        const QwtScaleMap &d_timeMap;
+
+        const int d_from;
+        const int d_to;
+
+        bool d_hasBin;
+        int d_column;
+        MergedSample d_bin;
+
+        QVector<QwtOHLCSample> d_samples;
+    };
+}
+
+static int qwtLowerTimeIndex( const QwtSeriesData<QwtOHLCSample> &series,
+    int from, int to, double time )
+{
+    // first index in [from, to + 1], with a time >= time
+
+    int index = from;
+    int n = to - from + 1;
+
+    while ( n > 0 )
+    {
+        const int half = n >> 1;
+        const int middle = index + half;
+
+        if ( series.sample( middle ).time < time )
+        {
+            index = middle + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+
+    return index;
+}
+
+static int qwtUpperTimeIndex( const QwtSeriesData<QwtOHLCSample> &series,
+    int from, int to, double time )
+{
+    // last index in [from - 1, to], with a time <= time
+
+    int index = from;
+    int n = to - from + 1;
+
+    while ( n > 0 )
+    {
+        const int half = n >> 1;
+        const int middle = index + half;
+
+        if ( series.sample( middle ).time <= time )
+        {
+            index = middle + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+
+    return index - 1;
+}
+
 class QwtPlotTradingCurve::PrivateData
 {
 public:
@@ -51,6 +324,8 @@ public:
     QBrush symbolBrush[2]; // Increasing/Decreasing
 
     QwtPlotTradingCurve::PaintAttributes paintAttributes;
+
+    SamplePyramid pyramid;
 };
 
 /*!
@@ -111,6 +386,9 @@ void QwtPlotTradingCurve::setPaintAttribute(
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    if ( attribute == AggregateSymbols && !on )
+        d_data->pyramid.invalidate();
 }
 
 /*!
@@ -456,14 +734,68 @@ void QwtPlotTradingCurve::drawSymbols( QPainter *painter,
     if ( doAlign )
         symbolWidth = std::floor( 0.5 * symbolWidth ) * 2.0;
 
+    {
+        /*
+          Symbols are partly visible, when their center is
+          inside of the canvas extended by half of the symbol width
+         */
+
+        const double margin = 0.5 * symbolWidth;
+
+        double p1, p2;
+        if ( orient == Qt::Vertical )
+        {
+            p1 = canvasRect.left() - margin;
+            p2 = canvasRect.right() + margin;
+        }
+        else
+        {
+            p1 = canvasRect.top() - margin;
+            p2 = canvasRect.bottom() + margin;
+        }
+
+        const double t1 = timeMap->invTransform( p1 );
+        const double t2 = timeMap->invTransform( p2 );
+
+        tMin = qwtMinF( t1, t2 );
+        tMax = qwtMaxF( t1, t2 );
+    }
+
     QPen pen = d_data->symbolPen;
     pen.setCapStyle( Qt::FlatCap );
 
     painter->setPen( pen );
 
+    QVector<QwtOHLCSample> aggregated;
+
+    const bool doAggregate = d_data->paintAttributes & AggregateSymbols;
+    if ( doAggregate )
+    {
+        const QwtSeriesData<QwtOHLCSample> &series = *data();
+
+        // reducing the range to the visible samples
+
+        from = qwtLowerTimeIndex( series, from, to, tMin );
+        to = qwtUpperTimeIndex( series, from, to, tMax );
+
+        if ( from > to )
+            return;
+
+        if ( !d_data->pyramid.isValid() )
+            d_data->pyramid.build( series );
+
+        SampleAggregator aggregator( series,
+            d_data->pyramid, *timeMap, from, to );
+
+        aggregated = aggregator.aggregate();
+
+        from = 0;
+        to = aggregated.size() - 1;
+    }
+
     for ( int i = from; i <= to; i++ )
     {
-        const QwtOHLCSample s = sample( i );
+        const QwtOHLCSample s = doAggregate ? aggregated[i] : sample( i );
 
         if ( !doClip || qwtIsSampleInside( s, tMin, tMax, vMin, vMax ) )
         {
@@ -630,6 +962,13 @@ void QwtPlotTradingCurve::drawCandleStick( QPainter *painter,
     }
 }
 
+//! Invalidate the pyramid of merged samples \sa AggregateSymbols
+void QwtPlotTradingCurve::dataChanged()
+{
+    d_data->pyramid.invalidate();
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
   \return A rectangle filled with the color of the symbol pen
 
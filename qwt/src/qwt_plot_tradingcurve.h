@@ -94,7 +94,21 @@ public:
     enum PaintAttribute
     {
         //! Check if a symbol is on the plot canvas before painting it.
-        ClipSymbols   = 0x01
+        ClipSymbols   = 0x01,
+
+        /*!
+          Consecutive samples, that are mapped into the same pixel column
+          are merged into one symbol: open of the first, close of the last
+          and the extremes of high/low.
+
+          Zooming is done by a multi-resolution pyramid of merged samples,
+          that is built, when painting for the first time. So the effort
+          depends on the number of visible symbols and not on the
+          size of the series.
+
+          \note The samples need to be ordered by time
+         */
+        AggregateSymbols = 0x02
     };
 
     //! Paint attributes
@@ -163,6 +177,8 @@ protected:
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect ) const;
 
+    virtual void dataChanged() QWT_OVERRIDE;
+
 private:
     class PrivateData;
     PrivateData *d_data;
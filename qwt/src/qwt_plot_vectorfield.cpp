@@ -18,9 +18,18 @@
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qvector.h>
+#include <qhash.h>
 #include <qdebug.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
 #include <cstdlib>
 
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
 #define DEBUG_RENDER 0
 
 #if DEBUG_RENDER
@@ -173,7 +182,7 @@ namespace
             if ( d_numRows > 1000 )
             {
                 d_dy = canvasRect.height() / 1000;
-                d_numRows = canvasRect.height() / d_dx + 1;
+                d_numRows = canvasRect.height() / d_dy + 1;
             }
 #endif
 
@@ -219,6 +228,30 @@ namespace
             return d_entries;
         }
 
+        void merge( const FilterMatrix &other )
+        {
+            // both matrices have been created from the same geometry
+
+            if ( d_entries == NULL || other.d_entries == NULL )
+                return;
+
+            const int numEntries = d_numRows * d_numColumns;
+            for ( int i = 0; i < numEntries; i++ )
+            {
+                const Entry &otherEntry = other.d_entries[i];
+                if ( otherEntry.count > 0 )
+                {
+                    Entry &entry = d_entries[i];
+
+                    entry.x += otherEntry.x;
+                    entry.y += otherEntry.y;
+                    entry.vx += otherEntry.vx;
+                    entry.vy += otherEntry.vy;
+                    entry.count += otherEntry.count;
+                }
+            }
+        }
+
     private:
         inline int indexOf( qreal x, qreal y ) const
         {
@@ -233,9 +266,131 @@ namespace
         int d_numRows;
 
         Entry* d_entries;
+
+        Q_DISABLE_COPY( FilterMatrix )
+    };
+
+    class MapCommand
+    {
+    public:
+        const QwtSeriesData<QwtVectorFieldSample> *series;
+        const QwtScaleMap *xMap;
+        const QwtScaleMap *yMap;
+
+        bool doAlign;
+        bool isInvertingX;
+        bool isInvertingY;
+
+        int from;
+        int to;
+
+        // one of them is set
+        FilterMatrix *matrix;
+        QVector<QwtVectorFieldSample> *arrows;
     };
 }
 
+static void qwtMapVectors( MapCommand command )
+{
+    const QwtSeriesData<QwtVectorFieldSample> *series = command.series;
+
+    if ( command.matrix )
+    {
+        for ( int i = command.from; i <= command.to; i++ )
+        {
+            const QwtVectorFieldSample sample = series->sample( i );
+            if ( !sample.isNull() )
+            {
+                command.matrix->addSample( command.xMap->transform( sample.x ),
+                    command.yMap->transform( sample.y ), sample.vx, sample.vy );
+            }
+        }
+
+        return;
+    }
+
+    QVector<QwtVectorFieldSample> &arrows = *command.arrows;
+    arrows.reserve( command.to - command.from + 1 );
+
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtVectorFieldSample sample = series->sample( i );
+
+        // arrows with zero length are never drawn
+        if ( sample.isNull() )
+            continue;
+
+        double xi = command.xMap->transform( sample.x );
+        double yi = command.yMap->transform( sample.y );
+
+        if ( command.doAlign )
+        {
+            xi = qRound( xi );
+            yi = qRound( yi );
+        }
+
+        arrows += QwtVectorFieldSample( xi, yi,
+            command.isInvertingX ? -sample.vx : sample.vx,
+            command.isInvertingY ? -sample.vy : sample.vy );
+    }
+}
+
+static inline void qwtAddArrow( QPainterPath &path,
+    const QPainterPath &symbolPath, double x, double y,
+    double sin, double cos, double dx )
+{
+    /*
+        Equivalent to painting the symbol with the transformation
+        of qwtSymbolTransformation() and translating it by dx,
+        but without any QTransform/QPainter overhead
+     */
+
+    const int numElements = symbolPath.elementCount();
+
+    for ( int i = 0; i < numElements; i++ )
+    {
+        const QPainterPath::Element &element = symbolPath.elementAt( i );
+
+        const double px = element.x + dx;
+        const double py = element.y;
+
+        const QPointF pos( x + cos * px - sin * py, y + sin * px + cos * py );
+
+        switch( element.type )
+        {
+            case QPainterPath::MoveToElement:
+            {
+                path.moveTo( pos );
+                break;
+            }
+            case QPainterPath::LineToElement:
+            {
+                path.lineTo( pos );
+                break;
+            }
+            case QPainterPath::CurveToElement:
+            {
+                QPointF points[2];
+                for ( int j = 0; j < 2; j++ )
+                {
+                    const QPainterPath::Element &e = symbolPath.elementAt( i + 1 + j );
+
+                    const double ex = e.x + dx;
+                    points[j] = QPointF( x + cos * ex - sin * e.y,
+                        y + sin * ex + cos * e.y );
+                }
+
+                path.cubicTo( pos, points[0], points[1] );
+                i += 2;
+
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
 class QwtPlotVectorField::PrivateData
 {
 public:
@@ -671,18 +826,33 @@ void QwtPlotVectorField::drawSeries( QPainter *painter,
 #endif
 }
 
+/*!
+  Draw the arrows of a subset of the samples
+
+  Mapping and - when FilterVectors is enabled - filtering of the samples
+  can be done in parallel ( see QwtPlotItem::setRenderThreadCount() ).
+  Then QwtSeriesData::sample() is called from worker threads and needs
+  to be thread safe.
+
+  When BatchSymbols is enabled and the symbol offers its geometry by
+  QwtVectorFieldSymbol::path() the arrows are collected into a few
+  paths - one for each color - otherwise drawSymbol() is called for
+  each arrow.
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas
+  \param from Index of the first sample to be painted
+  \param to Index of the last sample to be painted.
+*/
 void QwtPlotVectorField::drawSymbols( QPainter *painter,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
     const QRectF &canvasRect, int from, int to ) const
 {
-    const bool doAlign = QwtPainter::roundingAlignment( painter );
-    const bool doClip = false;
-
     const bool isInvertingX = xMap.isInverting();
     const bool isInvertingY = yMap.isInverting();
 
-    const QwtSeriesData<QwtVectorFieldSample> *series = data();
-
     if ( d_data->magnitudeModes & MagnitudeAsColor )
     {
         // user input error, can't draw without color map
@@ -696,7 +866,41 @@ void QwtPlotVectorField::drawSymbols( QPainter *painter,
         painter->setBrush( d_data->brush );
     }
 
-    if ( ( d_data->paintAttributes & FilterVectors ) && !d_data->rasterSize.isEmpty() )
+    const bool doFilter = ( d_data->paintAttributes & FilterVectors )
+        && !d_data->rasterSize.isEmpty();
+
+    MapCommand command;
+    command.series = data();
+    command.xMap = &xMap;
+    command.yMap = &yMap;
+    command.doAlign = QwtPainter::roundingAlignment( painter );
+    command.isInvertingX = isInvertingX;
+    command.isInvertingY = isInvertingY;
+    command.matrix = NULL;
+    command.arrows = NULL;
+
+    const int numSamples = to - from + 1;
+
+#if QWT_USE_THREADS
+    const int minSamplesPerThread = 50000;
+
+    int numThreads = static_cast<int>( renderThreadCount() );
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, numSamples / minSamplesPerThread );
+    if ( numThreads <= 0 )
+        numThreads = 1;
+#else
+    const int numThreads = 1;
+#endif
+
+    const int numSamplesPerThread = numSamples / numThreads;
+
+    QVector<FilterMatrix *> matrices;
+    QVector< QVector<QwtVectorFieldSample> > chunkArrows;
+
+    if ( doFilter )
     {
         const QRectF dataRect = QwtScaleMap::transform(
             xMap, yMap, boundingRect() );
@@ -706,7 +910,7 @@ void QwtPlotVectorField::drawSymbols( QPainter *painter,
         //       or "rastersize in plotcoordinetes" a user option?
 #if 1
         // define filter matrix based on screen/print coordinates
-        FilterMatrix matrix( dataRect, canvasRect, d_data->rasterSize );
+        const QSizeF rasterSize = d_data->rasterSize;
 #else
         // define filter matrix based on real coordinates
 
@@ -719,78 +923,296 @@ void QwtPlotVectorField::drawSymbols( QPainter *painter,
         if (yMap.sDist() != 0)
             yScale = yMap.pDist() / yMap.sDist();
 
-        QSizeF canvasRasterSize(xScale*d_data->rasterSize.width(), yScale*d_data->rasterSize.height());
-        FilterMatrix matrix( dataRect, canvasRect, canvasRasterSize );
+        const QSizeF rasterSize( xScale*d_data->rasterSize.width(),
+            yScale*d_data->rasterSize.height() );
+#endif
+
+        // each thread fills its own matrix, that are merged afterwards
+
+        matrices.resize( numThreads );
+        for ( int i = 0; i < numThreads; i++ )
+            matrices[i] = new FilterMatrix( dataRect, canvasRect, rasterSize );
+    }
+    else
+    {
+        chunkArrows.resize( numThreads );
+    }
+
+#if QWT_USE_THREADS
+    QVector< QFuture<void> > futures;
+    futures.reserve( numThreads - 1 );
+#endif
+
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        command.from = from + i * numSamplesPerThread;
+        command.to = ( i == numThreads - 1 )
+            ? to : command.from + numSamplesPerThread - 1;
+
+        if ( doFilter )
+            command.matrix = matrices[i];
+        else
+            command.arrows = &chunkArrows[i];
+
+#if QWT_USE_THREADS
+        if ( i < numThreads - 1 )
+        {
+            futures += QtConcurrent::run( &qwtMapVectors, command );
+            continue;
+        }
 #endif
+        qwtMapVectors( command );
+    }
 
-        for ( int i = from; i <= to; i++ )
+#if QWT_USE_THREADS
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+
+    // arrows in paint device coordinates
+
+    QVector<QwtVectorFieldSample> arrows;
+
+    if ( doFilter )
+    {
+        FilterMatrix *matrix = matrices[0];
+
+        for ( int i = 1; i < matrices.size(); i++ )
         {
-            const QwtVectorFieldSample sample = series->sample( i );
-            if ( !sample.isNull() )
+            matrix->merge( *matrices[i] );
+            delete matrices[i];
+        }
+
+        const int numEntries = matrix->numRows() * matrix->numColumns();
+        const FilterMatrix::Entry* entries = matrix->entries();
+
+        if ( entries )
+        {
+            for ( int i = 0; i < numEntries; i++ )
             {
-                matrix.addSample( xMap.transform( sample.x ),
-                    yMap.transform( sample.y ), sample.vx, sample.vy );
+                const FilterMatrix::Entry &entry = entries[i];
+
+                if ( entry.count == 0 )
+                    continue;
+
+                double xi = entry.x / entry.count;
+                double yi = entry.y / entry.count;
+
+                if ( command.doAlign )
+                {
+                    xi = qRound( xi );
+                    yi = qRound( yi );
+                }
+
+                const double vx = entry.vx / entry.count;
+                const double vy = entry.vy / entry.count;
+
+                arrows += QwtVectorFieldSample( xi, yi,
+                    isInvertingX ? -vx : vx, isInvertingY ? -vy : vy );
             }
         }
 
-        const int numEntries = matrix.numRows() * matrix.numColumns();
-        const FilterMatrix::Entry* entries = matrix.entries();
+        delete matrix;
+    }
+    else
+    {
+        if ( numThreads == 1 )
+        {
+            arrows = chunkArrows[0];
+        }
+        else
+        {
+            int numArrows = 0;
+            for ( int i = 0; i < numThreads; i++ )
+                numArrows += chunkArrows[i].size();
+
+            arrows.reserve( numArrows );
+            for ( int i = 0; i < numThreads; i++ )
+                arrows += chunkArrows[i];
+        }
+    }
+
+    chunkArrows.clear();
+
+    QwtVectorFieldSymbol *symbol = d_data->symbol;
 
-        for ( int i = 0; i < numEntries; i++ )
+    if ( !( d_data->paintAttributes & BatchSymbols )
+        || symbol->path().isEmpty() )
+    {
+        for ( int i = 0; i < arrows.size(); i++ )
         {
-            const FilterMatrix::Entry &entry = entries[i];
+            const QwtVectorFieldSample &arrow = arrows[i];
+            drawSymbol( painter, arrow.x, arrow.y, arrow.vx, arrow.vy );
+        }
+
+        return;
+    }
+
+    const int numArrows = arrows.size();
 
-            if ( entry.count == 0 )
-                continue;
+    QVector<double> magnitudes( numArrows );
+    for ( int i = 0; i < numArrows; i++ )
+        magnitudes[i] = qwtVector2Magnitude( arrows[i].vx, arrows[i].vy );
 
-            double xi = entry.x / entry.count;
-            double yi = entry.y / entry.count;
+    /*
+        The arrows are sorted by color, so that all arrows
+        of the same color can be painted with a single path.
+     */
+
+    QVector<int> order;
+    QVector<QRgb> groupColors;
+    QVector<int> groupEnds;
 
-            if ( doAlign )
+    if ( d_data->magnitudeModes & MagnitudeAsColor )
+    {
+        QwtInterval range = d_data->magnitudeRange;
+
+        if ( !range.isValid() )
+        {
+            if ( !d_data->boundingMagnitudeRange.isValid() )
+                d_data->boundingMagnitudeRange = qwtMagnitudeRange( data() );
+
+            range = d_data->boundingMagnitudeRange;
+        }
+
+        QVector<QRgb> rgbs( numArrows );
+        d_data->colorMap->rgbValues( range,
+            magnitudes.constData(), numArrows, rgbs.data() );
+
+        QHash<QRgb, int> groups;
+
+        QVector<int> groupIndexes( numArrows );
+        QVector<int> groupCounts;
+
+        for ( int i = 0; i < numArrows; i++ )
+        {
+            QHash<QRgb, int>::const_iterator it = groups.constFind( rgbs[i] );
+            if ( it == groups.constEnd() )
             {
-                xi = qRound( xi );
-                yi = qRound( yi );
+                it = groups.insert( rgbs[i], groupColors.size() );
+
+                groupColors += rgbs[i];
+                groupCounts += 0;
             }
 
-            const double vx = entry.vx / entry.count;
-            const double vy = entry.vy / entry.count;
+            groupIndexes[i] = it.value();
+            groupCounts[ it.value() ]++;
+        }
+
+        groupEnds.resize( groupCounts.size() );
 
-            drawSymbol( painter, xi, yi,
-                isInvertingX ? -vx : vx, isInvertingY ? -vy : vy );
+        QVector<int> offsets( groupCounts.size() );
+        for ( int g = 0, offset = 0; g < groupCounts.size(); g++ )
+        {
+            offsets[g] = offset;
+            offset += groupCounts[g];
+            groupEnds[g] = offset;
         }
+
+        order.resize( numArrows );
+        for ( int i = 0; i < numArrows; i++ )
+            order[ offsets[ groupIndexes[i] ]++ ] = i;
     }
     else
     {
-        for ( int i = from; i <= to; i++ )
+        order.resize( numArrows );
+        for ( int i = 0; i < numArrows; i++ )
+            order[i] = i;
+
+        groupEnds += numArrows;
+    }
+
+    // limiting the size of the paths keeps the memory usage low
+    const int maxArrowsPerPath = 10000;
+
+    QPainterPath path;
+
+    // overlapping arrows must not leave holes
+    path.setFillRule( Qt::WindingFill );
+
+    int groupStart = 0;
+    for ( int g = 0; g < groupEnds.size(); g++ )
+    {
+        if ( !groupColors.isEmpty() )
         {
-            const QwtVectorFieldSample sample = series->sample( i );
+            const QColor c = groupColors[g];
+
+            painter->setBrush( c );
+            painter->setPen( c );
+        }
+
+        int numPathArrows = 0;
+
+        for ( int k = groupStart; k < groupEnds[g]; k++ )
+        {
+            const int index = order[k];
+
+            const QwtVectorFieldSample &arrow = arrows[index];
+            const double magnitude = magnitudes[index];
+
+            double length = 0.0;
+            if ( d_data->magnitudeModes & MagnitudeAsLength )
+                length = arrowLength( magnitude );
 
-            // arrows with zero length are never drawn
-            if ( sample.isNull() )
-                continue;
+            symbol->setLength( length );
 
-            double xi = xMap.transform( sample.x );
-            double yi = yMap.transform( sample.y );
+            double dx = 0.0;
+            if ( d_data->indicatorOrigin == OriginTail )
+                dx = symbol->length();
+            else if ( d_data->indicatorOrigin == OriginCenter )
+                dx = 0.5 * symbol->length();
 
-            if ( doAlign )
+            double sin, cos;
+            if ( magnitude == 0.0 )
             {
-                xi = qRound( xi );
-                yi = qRound( yi );
+                // something
+                sin = 1.0;
+                cos = 0.0;
             }
+            else
+            {
+                sin = arrow.vy / magnitude;
+                cos = arrow.vx / magnitude;
+            }
+
+            // the path of the symbol is modified by the next setLength()
+            qwtAddArrow( path, symbol->path(), arrow.x, arrow.y, sin, cos, dx );
 
-            if ( doClip )
+            if ( ++numPathArrows >= maxArrowsPerPath )
             {
-                if ( !canvasRect.contains( xi, yi ) )
-                    continue;
+                painter->drawPath( path );
+
+                path = QPainterPath();
+                path.setFillRule( Qt::WindingFill );
+
+                numPathArrows = 0;
             }
+        }
+
+        if ( numPathArrows > 0 )
+        {
+            painter->drawPath( path );
 
-            drawSymbol( painter, xi, yi,
-                isInvertingX ? -sample.vx : sample.vx,
-                isInvertingY ? -sample.vy : sample.vy );
+            path = QPainterPath();
+            path.setFillRule( Qt::WindingFill );
         }
+
+        groupStart = groupEnds[g];
     }
 }
 
+/*!
+  Draw a single arrow
+
+  Used by drawSymbols() for each arrow, unless the arrows are
+  batched ( see BatchSymbols ).
+
+  \param painter Painter
+  \param x x coordinate of the arrow in paint device coordinates
+  \param y y coordinate of the arrow in paint device coordinates
+  \param vx x coordinate of the vector in paint device coordinates
+  \param vy y coordinate of the vector in paint device coordinates
+*/
 void QwtPlotVectorField::drawSymbol( QPainter *painter,
     double x, double y, double vx, double vy ) const
 {
@@ -36,7 +36,17 @@ public:
     enum PaintAttribute
     {
         FilterVectors        = 0x01,
-        LimitLength          = 0x02
+        LimitLength          = 0x02,
+
+        /*!
+          Collect the arrows into a few paths - one for each color -
+          instead of calling drawSymbol() for each arrow. This is
+          possible for symbols only, that offer their geometry
+          by QwtVectorFieldSymbol::path().
+
+          \note drawSymbol() is not called, when this attribute is enabled
+         */
+        BatchSymbols         = 0x04
     };
 
     //! Paint attributes
@@ -0,0 +1,514 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_waterfall.h"
+#include "qwt_color_map.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
+#include "qwt_text.h"
+
+#include <qpainter.h>
+#include <qimage.h>
+#include <qvector.h>
+
+#include <algorithm>
+
+class QwtPlotWaterfall::PrivateData
+{
+public:
+    PrivateData():
+        historyLength( 1000 ),
+        timeStep( 1.0 ),
+        numColumns( 0 ),
+        numRows( 0 ),
+        head( 0 ),
+        latestTime( 0.0 ),
+        isImageValid( false )
+    {
+        colorMap = new QwtLinearColorMap();
+    }
+
+    ~PrivateData()
+    {
+        delete colorMap;
+    }
+
+    inline int ringIndex( int row ) const
+    {
+        // row 0 is the oldest row
+        return ( head - numRows + row + historyLength ) % historyLength;
+    }
+
+    void renderRow( int ringRow ) const
+    {
+        const double *values = buffer.constData() + ringRow * numColumns;
+
+        if ( image.format() == QImage::Format_Indexed8 )
+        {
+            colorMap->colorIndexes( 256, valueInterval,
+                values, numColumns, image.scanLine( ringRow ) );
+        }
+        else
+        {
+            QRgb *line = reinterpret_cast<QRgb *>( image.scanLine( ringRow ) );
+            colorMap->rgbValues( valueInterval, values, numColumns, line );
+        }
+    }
+
+    void updateImage() const
+    {
+        if ( isImageValid )
+            return;
+
+        if ( colorMap->format() == QwtColorMap::Indexed )
+        {
+            image = QImage( numColumns, historyLength, QImage::Format_Indexed8 );
+            image.setColorTable( colorMap->colorTable256() );
+        }
+        else
+        {
+            image = QImage( numColumns, historyLength, QImage::Format_ARGB32 );
+        }
+
+        for ( int row = 0; row < numRows; row++ )
+            renderRow( ringIndex( row ) );
+
+        isImageValid = true;
+    }
+
+    QwtColorMap *colorMap;
+
+    QwtInterval columnInterval;
+    QwtInterval valueInterval;
+
+    int historyLength;
+    double timeStep;
+
+    // ring buffer of rows
+    QVector<double> buffer;
+    int numColumns;
+    int numRows;
+    int head;
+
+    double latestTime;
+
+    // the colors of the rows, organized like the ring buffer
+    mutable QImage image;
+    mutable bool isImageValid;
+};
+
+/*!
+   \brief Constructor
+
+   Sets the following item attributes:
+   - QwtPlotItem::AutoScale: true
+   - QwtPlotItem::Legend:    false
+
+   The z value is initialized by 8.0.
+
+   \param title Title
+
+   \sa QwtPlotItem::setItemAttribute(), QwtPlotItem::setZ()
+*/
+QwtPlotWaterfall::QwtPlotWaterfall( const QString &title ):
+    QwtPlotItem( QwtText( title ) )
+{
+    init();
+}
+
+/*!
+   \brief Constructor
+   \param title Title
+*/
+QwtPlotWaterfall::QwtPlotWaterfall( const QwtText &title ):
+    QwtPlotItem( title )
+{
+    init();
+}
+
+//! Destructor
+QwtPlotWaterfall::~QwtPlotWaterfall()
+{
+    delete d_data;
+}
+
+void QwtPlotWaterfall::init()
+{
+    d_data = new PrivateData();
+
+    setItemAttribute( QwtPlotItem::AutoScale, true );
+    setItemAttribute( QwtPlotItem::Legend, false );
+
+    setZ( 8.0 );
+}
+
+//! \return QwtPlotItem::Rtti_PlotWaterfall
+int QwtPlotWaterfall::rtti() const
+{
+    return QwtPlotItem::Rtti_PlotWaterfall;
+}
+
+/*!
+  Change the color map
+
+  Often it is useful to display the mapping between intensities and
+  colors as an additional plot axis, showing a color bar.
+
+  \param colorMap Color Map
+
+  \sa colorMap(), setValueInterval(), QwtScaleWidget::setColorBarEnabled(),
+      QwtScaleWidget::setColorMap()
+*/
+void QwtPlotWaterfall::setColorMap( QwtColorMap *colorMap )
+{
+    if ( colorMap == NULL )
+        return;
+
+    if ( colorMap != d_data->colorMap )
+    {
+        delete d_data->colorMap;
+        d_data->colorMap = colorMap;
+    }
+
+    d_data->isImageValid = false;
+    itemChanged();
+}
+
+/*!
+   \return Color Map used for mapping the values to colors
+   \sa setColorMap()
+*/
+const QwtColorMap *QwtPlotWaterfall::colorMap() const
+{
+    return d_data->colorMap;
+}
+
+/*!
+   \brief Set the interval of the columns
+
+   The columns of a row are distributed equidistantly over the interval
+   on the x axis.
+
+   \param interval Interval
+   \sa columnInterval(), setValueInterval()
+*/
+void QwtPlotWaterfall::setColumnInterval( const QwtInterval &interval )
+{
+    if ( interval != d_data->columnInterval )
+    {
+        d_data->columnInterval = interval;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Interval of the columns
+   \sa setColumnInterval()
+*/
+QwtInterval QwtPlotWaterfall::columnInterval() const
+{
+    return d_data->columnInterval;
+}
+
+/*!
+   \brief Set the interval of the values
+
+   The interval is used to map the values to colors.
+
+   \param interval Interval
+   \sa valueInterval(), setColorMap()
+*/
+void QwtPlotWaterfall::setValueInterval( const QwtInterval &interval )
+{
+    if ( interval != d_data->valueInterval )
+    {
+        d_data->valueInterval = interval;
+        d_data->isImageValid = false;
+
+        itemChanged();
+    }
+}
+
+/*!
+   \return Interval of the values
+   \sa setValueInterval()
+*/
+QwtInterval QwtPlotWaterfall::valueInterval() const
+{
+    return d_data->valueInterval;
+}
+
+/*!
+   \brief Limit the number of rows
+
+   When a row is appended to a full history the oldest one is dropped.
+   When reducing the history length the newest rows are kept.
+
+   \param numRows Maximum number of rows
+   \sa historyLength(), appendRow()
+*/
+void QwtPlotWaterfall::setHistoryLength( int numRows )
+{
+    numRows = qMax( numRows, 1 );
+    if ( numRows == d_data->historyLength )
+        return;
+
+    const int numKept = qMin( numRows, d_data->numRows );
+    const int numColumns = d_data->numColumns;
+
+    QVector<double> buffer( numRows * numColumns );
+
+    for ( int row = 0; row < numKept; row++ )
+    {
+        const int from = d_data->ringIndex( d_data->numRows - numKept + row );
+
+        const double *values = d_data->buffer.constData() + from * numColumns;
+        std::copy( values, values + numColumns, buffer.data() + row * numColumns );
+    }
+
+    d_data->buffer = buffer;
+    d_data->historyLength = numRows;
+    d_data->numRows = numKept;
+    d_data->head = numKept % numRows;
+
+    d_data->image = QImage();
+    d_data->isImageValid = false;
+
+    itemChanged();
+}
+
+/*!
+   \return Maximum number of rows
+   \sa setHistoryLength()
+*/
+int QwtPlotWaterfall::historyLength() const
+{
+    return d_data->historyLength;
+}
+
+/*!
+   \brief Set the time between 2 rows
+
+   \param timeStep Time step
+   \sa timeStep(), appendRow(), timeInterval()
+*/
+void QwtPlotWaterfall::setTimeStep( double timeStep )
+{
+    if ( timeStep > 0.0 && timeStep != d_data->timeStep )
+    {
+        d_data->timeStep = timeStep;
+        itemChanged();
+    }
+}
+
+/*!
+   \return Time between 2 rows
+   \sa setTimeStep()
+*/
+double QwtPlotWaterfall::timeStep() const
+{
+    return d_data->timeStep;
+}
+
+/*!
+   \brief Append a row
+
+   When the number of values differs from the number of columns of the
+   rows, that are already in the history, the history is cleared.
+
+   \param values Values of the row
+   \param numValues Number of values
+   \param time Time of the row
+
+   \sa clear(), setHistoryLength(), timeInterval()
+*/
+void QwtPlotWaterfall::appendRow(
+    const double *values, int numValues, double time )
+{
+    if ( numValues <= 0 )
+        return;
+
+    PrivateData *d = d_data;
+
+    if ( numValues != d->numColumns )
+    {
+        d->numColumns = numValues;
+        d->numRows = 0;
+        d->head = 0;
+
+        d->buffer.fill( 0.0, d->historyLength * numValues );
+
+        d->image = QImage();
+        d->isImageValid = false;
+    }
+
+    const int ringRow = d->head;
+    std::copy( values, values + numValues,
+        d->buffer.data() + ringRow * numValues );
+
+    d->head = ( d->head + 1 ) % d->historyLength;
+    if ( d->numRows < d->historyLength )
+        d->numRows++;
+
+    d->latestTime = time;
+
+    if ( d->isImageValid )
+        d->renderRow( ringRow );
+
+    itemChanged();
+}
+
+/*!
+   \brief Append a row
+
+   \param values Values of the row
+   \param time Time of the row
+
+   \sa clear(), setHistoryLength(), timeInterval()
+*/
+void QwtPlotWaterfall::appendRow( const QVector<double> &values, double time )
+{
+    appendRow( values.constData(), values.size(), time );
+}
+
+//! Remove all rows
+void QwtPlotWaterfall::clear()
+{
+    d_data->numRows = 0;
+    d_data->head = 0;
+    d_data->isImageValid = false;
+
+    itemChanged();
+}
+
+/*!
+   \return Number of rows in the history
+   \sa historyLength(), numColumns()
+*/
+int QwtPlotWaterfall::numRows() const
+{
+    return d_data->numRows;
+}
+
+/*!
+   \return Number of columns of a row
+   \sa numRows()
+*/
+int QwtPlotWaterfall::numColumns() const
+{
+    return d_data->numColumns;
+}
+
+/*!
+   \param row Index of the row, where 0 is the oldest row
+   \param column Index of the column
+   \return Value of the history, or NaN for an invalid position
+*/
+double QwtPlotWaterfall::value( int row, int column ) const
+{
+    if ( row < 0 || row >= d_data->numRows
+        || column < 0 || column >= d_data->numColumns )
+    {
+        return qQNaN();
+    }
+
+    const int ringRow = d_data->ringIndex( row );
+    return d_data->buffer[ ringRow * d_data->numColumns + column ];
+}
+
+/*!
+   \return Time interval covered by the rows in the history
+   \sa appendRow(), setTimeStep()
+*/
+QwtInterval QwtPlotWaterfall::timeInterval() const
+{
+    if ( d_data->numRows <= 0 )
+        return QwtInterval();
+
+    const double maxTime = d_data->latestTime + d_data->timeStep;
+    const double minTime = maxTime - d_data->numRows * d_data->timeStep;
+
+    return QwtInterval( minTime, maxTime );
+}
+
+//! \return Bounding rectangle of the columns and the time interval
+QRectF QwtPlotWaterfall::boundingRect() const
+{
+    const QwtInterval xInterval = d_data->columnInterval;
+    const QwtInterval yInterval = timeInterval();
+
+    if ( !( xInterval.isValid() && yInterval.isValid() ) )
+        return QwtPlotItem::boundingRect();
+
+    return QRectF( xInterval.minValue(), yInterval.minValue(),
+        xInterval.width(), yInterval.width() );
+}
+
+/*!
+  \brief Draw the waterfall
+
+  The rows have been translated into colors, when being appended.
+  As they are stored in a ring buffer, the image is painted in 2 parts:
+  the rows from the oldest one up to the end of the ring buffer and the
+  rows from the beginning of the ring buffer up to the newest one.
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rectangle of the canvas in painter coordinates
+*/
+void QwtPlotWaterfall::draw( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect ) const
+{
+    Q_UNUSED( canvasRect )
+
+    const PrivateData *d = d_data;
+
+    if ( d->numRows <= 0 || !d->columnInterval.isValid() )
+        return;
+
+    d->updateImage();
+
+    const double x1 = xMap.transform( d->columnInterval.minValue() );
+    const double x2 = xMap.transform( d->columnInterval.maxValue() );
+
+    const double t0 = timeInterval().minValue();
+
+    const int first = d->ringIndex( 0 );
+    const int numFirst = qMin( d->numRows, d->historyLength - first );
+
+    const int parts[2][3] =
+    {
+        // ring row, chronological row, number of rows
+        { first, 0, numFirst },
+        { 0, numFirst, d->numRows - numFirst }
+    };
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        const int count = parts[i][2];
+        if ( count <= 0 )
+            continue;
+
+        const double y1 = yMap.transform( t0 + parts[i][1] * d->timeStep );
+        const double y2 = yMap.transform( t0 + ( parts[i][1] + count ) * d->timeStep );
+
+        // a negative scale flips the image for inverted or upward scales
+
+        painter->save();
+        painter->translate( x1, y1 );
+        painter->scale( ( x2 - x1 ) / d->numColumns, ( y2 - y1 ) / count );
+
+        painter->drawImage( QPointF( 0.0, 0.0 ), d->image,
+            QRect( 0, parts[i][0], d->numColumns, count ) );
+
+        painter->restore();
+    }
+}
@@ -0,0 +1,94 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_WATERFALL_H
+#define QWT_PLOT_WATERFALL_H
+
+#include "qwt_global.h"
+#include "qwt_plot_item.h"
+
+#include <qstring.h>
+
+class QwtColorMap;
+class QwtInterval;
+template <typename T> class QVector;
+
+/*!
+  \brief A plot item, that displays a waterfall diagram
+
+  A waterfall diagram shows a history of rows - f.e. the spectrum of a signal,
+  that is calculated several times per second. The columns of a row
+  are mapped to the x axis and the rows to the time on the y axis. The values
+  are displayed according to a color map.
+
+  The rows are stored in a ring buffer with a limited history length.
+  Each row is translated into colors only once, when it is appended.
+  So the effort for an update is proportional to the size of a row and
+  not to the size of the history.
+
+  The times of the rows are assumed to be equidistant: the newest row is
+  located at the time, that has been passed to appendRow(), the previous
+  ones are located at multiples of timeStep() before.
+
+  \note The image of the rows is scaled to the canvas, what is only correct
+        for linear scales.
+
+  \sa QwtPlotSpectrogram
+*/
+class QWT_EXPORT QwtPlotWaterfall: public QwtPlotItem
+{
+public:
+    explicit QwtPlotWaterfall( const QString &title = QString() );
+    explicit QwtPlotWaterfall( const QwtText &title );
+
+    virtual ~QwtPlotWaterfall();
+
+    virtual int rtti() const QWT_OVERRIDE;
+
+    void setColorMap( QwtColorMap * );
+    const QwtColorMap *colorMap() const;
+
+    void setColumnInterval( const QwtInterval & );
+    QwtInterval columnInterval() const;
+
+    void setValueInterval( const QwtInterval & );
+    QwtInterval valueInterval() const;
+
+    void setHistoryLength( int numRows );
+    int historyLength() const;
+
+    void setTimeStep( double );
+    double timeStep() const;
+
+    void appendRow( const double *values, int numValues, double time );
+    void appendRow( const QVector<double> &values, double time );
+
+    void clear();
+
+    int numRows() const;
+    int numColumns() const;
+
+    double value( int row, int column ) const;
+
+    QwtInterval timeInterval() const;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual void draw( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect ) const QWT_OVERRIDE;
+
+private:
+    void init();
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
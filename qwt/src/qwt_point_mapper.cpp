@@ -28,6 +28,9 @@
 
 static QRectF qwtInvalidRect( 0.0, 0.0, -1.0, -1.0 );
 
+// limits the memory for filtering points by cells to 16MB
+static const double qwtMaxGridCells = 128.0 * 1024 * 1024;
+
 static inline int qwtRoundValue( double value )
 {
     return qRound( value );
@@ -181,6 +184,86 @@ namespace
 
         int y0, x1, xMin, xMax, x2;
     };
+
+    /*
+        Like QwtPolygonQuadrupelX/QwtPolygonQuadrupelY, but for
+        floating point coordinates: points are grouped by cells
+        of the size of the tolerance, but keep their positions
+     */
+    class QwtPolygonQuadrupelF
+    {
+    public:
+        QwtPolygonQuadrupelF( Qt::Orientation orientation, double tolerance ):
+            d_orientation( orientation ),
+            d_tolerance( tolerance )
+        {
+        }
+
+        inline void start( const QPointF &pos )
+        {
+            d_cell = cell( pos );
+            d_p1 = d_pMin = d_pMax = d_p2 = pos;
+        }
+
+        inline bool append( const QPointF &pos )
+        {
+            if ( cell( pos ) != d_cell )
+                return false;
+
+            const double v = value( pos );
+
+            if ( v < value( d_pMin ) )
+                d_pMin = pos;
+            else if ( v > value( d_pMax ) )
+                d_pMax = pos;
+
+            d_p2 = pos;
+
+            return true;
+        }
+
+        inline void flush( QPolygonF &polyline )
+        {
+            QPointF p1 = d_pMax;
+            QPointF p2 = d_pMin;
+
+            if ( value( d_p2 ) > value( d_p1 ) )
+                qSwap( p1, p2 );
+
+            polyline += d_p1;
+
+            if ( p1 != d_p1 )
+                polyline += p1;
+
+            if ( p2 != p1 )
+                polyline += p2;
+
+            if ( d_p2 != p2 )
+                polyline += d_p2;
+        }
+
+    private:
+        // the coordinate, that varies inside of a chunk
+        inline double value( const QPointF &pos ) const
+        {
+            return ( d_orientation == Qt::Vertical ) ? pos.y() : pos.x();
+        }
+
+        inline qint64 cell( const QPointF &pos ) const
+        {
+            const double v = ( d_orientation == Qt::Vertical ) ? pos.x() : pos.y();
+
+            // bounded to avoid overflows for points far outside
+            const double c = qBound( -1.0e15, v / d_tolerance, 1.0e15 );
+            return static_cast< qint64 >( std::floor( c ) );
+        }
+
+        const Qt::Orientation d_orientation;
+        const double d_tolerance;
+
+        qint64 d_cell;
+        QPointF d_p1, d_pMin, d_pMax, d_p2;
+    };
 }
 
 template <class Polygon, class Point, class PolygonQuadrupel>
@@ -278,6 +361,92 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap &xMap, const QwtScaleMap &yMa
     return polyline;
 }
 
+static QPolygonF qwtMapPointsQuadF(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    Qt::Orientation orientation, double tolerance )
+{
+    const QPointF sample0 = series->sample( from );
+
+    QwtPolygonQuadrupelF q( orientation, tolerance );
+    q.start( QPointF( xMap.transform( sample0.x() ),
+        yMap.transform( sample0.y() ) ) );
+
+    QPolygonF polyline;
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        const QPointF pos( xMap.transform( sample.x() ),
+            yMap.transform( sample.y() ) );
+
+        if ( !q.append( pos ) )
+        {
+            q.flush( polyline );
+            q.start( pos );
+        }
+    }
+    q.flush( polyline );
+
+    return polyline;
+}
+
+static QPolygonF qwtMapPointsQuadF( const QPolygonF &polyline,
+    Qt::Orientation orientation, double tolerance )
+{
+    const int numPoints = polyline.size();
+
+    if ( numPoints < 3 )
+        return polyline;
+
+    const QPointF *points = polyline.constData();
+
+    QPolygonF polylineXY;
+
+    QwtPolygonQuadrupelF q( orientation, tolerance );
+    q.start( points[0] );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        if ( !q.append( points[i] ) )
+        {
+            q.flush( polylineXY );
+            q.start( points[i] );
+        }
+    }
+    q.flush( polylineXY );
+
+    return polylineXY;
+}
+
+static QPolygonF qwtMapPointsQuadF(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, double tolerance )
+{
+    QPolygonF polyline;
+    if ( from > to )
+        return polyline;
+
+    const Qt::Orientation orientation = qwtProbeOrientation( series, from, to );
+
+    if ( orientation == Qt::Horizontal )
+    {
+        polyline = qwtMapPointsQuadF( xMap, yMap, series, from, to,
+            Qt::Horizontal, tolerance );
+
+        polyline = qwtMapPointsQuadF( polyline, Qt::Vertical, tolerance );
+    }
+    else
+    {
+        polyline = qwtMapPointsQuadF( xMap, yMap, series, from, to,
+            Qt::Vertical, tolerance );
+
+        polyline = qwtMapPointsQuadF( polyline, Qt::Horizontal, tolerance );
+    }
+
+    return polyline;
+}
+
 // Helper class to work around the 5 parameters
 // limitation of QtConcurrent::run()
 class QwtDotsCommand
@@ -531,15 +700,58 @@ static inline QPolygonF qwtToPointsFilteredF(
         boundingRect, xMap, yMap, series, from, to );
 }
 
+static QPolygonF qwtToPointsGridF(
+    const QRectF &boundingRect, double tolerance,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to )
+{
+    // Like qwtToPointsFiltered, but for cells of the size of the
+    // tolerance. The first point of each cell is kept unrounded.
+
+    const int numColumns = qwtCeil( boundingRect.width() / tolerance ) + 1;
+    const int numRows = qwtCeil( boundingRect.height() / tolerance ) + 1;
+
+    if ( double( numColumns ) * numRows > qwtMaxGridCells )
+    {
+        return qwtToPolylineFilteredF(
+            xMap, yMap, series, from, to, QwtNoRoundF() );
+    }
+
+    QwtPixelMatrix cellMatrix( QRect( 0, 0, numColumns, numRows ) );
+
+    QPolygonF points;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        const double x = xMap.transform( sample.x() );
+        const double y = yMap.transform( sample.y() );
+
+        if ( !boundingRect.contains( x, y ) )
+            continue;
+
+        const int col = qwtFloor( ( x - boundingRect.left() ) / tolerance );
+        const int row = qwtFloor( ( y - boundingRect.top() ) / tolerance );
+
+        if ( cellMatrix.testAndSetPixel( col, row, true ) == false )
+            points += QPointF( x, y );
+    }
+
+    return points;
+}
+
 class QwtPointMapper::PrivateData
 {
 public:
     PrivateData():
-        boundingRect( qwtInvalidRect )
+        boundingRect( qwtInvalidRect ),
+        tolerance( 0.0 )
     {
     }
 
     QRectF boundingRect;
+    double tolerance;
     QwtPointMapper::TransformationFlags flags;
 };
 
@@ -623,6 +835,41 @@ QRectF QwtPointMapper::boundingRect() const
     return d_data->boundingRect;
 }
 
+/*!
+  Set the tolerance for weeding out points without rounding
+
+  When RoundPoints is not set, points are mapped to floating
+  point coordinates and only exact duplicates can be removed.
+  A tolerance > 0.0 enables filtering by a grid of cells of
+  this size - usually the size of a pixel of the device, where
+  the points will be displayed.
+
+  - WeedOutIntermediatePoints & !RoundPoints
+    Consecutive points in the same column or row of cells are
+    reduced to 4 points ( toPolygonF() )
+
+  - WeedOutPoints & !RoundPoints & boundingRect().isValid()
+    Only the first point of each cell is mapped ( toPointsF() )
+
+  The default setting is 0.0 ( = disabled ).
+
+  \param tolerance Size of the cells in target coordinates
+  \sa tolerance(), setFlag()
+ */
+void QwtPointMapper::setTolerance( double tolerance )
+{
+    d_data->tolerance = qMax( tolerance, 0.0 );
+}
+
+/*!
+  \return Tolerance for weeding out points without rounding
+  \sa setTolerance()
+ */
+double QwtPointMapper::tolerance() const
+{
+    return d_data->tolerance;
+}
+
 /*!
   \brief Translate a series of points into a QPolygonF
 
@@ -634,7 +881,8 @@ QRectF QwtPointMapper::boundingRect() const
   when the further processing of the values need a QPolygonF.
 
   When RoundPoints & WeedOutIntermediatePoints is enabled an even more
-  aggressive weeding algorithm is enabled.
+  aggressive weeding algorithm is enabled. Without RoundPoints the same
+  algorithm is used for cells of the size of tolerance().
 
   \param xMap x map
   \param yMap y map
@@ -670,7 +918,13 @@ QPolygonF QwtPointMapper::toPolygonF(
     }
     else
     {
-        if ( d_data->flags & WeedOutPoints )
+        if ( ( d_data->flags & WeedOutIntermediatePoints )
+            && d_data->tolerance > 0.0 )
+        {
+            polyline = qwtMapPointsQuadF(
+                xMap, yMap, series, from, to, d_data->tolerance );
+        }
+        else if ( d_data->flags & WeedOutPoints )
         {
             polyline = qwtToPolylineFilteredF(
                 xMap, yMap, series, from, to, QwtNoRoundF() );
@@ -737,6 +991,11 @@ QPolygon QwtPointMapper::toPolygon(
     All consecutive points that are mapped to the same position
     will one point
 
+  - WeedOutPoints & !RoundPoints & tolerance() > 0.0 & boundingRect().isValid()
+    All points that are mapped to the same cell of the size
+    of the tolerance will be one point. Points outside of the
+    bounding rectangle are ignored.
+
   - WeedOutPoints & !RoundPoints
     All consecutive points that are mapped to the same position
     will one point
@@ -781,6 +1040,11 @@ QPolygonF QwtPointMapper::toPointsF(
                     xMap, yMap, series, from, to, QwtRoundF() );
             }
         }
+        else if ( d_data->tolerance > 0.0 && d_data->boundingRect.isValid() )
+        {
+            points = qwtToPointsGridF( d_data->boundingRect,
+                d_data->tolerance, xMap, yMap, series, from, to );
+        }
         else
         {
             // when rounding is not allowed we can't use
@@ -64,6 +64,11 @@ public:
 
           As the algorithm is fast it can be used inside of
           a polyline render cycle.
+
+          Without RoundPoints the points are grouped by cells of
+          the size of tolerance(), keeping their exact positions.
+
+          \sa setTolerance()
          */
         WeedOutIntermediatePoints = 0x04
     };
@@ -86,6 +91,9 @@ public:
     void setBoundingRect( const QRectF & );
     QRectF boundingRect() const;
 
+    void setTolerance( double );
+    double tolerance() const;
+
     QPolygonF toPolygonF( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
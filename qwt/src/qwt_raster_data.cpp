@@ -15,7 +15,18 @@
 #include <qpolygon.h>
 #include <qnumeric.h>
 #include <qlist.h>
+#include <qvector.h>
 #include <qmap.h>
+#include <qhash.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <cstring>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
 
 class QwtRasterData::ContourPlane
 {
@@ -271,90 +282,156 @@ QRectF QwtRasterData::pixelHint( const QRectF &area ) const
 }
 
 /*!
-   Calculate contour lines
-
-   \param rect Bounding rectangle for the contour lines
-   \param raster Number of data pixels of the raster data
-   \param levels List of limits, where to insert contour lines
-   \param flags Flags to customize the contouring algorithm
+   \brief Sample the values of a grid
+
+   values() is the block version of value() and is used when rendering
+   images or calculating contour lines. The default implementation
+   simply calls value() for each point of the grid.
+
+   Reimplementing values() might significantly improve the performance,
+   when the data can be retrieved more efficiently in blocks - f.e.
+   when rows can be calculated at once, or the values come from a cache
+   or a vectorized algorithm.
+
+   The coordinates of the grid are passed as arrays, so that the grid
+   can also be irregular, as for logarithmic scales.
+
+   \param xValues X coordinates of the grid columns, in plot coordinates
+   \param numX Number of columns
+   \param yValues Y coordinates of the grid rows, in plot coordinates
+   \param numY Number of rows
+   \param buffer Buffer of at least numX * numY values, where the values
+                 are stored row by row: buffer[ row * numX + column ]
+
+   \note Like value() the implementation needs to be thread safe,
+         as it is called from parallel threads
+   \sa value()
+*/
+void QwtRasterData::values( const double *xValues, int numX,
+    const double *yValues, int numY, double *buffer ) const
+{
+    for ( int row = 0; row < numY; row++ )
+    {
+        const double y = yValues[row];
 
-   \return Calculated contour lines
+        for ( int col = 0; col < numX; col++ )
+            *buffer++ = value( xValues[col], y );
+    }
+}
 
-   An adaption of CONREC, a simple contouring algorithm.
-   http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
-*/
-QwtRasterData::ContourLines QwtRasterData::contourLines(
-    const QRectF &rect, const QSize &raster,
-    const QList<double> &levels, ConrecFlags flags ) const
+namespace
 {
-    ContourLines contourLines;
+    class ContourCommand
+    {
+    public:
+        const QwtRasterData *data;
 
-    if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
-        return contourLines;
+        QRectF rect;
+        QSize raster;
 
-    const double dx = rect.width() / raster.width();
-    const double dy = rect.height() / raster.height();
+        const double *levels;
+        int numLevels;
 
-    const bool ignoreOnPlane =
-        flags & QwtRasterData::IgnoreAllVerticesOnLevel;
+        bool ignoreOnPlane;
+        bool ignoreOutOfRange;
+        QwtInterval range;
 
-    const QwtInterval range = interval( Qt::ZAxis );
-    bool ignoreOutOfRange = false;
-    if ( range.isValid() )
-        ignoreOutOfRange = flags & IgnoreOutOfRange;
+        // cells from the rows [ from, to ]
+        int from;
+        int to;
 
-    QwtRasterData *that = const_cast<QwtRasterData *>( this );
-    that->initRaster( rect, raster );
+        QVector<QPolygonF> *lines;
+    };
 
-    for ( int y = 0; y < raster.height() - 1; y++ )
+    class PointKey
     {
-        enum Position
+    public:
+        explicit inline PointKey( const QPointF &pos ):
+            // adding 0.0 normalizes -0.0 to 0.0
+            x( pos.x() + 0.0 ),
+            y( pos.y() + 0.0 )
         {
-            Center,
+        }
 
-            TopLeft,
-            TopRight,
-            BottomRight,
-            BottomLeft,
+        inline bool operator==( const PointKey &other ) const
+        {
+            return ( x == other.x ) && ( y == other.y );
+        }
 
-            NumPositions
-        };
+        double x;
+        double y;
+    };
 
-        QwtPoint3D xy[NumPositions];
+    inline uint qHash( const PointKey &key )
+    {
+        quint64 bx, by;
+        std::memcpy( &bx, &key.x, sizeof( bx ) );
+        std::memcpy( &by, &key.y, sizeof( by ) );
 
-        for ( int x = 0; x < raster.width() - 1; x++ )
-        {
-            const QPointF pos( rect.x() + x * dx, rect.y() + y * dy );
+        return ::qHash( bx ) ^ ( 31 * ::qHash( by ) );
+    }
+}
 
-            if ( x == 0 )
-            {
-                xy[TopRight].setX( pos.x() );
-                xy[TopRight].setY( pos.y() );
-                xy[TopRight].setZ(
-                    value( xy[TopRight].x(), xy[TopRight].y() )
-                );
-
-                xy[BottomRight].setX( pos.x() );
-                xy[BottomRight].setY( pos.y() + dy );
-                xy[BottomRight].setZ(
-                    value( xy[BottomRight].x(), xy[BottomRight].y() )
-                );
-            }
+static void qwtContourRows( const ContourCommand &command )
+{
+    enum Position
+    {
+        Center,
+
+        TopLeft,
+        TopRight,
+        BottomRight,
+        BottomLeft,
+
+        NumPositions
+    };
+
+    const QRectF &rect = command.rect;
+    const int numColumns = command.raster.width();
+
+    const double dx = rect.width() / command.raster.width();
+    const double dy = rect.height() / command.raster.height();
+
+    /*
+      The coordinates of the raster points are calculated once,
+      so that neighboured cells - even when being processed
+      in different bands - find exactly the same intersections.
+      This is important for joining the segments later.
+     */
 
-            xy[TopLeft] = xy[TopRight];
-            xy[BottomLeft] = xy[BottomRight];
+    QVector<double> xValues( numColumns );
+    for ( int x = 0; x < numColumns; x++ )
+        xValues[x] = rect.x() + x * dx;
 
-            xy[TopRight].setX( pos.x() + dx );
-            xy[TopRight].setY( pos.y() );
-            xy[BottomRight].setX( pos.x() + dx );
-            xy[BottomRight].setY( pos.y() + dy );
+    QVector<double> topValues( numColumns );
+    QVector<double> bottomValues( numColumns );
 
-            xy[TopRight].setZ(
-                value( xy[TopRight].x(), xy[TopRight].y() )
-            );
-            xy[BottomRight].setZ(
-                value( xy[BottomRight].x(), xy[BottomRight].y() )
-            );
+    double yTop = rect.y() + command.from * dy;
+    command.data->values( xValues.constData(), numColumns,
+        &yTop, 1, topValues.data() );
+
+    const double *levels = command.levels;
+    const int numLevels = command.numLevels;
+
+    QPolygonF *lines = command.lines->data();
+
+    for ( int y = command.from; y <= command.to; y++ )
+    {
+        const double yBottom = rect.y() + ( y + 1 ) * dy;
+        command.data->values( xValues.constData(), numColumns,
+            &yBottom, 1, bottomValues.data() );
+
+        const double *zTop = topValues.constData();
+        const double *zBottom = bottomValues.constData();
+
+        QwtPoint3D xy[NumPositions];
+
+        for ( int x = 0; x < numColumns - 1; x++ )
+        {
+            xy[TopLeft] = QwtPoint3D( xValues[x], yTop, zTop[x] );
+            xy[TopRight] = QwtPoint3D( xValues[x+1], yTop, zTop[x+1] );
+            xy[BottomRight] = QwtPoint3D( xValues[x+1], yBottom, zBottom[x+1] );
+            xy[BottomLeft] = QwtPoint3D( xValues[x], yBottom, zBottom[x] );
 
             double zMin = xy[TopLeft].z();
             double zMax = zMin;
@@ -377,30 +454,28 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
                 continue;
             }
 
-            if ( ignoreOutOfRange )
+            if ( command.ignoreOutOfRange )
             {
-                if ( !range.contains( zMin ) || !range.contains( zMax ) )
+                if ( !command.range.contains( zMin ) ||
+                    !command.range.contains( zMax ) )
+                {
                     continue;
+                }
             }
 
-            if ( zMax < levels[0] ||
-                zMin > levels[levels.size() - 1] )
-            {
+            if ( zMax < levels[0] || zMin > levels[numLevels - 1] )
                 continue;
-            }
 
-            xy[Center].setX( pos.x() + 0.5 * dx );
-            xy[Center].setY( pos.y() + 0.5 * dy );
-            xy[Center].setZ( 0.25 * zSum );
+            xy[Center] = QwtPoint3D( xValues[x] + 0.5 * dx,
+                yTop + 0.5 * dy, 0.25 * zSum );
 
-            const int numLevels = levels.size();
             for ( int l = 0; l < numLevels; l++ )
             {
                 const double level = levels[l];
                 if ( level < zMin || level > zMax )
                     continue;
-                QPolygonF &lines = contourLines[level];
-                const ContourPlane plane( level );
+
+                const QwtRasterData::ContourPlane plane( level );
 
                 QPointF line[2];
                 QwtPoint3D vertex[3];
@@ -412,18 +487,291 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
                     vertex[2] = xy[m != BottomLeft ? m + 1 : TopLeft];
 
                     const bool intersects =
-                        plane.intersect( vertex, line, ignoreOnPlane );
+                        plane.intersect( vertex, line, command.ignoreOnPlane );
                     if ( intersects )
                     {
-                        lines += line[0];
-                        lines += line[1];
+                        lines[l] += line[0];
+                        lines[l] += line[1];
                     }
                 }
             }
         }
+
+        qSwap( topValues, bottomValues );
+        yTop = yBottom;
+    }
+}
+
+static QVector<QPolygonF> qwtJoinedLines( const QPolygonF &lines )
+{
+    const int numSegments = lines.size() / 2;
+    const QPointF *points = lines.constData();
+
+    /*
+      Each segment has 2 ends: 2 * i and 2 * i + 1. Ends at the same
+      position are linked, what leads to chains of segments.
+     */
+
+    QVector<int> links( 2 * numSegments, -1 );
+    QVector<bool> visited( numSegments, false );
+
+    QHash<PointKey, int> openEnds;
+    openEnds.reserve( numSegments );
+
+    for ( int i = 0; i < numSegments; i++ )
+    {
+        if ( points[2 * i] == points[2 * i + 1] )
+        {
+            // degenerated segment
+            visited[i] = true;
+            continue;
+        }
+
+        for ( int j = 2 * i; j <= 2 * i + 1; j++ )
+        {
+            const PointKey key( points[j] );
+
+            QHash<PointKey, int>::iterator it = openEnds.find( key );
+            if ( it == openEnds.end() )
+            {
+                openEnds.insert( key, j );
+            }
+            else
+            {
+                links[j] = it.value();
+                links[it.value()] = j;
+
+                openEnds.erase( it );
+            }
+        }
+    }
+
+    QVector<QPolygonF> polylines;
+
+    /*
+      In a first pass we follow the chains from their open ends,
+      what leaves closed chains for the second pass.
+     */
+
+    for ( int pass = 0; pass < 2; pass++ )
+    {
+        for ( int end = 0; end < 2 * numSegments; end++ )
+        {
+            if ( visited[end / 2] )
+                continue;
+
+            if ( pass == 0 && links[end] >= 0 )
+                continue;
+
+            QPolygonF polyline;
+            polyline += points[end];
+
+            int current = end;
+            while ( true )
+            {
+                visited[current / 2] = true;
+
+                const int other = current ^ 1;
+                polyline += points[other];
+
+                const int next = links[other];
+                if ( next < 0 || visited[next / 2] )
+                    break;
+
+                current = next;
+            }
+
+            polylines += polyline;
+        }
+    }
+
+    return polylines;
+}
+
+/*!
+   Calculate contour lines
+
+   \param rect Bounding rectangle for the contour lines
+   \param raster Number of data pixels of the raster data
+   \param levels List of limits, where to insert contour lines
+   \param flags Flags to customize the contouring algorithm
+
+   \return Calculated contour lines
+
+   An adaption of CONREC, a simple contouring algorithm.
+   http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
+
+   The default implementation runs the algorithm in the calling thread.
+
+   \note The levels are expected to be sorted in increasing order
+   \sa joinedContourLines()
+*/
+QwtRasterData::ContourLines QwtRasterData::contourLines(
+    const QRectF &rect, const QSize &raster,
+    const QList<double> &levels, ConrecFlags flags ) const
+{
+    return contourLines( rect, raster, levels, flags, 1 );
+}
+
+/*!
+   Calculate contour lines in several threads
+
+   The raster is divided into horizontal bands, that are processed
+   in parallel. So value() and values() are called from worker
+   threads and need to be thread safe.
+
+   \param rect Bounding rectangle for the contour lines
+   \param raster Number of data pixels of the raster data
+   \param levels List of limits, where to insert contour lines
+   \param flags Flags to customize the contouring algorithm
+   \param numThreads Number of threads to be used, 0 means the
+                     number of cores of the system
+
+   \return Calculated contour lines
+
+   \note The levels are expected to be sorted in increasing order
+   \sa QwtPlotItem::setRenderThreadCount(), joinedContourLines()
+*/
+QwtRasterData::ContourLines QwtRasterData::contourLines(
+    const QRectF &rect, const QSize &raster, const QList<double> &levels,
+    ConrecFlags flags, uint numThreads ) const
+{
+    ContourLines contourLines;
+
+    if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
+        return contourLines;
+
+    const int numRows = raster.height() - 1;
+    if ( numRows <= 0 )
+        return contourLines;
+
+    const QVector<double> levelValues = levels.toVector();
+
+    ContourCommand command;
+    command.data = this;
+    command.rect = rect;
+    command.raster = raster;
+    command.levels = levelValues.constData();
+    command.numLevels = levelValues.size();
+    command.ignoreOnPlane = flags & QwtRasterData::IgnoreAllVerticesOnLevel;
+    command.range = interval( Qt::ZAxis );
+    command.ignoreOutOfRange = false;
+    if ( command.range.isValid() )
+        command.ignoreOutOfRange = flags & IgnoreOutOfRange;
+
+    QwtRasterData *that = const_cast<QwtRasterData *>( this );
+    that->initRaster( rect, raster );
+
+#if QWT_USE_THREADS
+    int threadCount = static_cast<int>( numThreads );
+    if ( threadCount == 0 )
+        threadCount = QThread::idealThreadCount();
+
+    const int minRowsPerThread = 32;
+
+    threadCount = qMin( threadCount, numRows / minRowsPerThread );
+    if ( threadCount <= 0 )
+        threadCount = 1;
+#else
+    Q_UNUSED( numThreads )
+    const int threadCount = 1;
+#endif
+
+    QVector< QVector<QPolygonF> > bandLines( threadCount );
+
+    const int numRowsPerThread = numRows / threadCount;
+
+#if QWT_USE_THREADS
+    QVector< QFuture<void> > futures;
+    futures.reserve( threadCount - 1 );
+#endif
+
+    for ( int i = 0; i < threadCount; i++ )
+    {
+        bandLines[i].resize( command.numLevels );
+
+        command.from = i * numRowsPerThread;
+        command.to = ( i == threadCount - 1 )
+            ? numRows - 1 : command.from + numRowsPerThread - 1;
+        command.lines = &bandLines[i];
+
+#if QWT_USE_THREADS
+        if ( i < threadCount - 1 )
+        {
+            futures += QtConcurrent::run( &qwtContourRows, command );
+            continue;
+        }
+#endif
+        qwtContourRows( command );
     }
 
+#if QWT_USE_THREADS
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+
     that->discardRaster();
 
+    for ( int l = 0; l < command.numLevels; l++ )
+    {
+        int numPoints = 0;
+        for ( int i = 0; i < threadCount; i++ )
+            numPoints += bandLines[i][l].size();
+
+        if ( numPoints == 0 )
+            continue;
+
+        QPolygonF &lines = contourLines[ levelValues[l] ];
+        lines.reserve( numPoints );
+
+        for ( int i = 0; i < threadCount; i++ )
+            lines += bandLines[i][l];
+    }
+
     return contourLines;
 }
+
+/*!
+   \brief Join contour lines to polylines
+
+   The segments of each level, as being returned from contourLines(),
+   are connected to polylines - closed ones for contours, that
+   are completely inside of the raster. Drawing the polylines is
+   significantly faster than drawing the segments one by one.
+
+   \param contourLines Segments of the contour lines,
+                       as being returned from contourLines()
+
+   \return Polylines for each level
+   \sa contourLines()
+*/
+QwtRasterData::ContourPolylines QwtRasterData::joinedContourLines(
+    const ContourLines &contourLines )
+{
+    ContourPolylines polylines;
+
+#if QWT_USE_THREADS
+    QList< QFuture< QVector<QPolygonF> > > futures;
+
+    for ( ContourLines::const_iterator it = contourLines.constBegin();
+        it != contourLines.constEnd(); ++it )
+    {
+        futures += QtConcurrent::run( &qwtJoinedLines, it.value() );
+    }
+
+    int i = 0;
+    for ( ContourLines::const_iterator it = contourLines.constBegin();
+        it != contourLines.constEnd(); ++it )
+    {
+        polylines.insert( it.key(), futures[i++].result() );
+    }
+#else
+    for ( ContourLines::const_iterator it = contourLines.constBegin();
+        it != contourLines.constEnd(); ++it )
+    {
+        polylines.insert( it.key(), qwtJoinedLines( it.value() ) );
+    }
+#endif
+
+    return polylines;
+}
@@ -18,6 +18,7 @@ class QPolygonF;
 class QRectF;
 class QSize;
 template <typename T> class QList;
+template <typename T> class QVector;
 template <class Key, class T> class QMap;
 
 /*!
@@ -45,6 +46,9 @@ public:
     //! Contour lines
     typedef QMap<double, QPolygonF> ContourLines;
 
+    //! Contour lines, joined to polylines
+    typedef QMap< double, QVector<QPolygonF> > ContourPolylines;
+
     /*!
       \brief Raster data attributes
 
@@ -111,10 +115,19 @@ public:
     */
     virtual double value( double x, double y ) const = 0;
 
+    virtual void values( const double *xValues, int numX,
+        const double *yValues, int numY, double *buffer ) const;
+
     virtual ContourLines contourLines( const QRectF &rect,
         const QSize &raster, const QList<double> &levels,
         ConrecFlags ) const;
 
+    ContourLines contourLines( const QRectF &rect,
+        const QSize &raster, const QList<double> &levels,
+        ConrecFlags, uint numThreads ) const;
+
+    static ContourPolylines joinedContourLines( const ContourLines & );
+
     class Contour3DPoint;
     class ContourPlane;
 
@@ -0,0 +1,235 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_scale_label_cache.h"
+#include "qwt_text.h"
+
+#include <qcache.h>
+#include <qmap.h>
+#include <qatomic.h>
+#include <qstring.h>
+
+#include <cstring>
+
+/*
+   A label returned from find() or insert() must not be removed,
+   when inserting the next one. So we need a minimum size
+ */
+static const int qwtMinCacheSize = 16;
+
+namespace
+{
+    class LabelKey
+    {
+    public:
+        LabelKey( int id, double v ):
+            formatId( id ),
+            value( ( v == 0.0 ) ? 0.0 : v ) // -0.0 and 0.0 have the same label
+        {
+        }
+
+        inline bool operator==( const LabelKey &other ) const
+        {
+            return formatId == other.formatId && value == other.value;
+        }
+
+        int formatId;
+        double value;
+    };
+
+    inline uint qHash( const LabelKey &key )
+    {
+        quint64 bits;
+        std::memcpy( &bits, &key.value, sizeof( bits ) );
+
+        return ::qHash( bits ) ^ uint( key.formatId );
+    }
+}
+
+class QwtScaleLabelCache::PrivateData
+{
+public:
+    explicit PrivateData( int maxSize ):
+        ref( 1 )
+    {
+        labels.setMaxCost( maxSize );
+    }
+
+    QAtomicInt ref;
+    QCache<LabelKey, QwtText> labels;
+
+    QMap<QString, int> formatIds;
+};
+
+/*!
+  Constructor
+
+  \param maxSize Maximum number of labels
+  \sa setMaxSize()
+*/
+QwtScaleLabelCache::QwtScaleLabelCache( int maxSize )
+{
+    d_data = new PrivateData( qMax( maxSize, qwtMinCacheSize ) );
+}
+
+/*!
+  Copy constructor
+
+  The copy refers to the same labels
+  \param other Other cache
+*/
+QwtScaleLabelCache::QwtScaleLabelCache( const QwtScaleLabelCache &other ):
+    d_data( other.d_data )
+{
+    d_data->ref.ref();
+}
+
+//! Destructor
+QwtScaleLabelCache::~QwtScaleLabelCache()
+{
+    if ( !d_data->ref.deref() )
+        delete d_data;
+}
+
+/*!
+  Assignment operator
+
+  After the assignment both caches refer to the same labels
+  \param other Other cache
+  \return Reference to the cache
+*/
+QwtScaleLabelCache &QwtScaleLabelCache::operator=(
+    const QwtScaleLabelCache &other )
+{
+    if ( d_data != other.d_data )
+    {
+        other.d_data->ref.ref();
+
+        if ( !d_data->ref.deref() )
+            delete d_data;
+
+        d_data = other.d_data;
+    }
+
+    return *this;
+}
+
+//! \return true, when both caches refer to the same labels
+bool QwtScaleLabelCache::operator==( const QwtScaleLabelCache &other ) const
+{
+    return d_data == other.d_data;
+}
+
+//! \return true, when the caches refer to different labels
+bool QwtScaleLabelCache::operator!=( const QwtScaleLabelCache &other ) const
+{
+    return d_data != other.d_data;
+}
+
+/*!
+  Set the maximum number of labels
+
+  The default setting is 1000 labels, the minimum is 16.
+
+  \param maxSize Maximum number of labels
+  \sa maxSize()
+*/
+void QwtScaleLabelCache::setMaxSize( int maxSize )
+{
+    d_data->labels.setMaxCost( qMax( maxSize, qwtMinCacheSize ) );
+}
+
+/*!
+  \return Maximum number of labels
+  \sa setMaxSize(), size()
+*/
+int QwtScaleLabelCache::maxSize() const
+{
+    return d_data->labels.maxCost();
+}
+
+/*!
+  \return Number of labels in the cache
+  \sa maxSize()
+*/
+int QwtScaleLabelCache::size() const
+{
+    return d_data->labels.size();
+}
+
+/*!
+  Remove all labels
+
+  The ids of the label formats remain valid.
+*/
+void QwtScaleLabelCache::clear()
+{
+    d_data->labels.clear();
+}
+
+/*!
+  Find the id of a label format
+
+  A new id is assigned, when the format key has not been used before.
+  All copies of the cache use the same ids.
+
+  \param formatKey Key of the label format
+  \return Id of the label format
+
+  \sa QwtAbstractScaleDraw::labelFormatKey()
+*/
+int QwtScaleLabelCache::formatId( const QString &formatKey )
+{
+    QMap<QString, int>::const_iterator it =
+        d_data->formatIds.constFind( formatKey );
+
+    if ( it != d_data->formatIds.constEnd() )
+        return it.value();
+
+    const int id = d_data->formatIds.size();
+    d_data->formatIds.insert( formatKey, id );
+
+    return id;
+}
+
+/*!
+  Find a label
+
+  \param formatId Id of the label format
+  \param value Value of the tick
+
+  \return Label or NULL, when the label is not in the cache
+
+  \note The label might be removed, when other labels are inserted
+  \sa formatId()
+*/
+const QwtText *QwtScaleLabelCache::find( int formatId, double value ) const
+{
+    return d_data->labels.object( LabelKey( formatId, value ) );
+}
+
+/*!
+  Insert a label
+
+  \param formatId Id of the label format
+  \param value Value of the tick
+  \param label Label
+
+  \return Label in the cache
+  \note The label might be removed, when other labels are inserted
+  \sa formatId()
+*/
+const QwtText *QwtScaleLabelCache::insert(
+    int formatId, double value, const QwtText &label )
+{
+    QwtText *text = new QwtText( label );
+    d_data->labels.insert( LabelKey( formatId, value ), text );
+
+    return text;
+}
@@ -0,0 +1,77 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_SCALE_LABEL_CACHE_H
+#define QWT_SCALE_LABEL_CACHE_H
+
+#include "qwt_global.h"
+
+class QwtText;
+class QString;
+
+/*!
+  \brief A bounded cache for tick labels
+
+  QwtScaleLabelCache stores the tick labels of a scale draw together
+  with their sizes. The labels are identified by the value of the tick
+  and the id of the label format, that is registered once for each
+  key returned by QwtAbstractScaleDraw::labelFormatKey(). When the cache
+  is full, the labels that have not
+  been used for the longest time are removed. When the cache is
+  persistent ( see QwtAbstractScaleDraw::setLabelCachePersistent() )
+  the labels of a scrolling axis are created only once, when they
+  become visible.
+
+  QwtScaleLabelCache is explicitly shared: copies of a cache refer to
+  the same labels. Scale draws, that create identical labels for the
+  same values can share their labels:
+
+  \code
+    QwtDateScaleDraw *scaleDraw1 = new QwtDateScaleDraw();
+    QwtDateScaleDraw *scaleDraw2 = new QwtDateScaleDraw();
+
+    scaleDraw1->setLabelCachePersistent( true );
+    scaleDraw2->setLabelCachePersistent( true );
+
+    scaleDraw2->setLabelCache( scaleDraw1->labelCache() );
+  \endcode
+
+  \sa QwtAbstractScaleDraw::setLabelCache(),
+      QwtAbstractScaleDraw::labelFormatKey()
+*/
+class QWT_EXPORT QwtScaleLabelCache
+{
+public:
+    explicit QwtScaleLabelCache( int maxSize = 1000 );
+    QwtScaleLabelCache( const QwtScaleLabelCache & );
+
+    ~QwtScaleLabelCache();
+
+    QwtScaleLabelCache &operator=( const QwtScaleLabelCache & );
+
+    bool operator==( const QwtScaleLabelCache & ) const;
+    bool operator!=( const QwtScaleLabelCache & ) const;
+
+    void setMaxSize( int );
+    int maxSize() const;
+
+    int size() const;
+    void clear();
+
+    int formatId( const QString &formatKey );
+
+    const QwtText *find( int formatId, double value ) const;
+    const QwtText *insert( int formatId, double value, const QwtText & );
+
+private:
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
@@ -23,6 +23,7 @@
 #include <qstyleoption.h>
 #include <qapplication.h>
 #include <qmargins.h>
+#include <qpixmap.h>
 
 class QwtScaleWidget::PrivateData
 {
@@ -58,7 +59,27 @@ public:
         int width;
         QwtInterval interval;
         QwtColorMap *colorMap;
+
+        /*
+          incremented, whenever the color map is (re)assigned
+          or the transformation of the scale changes
+         */
+        uint revision;
     } colorBar;
+
+    /*
+      The rendered color bar of the last paint event and
+      the parameters it depends on
+     */
+    struct t_colorBarCache
+    {
+        QPixmap pixmap;
+
+        uint revision;
+        QRectF rect;
+        Qt::Orientation orientation;
+        double s1, s2;
+    } colorBarCache;
 };
 
 /*!
@@ -116,6 +137,7 @@ void QwtScaleWidget::initScale( QwtScaleDraw::Alignment align )
     d_data->colorBar.colorMap = new QwtLinearColorMap();
     d_data->colorBar.isEnabled = false;
     d_data->colorBar.width = 10;
+    d_data->colorBar.revision = 0;
 
     const int flags = Qt::AlignHCenter
         | Qt::TextExpandTabs | Qt::TextWordWrap;
@@ -345,6 +367,8 @@ void QwtScaleWidget::setScaleDraw( QwtScaleDraw *scaleDraw )
     delete d_data->scaleDraw;
     d_data->scaleDraw = scaleDraw;
 
+    d_data->colorBar.revision++;
+
     layoutScale();
 }
 
@@ -618,6 +642,13 @@ void QwtScaleWidget::layoutScale( bool update_geometry )
 /*!
   Draw the color bar of the scale widget
 
+  When painting to the widget itself the color bar is rendered to
+  a cached pixmap, that is reused until setColorMap(), setTransformation()
+  or setScaleDraw() are called or the geometry of the scale changes.
+
+  Modifications of a color map, that has already been passed
+  to setColorMap(), need to be indicated by assigning it again.
+
   \param painter Painter
   \param rect Bounding rectangle for the color bar
 
@@ -629,10 +660,56 @@ void QwtScaleWidget::drawColorBar( QPainter *painter, const QRectF& rect ) const
         return;
 
     const QwtScaleDraw* sd = d_data->scaleDraw;
+    const QwtInterval interval = d_data->colorBar.interval.normalized();
+
+    if ( painter->device() != this )
+    {
+        // f.e. QwtPlotRenderer: no caching for other devices
+
+        QwtPainter::drawColorBar( painter, *d_data->colorBar.colorMap,
+            interval, sd->scaleMap(), sd->orientation(), rect );
 
-    QwtPainter::drawColorBar( painter, *d_data->colorBar.colorMap,
-        d_data->colorBar.interval.normalized(), sd->scaleMap(),
-        sd->orientation(), rect );
+        return;
+    }
+
+    /*
+      Mapping the values and painting the color bar is done
+      in advance, when the color map, its interval, the geometry
+      or the scale have changed. Otherwise - f.e. for a replot of
+      the plot canvas - the cached pixmap is painted only.
+     */
+
+    const QwtScaleMap &scaleMap = sd->scaleMap();
+
+    PrivateData::t_colorBarCache &cache = d_data->colorBarCache;
+
+    const bool isValid = !cache.pixmap.isNull()
+        && cache.revision == d_data->colorBar.revision
+        && cache.rect == rect
+        && cache.orientation == sd->orientation()
+        && cache.s1 == scaleMap.s1() && cache.s2 == scaleMap.s2();
+
+    if ( !isValid )
+    {
+        const QRect devRect = rect.toAlignedRect();
+
+        cache.pixmap = QPixmap( devRect.size() );
+        cache.pixmap.fill( Qt::transparent );
+
+        QPainter pmPainter( &cache.pixmap );
+        QwtPainter::drawColorBar( &pmPainter, *d_data->colorBar.colorMap,
+            interval, scaleMap, sd->orientation(),
+            rect.translated( -devRect.topLeft() ) );
+        pmPainter.end();
+
+        cache.revision = d_data->colorBar.revision;
+        cache.rect = rect;
+        cache.orientation = sd->orientation();
+        cache.s1 = scaleMap.s1();
+        cache.s2 = scaleMap.s2();
+    }
+
+    QwtPainter::drawPixmap( painter, rect, cache.pixmap );
 }
 
 /*!
@@ -886,6 +963,8 @@ void QwtScaleWidget::setScaleDiv( const QwtScaleDiv &scaleDiv )
 void QwtScaleWidget::setTransformation( QwtTransform *transformation )
 {
     d_data->scaleDraw->setTransformation( transformation );
+    d_data->colorBar.revision++;
+
     layoutScale();
 }
 
@@ -952,7 +1031,10 @@ QwtInterval QwtScaleWidget::colorBarInterval() const
   \param interval Value interval
   \param colorMap Color map
 
-  \sa colorMap(), colorBarInterval()
+  \note Passing the same color map again forces a repaint of the
+        cached color bar, what is necessary after modifying the
+        color map, f.e. with QwtLinearColorMap::addColorStop().
+  \sa colorMap(), colorBarInterval(), drawColorBar()
 */
 void QwtScaleWidget::setColorMap(
     const QwtInterval &interval, QwtColorMap *colorMap )
@@ -965,6 +1047,12 @@ void QwtScaleWidget::setColorMap(
         d_data->colorBar.colorMap = colorMap;
     }
 
+    /*
+      The color map might have been modified, even
+      when being the same object
+     */
+    d_data->colorBar.revision++;
+
     if ( isColorBarEnabled() )
         layoutScale();
 }
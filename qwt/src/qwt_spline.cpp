@@ -13,6 +13,79 @@
 #include "qwt_bezier.h"
 
 #include <qpainterpath.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <algorithm>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    // a Bezier curve and the equidistant parameter values on it
+    class EquidistantSegment
+    {
+    public:
+        QPointF p1;
+        QPointF cp1;
+        QPointF cp2;
+        QPointF p2;
+
+        double length;  // parameter increment between p1 and p2
+        double t;       // first parameter value
+
+        int count;      // number of interpolated points
+        int offset;     // position of the first point in the polygon
+        bool hasNode;   // p2 has to be appended
+    };
+}
+
+static inline int qwtEquidistantCount( double t, double length, double distance )
+{
+    if ( t >= length )
+        return 0;
+
+    int count = static_cast<int>( std::ceil( ( length - t ) / distance ) );
+
+    // compensating rounding errors
+    while ( count > 0 && t + ( count - 1 ) * distance >= length )
+        count--;
+
+    while ( t + count * distance < length )
+        count++;
+
+    return count;
+}
+
+static void qwtEvaluateSegments( const EquidistantSegment *segments,
+    int from, int to, double distance, QPointF *points )
+{
+    QVector<double> values;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const EquidistantSegment &s = segments[i];
+
+        if ( s.count > 0 )
+        {
+            if ( values.size() < s.count )
+                values.resize( s.count );
+
+            double *v = values.data();
+            for ( int j = 0; j < s.count; j++ )
+                v[j] = ( s.t + j * distance ) / s.length;
+
+            QwtBezier::pointsAt( s.p1, s.cp1, s.cp2, s.p2,
+                v, s.count, points + s.offset );
+        }
+
+        if ( s.hasNode )
+            points[ s.offset + s.count ] = s.p2;
+    }
+}
 
 namespace QwtSplineC1P
 {
@@ -409,10 +482,20 @@ static QPolygonF qwtPolygonParametric( double distance,
 
         const double l = p2.x() - p1.x();
 
-        while ( t < l )
+        const int count = qwtEquidistantCount( t, l, distance );
+        if ( count > 0 )
         {
-            fittedPoints += QPointF( p1.x() + t, p1.y() + polynomial.valueAt( t ) );
-            t += distance;
+            const int offset = fittedPoints.size();
+            fittedPoints.resize( offset + count );
+
+            QPointF *fp = fittedPoints.data() + offset;
+            for ( int j = 0; j < count; j++ )
+            {
+                const double x = t + j * distance;
+                fp[j] = QPointF( p1.x() + x, p1.y() + polynomial.valueAt( x ) );
+            }
+
+            t += count * distance;
         }
 
         if ( withNodes )
@@ -876,65 +959,135 @@ QPolygonF QwtSplineInterpolating::equidistantPolygon( const QPolygonF &points,
         return points;
     }
 
-    QPolygonF path;
-
     const QVector<QLineF> controlLines = bezierControlLines( points );
 
     if ( controlLines.size() < n - 1 )
-        return path;
-
-    path += points.first();
-    double t = distance;
+        return QPolygonF();
 
     const QPointF *p = points.constData();
     const QLineF *cl = controlLines.constData();
 
     const QwtSplineParametrization *param = parametrization();
 
-    for ( int i = 0; i < n - 1; i++ )
+    const bool isClosed = ( boundaryType() == QwtSpline::ClosedPolygon )
+        && ( controlLines.size() >= n );
+
+    /*
+      In a first pass we find the parameter values and the positions
+      of the interpolated points for each Bezier curve. Then the
+      curves are evaluated independently - in parallel for huge polygons.
+     */
+
+    const int numSegments = isClosed ? n : n - 1;
+    QVector<EquidistantSegment> segments( numSegments );
+
+    double t = distance;
+    int offset = 1;
+    bool hasNodes = false;
+
+    for ( int i = 0; i < numSegments; i++ )
     {
-        const double l = param->valueIncrement( p[i], p[i+1] );
+        EquidistantSegment &s = segments[i];
 
-        while ( t < l )
-        {
-            path += QwtBezier::pointAt( p[i], cl[i].p1(),
-                cl[i].p2(), p[i+1], t / l );
+        s.p1 = p[i];
+        s.cp1 = cl[i].p1();
+        s.cp2 = cl[i].p2();
+        s.p2 = ( i < n - 1 ) ? p[i+1] : p[0];
 
-            t += distance;
-        }
+        s.length = param->valueIncrement( s.p1, s.p2 );
+        s.t = t;
+        s.count = qwtEquidistantCount( t, s.length, distance );
+        s.offset = offset;
+        s.hasNode = withNodes || ( i == n - 1 );
 
-        if ( withNodes )
+        offset += s.count;
+        if ( s.hasNode )
         {
-            if ( qFuzzyCompare( path.last().x(), p[i+1].x() ) )
-                path.last() = p[i+1];
-            else
-                path += p[i+1];
+            offset++;
+            hasNodes = true;
+        }
 
+        if ( withNodes )
             t = distance;
+        else
+            t += s.count * distance - s.length;
+    }
+
+    QPolygonF path( offset );
+    path[0] = points.first();
+
+    QPointF *pathPoints = path.data();
+
+#if QWT_USE_THREADS
+    int numThreads = 1;
+
+    const int minSegmentsPerThread = 10000;
+    if ( numSegments >= 2 * minSegmentsPerThread )
+    {
+        numThreads = qMin( QThread::idealThreadCount(),
+            numSegments / minSegmentsPerThread );
+
+        if ( numThreads <= 0 )
+            numThreads = 1;
+    }
+
+    const int segmentsPerThread = numSegments / numThreads;
+
+    QVector< QFuture<void> > futures;
+    futures.reserve( numThreads - 1 );
+
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        const int from = i * segmentsPerThread;
+
+        if ( i == numThreads - 1 )
+        {
+            qwtEvaluateSegments( segments.constData(),
+                from, numSegments - 1, distance, pathPoints );
         }
         else
         {
-            t -= l;
+            futures += QtConcurrent::run( &qwtEvaluateSegments,
+                segments.constData(), from, from + segmentsPerThread - 1,
+                distance, pathPoints );
         }
     }
 
-    if ( ( boundaryType() == QwtSpline::ClosedPolygon )
-        && ( controlLines.size() >= n ) )
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    qwtEvaluateSegments( segments.constData(),
+        0, numSegments - 1, distance, pathPoints );
+#endif
+
+    if ( hasNodes )
     {
-        const double l = param->valueIncrement( p[n-1], p[0] );
+        // nodes, that are too close to the last interpolated point replace it
+
+        int numPoints = 1;
 
-        while ( t < l )
+        for ( int i = 0; i < numSegments; i++ )
         {
-            path += QwtBezier::pointAt( p[n-1], cl[n-1].p1(),
-                cl[n-1].p2(), p[0], t / l );
+            const EquidistantSegment &s = segments[i];
+
+            if ( s.offset != numPoints )
+            {
+                std::copy( pathPoints + s.offset,
+                    pathPoints + s.offset + s.count, pathPoints + numPoints );
+            }
 
-            t += distance;
+            numPoints += s.count;
+
+            if ( s.hasNode )
+            {
+                if ( qFuzzyCompare( pathPoints[numPoints - 1].x(), s.p2.x() ) )
+                    pathPoints[numPoints - 1] = s.p2;
+                else
+                    pathPoints[numPoints++] = s.p2;
+            }
         }
 
-        if ( qFuzzyCompare( path.last().x(), p[0].x() ) )
-            path.last() = p[0];
-        else
-            path += p[0];
+        path.resize( numPoints );
     }
 
     return path;
@@ -12,6 +12,15 @@
 
 #include <qpolygon.h>
 #include <qpainterpath.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <algorithm>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
 
 #define SLOPES_INCREMENTAL 0
 #define KAHAN 0
@@ -955,6 +964,172 @@ static void qwtSetupEndEquations(
     }
 }
 
+static inline QVector<double> qwtStoredValues(
+    const QwtSplineCubicP::SlopeStore &store )
+{
+    return store.slopes();
+}
+
+static inline QVector<double> qwtStoredValues(
+    const QwtSplineCubicP::CurvatureStore &store )
+{
+    return store.curvatures();
+}
+
+namespace
+{
+    class ChunkCommand
+    {
+    public:
+        const QPolygonF *points;
+
+        int conditionBegin;
+        double valueBegin;
+
+        int conditionEnd;
+        double valueEnd;
+
+        int from;
+        int to;
+
+        double *values;
+        bool *isValid;
+    };
+}
+
+template< class Store >
+static QVector<double> qwtResolveConditional( const QPolygonF &points,
+    int conditionBegin, double valueBegin, int conditionEnd, double valueEnd )
+{
+    using namespace QwtSplineCubicP;
+
+    Equation3 eq[2];
+    qwtSetupEndEquations( conditionBegin, valueBegin,
+        conditionEnd, valueEnd, points, eq );
+
+    EquationSystem<Store> eqs;
+    eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
+    eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
+    eqs.resolve( points );
+
+    return qwtStoredValues( eqs.store() );
+}
+
+/*
+  The influence of a boundary condition decays by a factor of at least 0.5
+  from one control point to the next, because the equation system is
+  diagonally dominant. So a chunk can be resolved independently,
+  when it is extended by some overlapping points, where the missing
+  conditions are replaced by a natural end. Only the values
+  of the chunk itself are taken from the solution.
+ */
+static const int qwtChunkOverlap = 64;
+
+template< class Store >
+static void qwtResolveChunk( const ChunkCommand &command )
+{
+    const QPolygonF &points = *command.points;
+    const int n = points.size();
+
+    const int i0 = qMax( command.from - qwtChunkOverlap, 0 );
+    const int i1 = qMin( command.to + qwtChunkOverlap, n - 1 );
+
+    int conditionBegin = command.conditionBegin;
+    double valueBegin = command.valueBegin;
+
+    if ( i0 > 0 )
+    {
+        conditionBegin = QwtSpline::Clamped2;
+        valueBegin = 0.0;
+    }
+
+    int conditionEnd = command.conditionEnd;
+    double valueEnd = command.valueEnd;
+
+    if ( i1 < n - 1 )
+    {
+        conditionEnd = QwtSpline::Clamped2;
+        valueEnd = 0.0;
+    }
+
+    const QVector<double> values = qwtResolveConditional<Store>(
+        points.mid( i0, i1 - i0 + 1 ),
+        conditionBegin, valueBegin, conditionEnd, valueEnd );
+
+    *command.isValid = ( values.size() == i1 - i0 + 1 );
+
+    if ( *command.isValid )
+    {
+        std::copy( values.constData() + ( command.from - i0 ),
+            values.constData() + ( command.to - i0 + 1 ),
+            command.values + command.from );
+    }
+}
+
+template< class Store >
+static QVector<double> qwtResolve( const QPolygonF &points,
+    int conditionBegin, double valueBegin, int conditionEnd, double valueEnd )
+{
+#if QWT_USE_THREADS
+    const int n = points.size();
+
+    const int minChunkSize = 50000;
+
+    int numThreads = 1;
+    if ( n >= 2 * minChunkSize )
+        numThreads = qMin( QThread::idealThreadCount(), n / minChunkSize );
+
+    if ( numThreads > 1 )
+    {
+        QVector<double> values( n );
+
+        ChunkCommand command;
+        command.points = &points;
+        command.conditionBegin = conditionBegin;
+        command.valueBegin = valueBegin;
+        command.conditionEnd = conditionEnd;
+        command.valueEnd = valueEnd;
+        command.values = values.data();
+
+        const int chunkSize = n / numThreads;
+
+        // each chunk reports, if it could be resolved
+        QVector<bool> isValid( numThreads, false );
+
+        QVector< QFuture<void> > futures;
+        futures.reserve( numThreads - 1 );
+
+        for ( int i = 0; i < numThreads; i++ )
+        {
+            command.from = i * chunkSize;
+            command.isValid = isValid.data() + i;
+
+            if ( i == numThreads - 1 )
+            {
+                command.to = n - 1;
+                qwtResolveChunk<Store>( command );
+            }
+            else
+            {
+                command.to = command.from + chunkSize - 1;
+                futures += QtConcurrent::run( &qwtResolveChunk<Store>, command );
+            }
+        }
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+
+        if ( !isValid.contains( false ) )
+            return values;
+
+        // falling back to resolving all points at once
+    }
+#endif
+
+    return qwtResolveConditional<Store>( points,
+        conditionBegin, valueBegin, conditionEnd, valueEnd );
+}
+
 class QwtSplineCubic::PrivateData
 {
 public:
@@ -1056,20 +1231,11 @@ QVector<double> QwtSplineCubic::slopes( const QPolygonF &points ) const
         }
     }
 
-    Equation3 eq[2];
-    qwtSetupEndEquations(
+    return qwtResolve<SlopeStore>( points,
         boundaryCondition( QwtSpline::AtBeginning ),
         boundaryValue( QwtSpline::AtBeginning ),
         boundaryCondition( QwtSpline::AtEnd ),
-        boundaryValue( QwtSpline::AtEnd ),
-        points, eq );
-
-    EquationSystem<SlopeStore> eqs;
-    eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
-    eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
-    eqs.resolve( points );
-
-    return eqs.store().slopes();
+        boundaryValue( QwtSpline::AtEnd ) );
 }
 
 /*!
@@ -1106,20 +1272,11 @@ QVector<double> QwtSplineCubic::curvatures( const QPolygonF &points ) const
         }
     }
 
-    Equation3 eq[2];
-    qwtSetupEndEquations(
+    return qwtResolve<CurvatureStore>( points,
         boundaryCondition( QwtSpline::AtBeginning ),
         boundaryValue( QwtSpline::AtBeginning ),
         boundaryCondition( QwtSpline::AtEnd ),
-        boundaryValue( QwtSpline::AtEnd ),
-        points, eq );
-
-    EquationSystem<CurvatureStore> eqs;
-    eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
-    eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
-    eqs.resolve( points );
-
-    return eqs.store().curvatures();
+        boundaryValue( QwtSpline::AtEnd ) );
 }
 
 /*!
@@ -0,0 +1,354 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_text_cache.h"
+#include "qwt_math.h"
+
+#include <qcache.h>
+#include <qmutex.h>
+#include <qstring.h>
+#include <qfont.h>
+#include <qimage.h>
+#include <qpainter.h>
+#include <qpaintdevice.h>
+
+// images of texts larger than this are not cached
+static const int qwtMaxImagePixels = 1024 * 1024;
+
+static inline qreal qwtDevicePixelRatio( const QPainter *painter )
+{
+#if QT_VERSION >= 0x050600
+    return painter->device()->devicePixelRatioF();
+#elif QT_VERSION >= 0x050000
+    return painter->device()->devicePixelRatio();
+#else
+    Q_UNUSED( painter )
+    return 1.0;
+#endif
+}
+
+namespace
+{
+    class CacheEntry
+    {
+    public:
+        QSizeF size;
+        QImage image;
+    };
+
+    class TextCache
+    {
+    public:
+        TextCache()
+        {
+            cache.setMaxCost( 4096 );
+        }
+
+        QMutex mutex;
+        QCache<QString, CacheEntry> cache; // cost in kilobytes
+    };
+}
+
+Q_GLOBAL_STATIC( TextCache, qwtTextCache )
+
+static inline QChar qwtSeparator()
+{
+    return QChar( 0x1f );
+}
+
+static bool qwtHasSubpixelAntialiasing( const QPainter *painter )
+{
+    if ( !( painter->renderHints() & QPainter::TextAntialiasing ) )
+        return false;
+
+    const QFont::StyleStrategy strategy = painter->font().styleStrategy();
+    if ( strategy & QFont::NoAntialias )
+        return false;
+
+#if QT_VERSION >= 0x050800
+    if ( strategy & QFont::NoSubpixelAntialias )
+        return false;
+#endif
+
+    /*
+        Depending on the platform and the paint device the text might
+        be rendered with subpixel antialiasing, what is never done
+        for transparent images.
+     */
+    return true;
+}
+
+/*!
+  Set the maximum size of the cache
+
+  The default limit is 4096 kilobytes. A limit of 0 disables caching.
+
+  \param kiloBytes Limit in kilobytes
+  \sa cacheLimit(), clear()
+*/
+void QwtTextCache::setCacheLimit( int kiloBytes )
+{
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+    textCache->cache.setMaxCost( qMax( kiloBytes, 0 ) );
+}
+
+/*!
+  \return Maximum size of the cache in kilobytes
+  \sa setCacheLimit()
+*/
+int QwtTextCache::cacheLimit()
+{
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+    return textCache->cache.maxCost();
+}
+
+//! Remove all entries from the cache
+void QwtTextCache::clear()
+{
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+    textCache->cache.clear();
+}
+
+/*!
+  Build a key for the size of a text
+
+  \param engine Name of the text engine
+  \param text Text
+  \param font Font of the text
+  \param flags Bitwise OR of the flags used like in QPainter::drawText()
+  \param width Width for the layout, or -1 for an unlimited width
+
+  \return Key for findSize() and insertSize()
+*/
+QString QwtTextCache::sizeKey( const char *engine, const QString &text,
+    const QFont &font, int flags, double width )
+{
+    QString key = QLatin1String( engine );
+    key += qwtSeparator();
+    key += font.key();
+    key += qwtSeparator();
+    key += QString::number( flags );
+    key += qwtSeparator();
+    key += QString::number( width );
+    key += qwtSeparator();
+    key += text;
+
+    return key;
+}
+
+/*!
+  Find a size in the cache
+
+  \param key Key built by sizeKey()
+  \param size Size of the text, when being found
+
+  \return true, when the key has been found
+*/
+bool QwtTextCache::findSize( const QString &key, QSizeF &size )
+{
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+
+    const CacheEntry *entry = textCache->cache.object( key );
+    if ( entry == NULL )
+        return false;
+
+    size = entry->size;
+    return true;
+}
+
+/*!
+  Insert a size into the cache
+
+  \param key Key built by sizeKey()
+  \param size Size of the text
+*/
+void QwtTextCache::insertSize( const QString &key, const QSizeF &size )
+{
+    CacheEntry *entry = new CacheEntry;
+    entry->size = size;
+
+    const int cost = 1 + key.size() * int( sizeof( QChar ) ) / 1024;
+
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+    textCache->cache.insert( key, entry, cost );
+}
+
+/*!
+  Check if a text can be rendered from a cached image
+
+  Texts are cached as images, when painting on widgets or pixmaps,
+  where they are translated only. Scaled or rotated texts and
+  texts on other paint devices - f.e. vector graphics formats or
+  printers - are always rendered directly.
+
+  As rendering a text to a transparent image loses subpixel antialiasing,
+  images are only used, when the text is rendered without antialiasing
+  or with a font, that has the style strategy QFont::NoSubpixelAntialias.
+
+  \param painter Painter
+  \param size Size of the text in paint device coordinates
+
+  \return true, when the text can be rendered from an image
+*/
+bool QwtTextCache::canCacheImage( const QPainter *painter, const QSizeF &size )
+{
+    if ( painter == NULL || !painter->isActive() )
+        return false;
+
+    const QPaintDevice *pd = painter->device();
+    if ( pd == NULL )
+        return false;
+
+    const int devType = pd->devType();
+    if ( devType != QInternal::Widget && devType != QInternal::Pixmap )
+        return false;
+
+    if ( painter->combinedTransform().type() > QTransform::TxTranslate )
+        return false;
+
+    if ( qwtHasSubpixelAntialiasing( painter ) )
+        return false;
+
+    if ( size.isEmpty() )
+        return false;
+
+    const qreal ratio = qwtDevicePixelRatio( painter );
+
+    const double numPixels = size.width() * size.height() * ratio * ratio;
+    if ( numPixels > qwtMaxImagePixels )
+        return false;
+
+    return cacheLimit() > 0;
+}
+
+/*!
+  Build a key for the image of a text
+
+  Beside the parameters the key depends on the font, the color of the pen,
+  the render hints and the device pixel ratio of the painter.
+
+  \param engine Name of the text engine
+  \param text Text
+  \param painter Painter
+  \param flags Bitwise OR of the flags used like in QPainter::drawText()
+  \param size Size of the image in paint device coordinates
+
+  \return Key for findImage() and insertImage()
+*/
+QString QwtTextCache::imageKey( const char *engine, const QString &text,
+    const QPainter *painter, int flags, const QSizeF &size )
+{
+    QString key = QLatin1String( engine );
+    key += qwtSeparator();
+    key += painter->font().key();
+    key += qwtSeparator();
+    key += QString::number( painter->pen().color().rgba() );
+    key += qwtSeparator();
+    key += QString::number( int( painter->renderHints() ) );
+    key += qwtSeparator();
+    key += QString::number( qwtDevicePixelRatio( painter ) );
+    key += qwtSeparator();
+    key += QString::number( flags );
+    key += qwtSeparator();
+    key += QString::number( size.width() );
+    key += QLatin1Char( 'x' );
+    key += QString::number( size.height() );
+    key += qwtSeparator();
+    key += text;
+
+    return key;
+}
+
+/*!
+  Create a transparent image for rendering a text
+
+  \param painter Painter, that will paint the image
+  \param size Size of the text in paint device coordinates
+
+  \return Image with the device pixel ratio and the resolution
+          of the paint device of the painter
+*/
+QImage QwtTextCache::createImage( const QPainter *painter, const QSizeF &size )
+{
+    const qreal ratio = qwtDevicePixelRatio( painter );
+
+    QImage image( qwtCeil( size.width() * ratio ),
+        qwtCeil( size.height() * ratio ), QImage::Format_ARGB32_Premultiplied );
+
+#if QT_VERSION >= 0x050000
+    image.setDevicePixelRatio( ratio );
+#endif
+
+    // the layout of texts depends on the resolution
+
+    const QPaintDevice *pd = painter->device();
+    image.setDotsPerMeterX( qRound( pd->logicalDpiX() / 0.0254 ) );
+    image.setDotsPerMeterY( qRound( pd->logicalDpiY() / 0.0254 ) );
+
+    image.fill( 0 );
+
+    return image;
+}
+
+/*!
+  Find an image in the cache
+
+  \param key Key built by imageKey()
+  \param image Image of the text, when being found. A null image
+               indicates, that the text has to be rendered directly.
+
+  \return true, when the key has been found
+*/
+bool QwtTextCache::findImage( const QString &key, QImage &image )
+{
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+
+    const CacheEntry *entry = textCache->cache.object( key );
+    if ( entry == NULL )
+        return false;
+
+    image = entry->image;
+    return true;
+}
+
+/*!
+  Insert an image into the cache
+
+  A text engine might insert a null image for texts, that can't be
+  rendered from an image - f.e. because they don't fit into the
+  rectangle. So it doesn't need to check this again for the next time.
+
+  \param key Key built by imageKey()
+  \param image Image of the text
+*/
+void QwtTextCache::insertImage( const QString &key, const QImage &image )
+{
+    CacheEntry *entry = new CacheEntry;
+    entry->image = image;
+
+    const int numBytes = image.bytesPerLine() * image.height();
+    const int cost = 1 + ( numBytes + key.size() * int( sizeof( QChar ) ) ) / 1024;
+
+    TextCache *textCache = qwtTextCache();
+
+    QMutexLocker locker( &textCache->mutex );
+    textCache->cache.insert( key, entry, cost );
+}
@@ -0,0 +1,69 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_TEXT_CACHE_H
+#define QWT_TEXT_CACHE_H
+
+#include "qwt_global.h"
+
+class QString;
+class QFont;
+class QSizeF;
+class QImage;
+class QPainter;
+
+/*!
+  \brief A process-wide cache for laid out texts
+
+  Text engines, that need to parse and lay out their texts - like
+  QwtRichTextEngine or the MathML text engine - store the results of
+  their calculations in QwtTextCache, so that a text is not parsed again
+  for each replot.
+
+  The cache stores the sizes of texts and images of texts, that have
+  been rendered for raster devices. Its total size is bounded by
+  cacheLimit(). When the limit has been exceeded the entries, that have
+  not been used for the longest time are removed.
+
+  The entries are identified by keys, that are built from the text
+  and all parameters, that have an effect on the layout: f.e
+  the font, the flags, the width and the device pixel ratio.
+
+  \note All methods are thread safe.
+  \sa QwtTextEngine
+*/
+class QWT_EXPORT QwtTextCache
+{
+public:
+    static void setCacheLimit( int kiloBytes );
+    static int cacheLimit();
+
+    static void clear();
+
+    static QString sizeKey( const char *engine, const QString &text,
+        const QFont &, int flags, double width = -1.0 );
+
+    static bool findSize( const QString &key, QSizeF &size );
+    static void insertSize( const QString &key, const QSizeF &size );
+
+    static bool canCacheImage( const QPainter *, const QSizeF &size );
+
+    static QString imageKey( const char *engine, const QString &text,
+        const QPainter *, int flags, const QSizeF &size );
+
+    static QImage createImage( const QPainter *, const QSizeF &size );
+
+    static bool findImage( const QString &key, QImage &image );
+    static void insertImage( const QString &key, const QImage &image );
+
+private:
+    QwtTextCache();
+};
+
+#endif
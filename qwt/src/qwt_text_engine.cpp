@@ -9,6 +9,7 @@
 
 #include "qwt_text_engine.h"
 #include "qwt_painter.h"
+#include "qwt_text_cache.h"
 
 #include <qpainter.h>
 #include <qpixmap.h>
@@ -262,10 +263,21 @@ QwtRichTextEngine::QwtRichTextEngine()
 double QwtRichTextEngine::heightForWidth( const QFont& font, int flags,
         const QString& text, double width ) const
 {
-    QwtRichTextDocument doc( text, flags, font );
+    const QString key = QwtTextCache::sizeKey(
+        "richtext", text, font, flags, width );
+
+    QSizeF size;
+    if ( !QwtTextCache::findSize( key, size ) )
+    {
+        QwtRichTextDocument doc( text, flags, font );
+
+        doc.setPageSize( QSizeF( width, QWIDGETSIZE_MAX ) );
+        size = doc.documentLayout()->documentSize();
 
-    doc.setPageSize( QSizeF( width, QWIDGETSIZE_MAX ) );
-    return doc.documentLayout()->documentSize().height();
+        QwtTextCache::insertSize( key, size );
+    }
+
+    return size.height();
 }
 
 /*!
@@ -281,6 +293,13 @@ double QwtRichTextEngine::heightForWidth( const QFont& font, int flags,
 QSizeF QwtRichTextEngine::textSize( const QFont &font,
     int flags, const QString& text ) const
 {
+    const QString key = QwtTextCache::sizeKey(
+        "richtext", text, font, flags );
+
+    QSizeF size;
+    if ( QwtTextCache::findSize( key, size ) )
+        return size;
+
     QwtRichTextDocument doc( text, flags, font );
 
     QTextOption option = doc.defaultTextOption();
@@ -291,12 +310,19 @@ QSizeF QwtRichTextEngine::textSize( const QFont &font,
         doc.adjustSize();
     }
 
-    return doc.size();
+    size = doc.size();
+    QwtTextCache::insertSize( key, size );
+
+    return size;
 }
 
 /*!
   Draw the text in a clipping rectangle
 
+  On widgets and pixmaps the text is rendered from an image,
+  that is stored in QwtTextCache, when the result is the same
+  - see QwtTextCache::canCacheImage().
+
   \param painter Painter
   \param rect Clipping rectangle
   \param flags Bitwise OR of the flags like in for QPainter::drawText()
@@ -305,7 +331,55 @@ QSizeF QwtRichTextEngine::textSize( const QFont &font,
 void QwtRichTextEngine::draw( QPainter *painter, const QRectF &rect,
     int flags, const QString& text ) const
 {
-    QwtRichTextDocument doc( text, flags, painter->font() );
+    const QFont font = painter->font();
+
+    if ( QwtTextCache::canCacheImage( painter, rect.size() ) )
+    {
+        const QString key = QwtTextCache::imageKey(
+            "richtext", text, painter, flags, rect.size() );
+
+        QImage image;
+        if ( !QwtTextCache::findImage( key, image ) )
+        {
+            /*
+                The image needs to cover the complete document, what
+                is not the case, when it doesn't fit into the rectangle.
+                Then a null image is stored, to avoid checking it again.
+             */
+
+            bool fits = heightForWidth(
+                font, flags, text, rect.width() ) <= rect.height();
+
+            if ( fits && !( flags & Qt::TextWordWrap ) )
+                fits = textSize( font, flags, text ).width() <= rect.width();
+
+            if ( fits )
+            {
+                image = QwtTextCache::createImage( painter, rect.size() );
+
+                QPainter imagePainter( &image );
+                imagePainter.setRenderHints( painter->renderHints() );
+                imagePainter.setFont( font );
+                imagePainter.setPen( painter->pen() );
+
+                QwtRichTextDocument doc( text, flags, font );
+                QwtPainter::drawSimpleRichText( &imagePainter,
+                    QRectF( QPointF( 0.0, 0.0 ), rect.size() ), flags, doc );
+
+                imagePainter.end();
+            }
+
+            QwtTextCache::insertImage( key, image );
+        }
+
+        if ( !image.isNull() )
+        {
+            painter->drawImage( rect.topLeft(), image );
+            return;
+        }
+    }
+
+    QwtRichTextDocument doc( text, flags, font );
     QwtPainter::drawSimpleRichText( painter, rect, flags, doc );
 }
 
@@ -20,6 +20,17 @@ QwtVectorFieldSymbol::~QwtVectorFieldSymbol()
 {
 }
 
+/*!
+    \return Geometry of the arrow for the current length, or an empty
+            path, when the arrow can be painted by paint() only.
+
+    The default implementation returns an empty path.
+ */
+QPainterPath QwtVectorFieldSymbol::path() const
+{
+    return QPainterPath();
+}
+
 class QwtVectorFieldArrow::PrivateData
 {
 public:
@@ -87,6 +98,11 @@ void QwtVectorFieldArrow::paint( QPainter *painter ) const
     painter->drawPath( d_data->path );
 }
 
+QPainterPath QwtVectorFieldArrow::path() const
+{
+    return d_data->path;
+}
+
 class QwtVectorFieldThinArrow::PrivateData
 {
 public:
@@ -139,3 +155,8 @@ void QwtVectorFieldThinArrow::paint(QPainter * p) const
 {
     p->drawPath( d_data->path );
 }
+
+QPainterPath QwtVectorFieldThinArrow::path() const
+{
+    return d_data->path;
+}
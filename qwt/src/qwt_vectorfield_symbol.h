@@ -28,6 +28,11 @@ class QPainterPath;
 
     A new arrow implementation can be set with QwtPlotVectorField::setArrowSymbol(), whereby
     ownership is transferred to the plot field.
+
+    When path() returns the geometry of the arrow and
+    QwtPlotVectorField::BatchSymbols is enabled, QwtPlotVectorField
+    collects the arrows into a few paths instead of calling paint()
+    for each of them.
 */
 class QWT_EXPORT QwtVectorFieldSymbol
 {
@@ -39,6 +44,7 @@ public:
     virtual double length() const = 0;
 
     virtual void paint( QPainter * ) const = 0;
+    virtual QPainterPath path() const;
 
 private:
     Q_DISABLE_COPY(QwtVectorFieldSymbol)
@@ -57,6 +63,7 @@ public:
     virtual void setLength( qreal length ) QWT_OVERRIDE;
     virtual double length() const QWT_OVERRIDE;
     virtual void paint( QPainter * ) const QWT_OVERRIDE;
+    virtual QPainterPath path() const QWT_OVERRIDE;
 
 private:
     class PrivateData;
@@ -76,6 +83,7 @@ public:
     virtual void setLength( qreal length ) QWT_OVERRIDE;
     virtual double length() const QWT_OVERRIDE;
     virtual void paint( QPainter * ) const QWT_OVERRIDE;
+    virtual QPainterPath path() const QWT_OVERRIDE;
 
 private:
     class PrivateData;
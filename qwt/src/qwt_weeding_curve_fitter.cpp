@@ -14,18 +14,186 @@
 #include <qpolygon.h>
 #include <qstack.h>
 #include <qvector.h>
+#include <qthread.h>
+#include <qmutex.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <algorithm>
+#include <limits>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+namespace
+{
+    class RankedLine
+    {
+    public:
+        RankedLine( int i1 = 0, int i2 = 0, double s = 0.0 ):
+            from( i1 ),
+            to( i2 ),
+            significance( s )
+        {
+        }
+
+        int from;
+        int to;
+
+        // upper limit inherited from the enclosing line
+        double significance;
+    };
+
+    class SignificanceGreater
+    {
+    public:
+        explicit SignificanceGreater( const double *values ):
+            d_values( values )
+        {
+        }
+
+        inline bool operator()( int index1, int index2 ) const
+        {
+            return d_values[index1] > d_values[index2];
+        }
+
+    private:
+        const double *d_values;
+    };
+}
+
+static inline int qwtFarthestPoint( const QPointF *p,
+    int from, int to, double &maxDistSqr )
+{
+    // initialize line segment
+    const double vecX = p[to].x() - p[from].x();
+    const double vecY = p[to].y() - p[from].y();
+
+    const double vecLength = std::sqrt( vecX * vecX + vecY * vecY );
+
+    const double unitVecX = ( vecLength != 0.0 ) ? vecX / vecLength : 0.0;
+    const double unitVecY = ( vecLength != 0.0 ) ? vecY / vecLength : 0.0;
+
+    maxDistSqr = 0.0;
+    int nVertexIndexMaxDistance = from + 1;
+    for ( int i = from + 1; i < to; i++ )
+    {
+        //compare to anchor
+        const double fromVecX = p[i].x() - p[from].x();
+        const double fromVecY = p[i].y() - p[from].y();
+
+        double distToSegmentSqr;
+        if ( fromVecX * unitVecX + fromVecY * unitVecY < 0.0 )
+        {
+            distToSegmentSqr = fromVecX * fromVecX + fromVecY * fromVecY;
+        }
+        else
+        {
+            const double toVecX = p[i].x() - p[to].x();
+            const double toVecY = p[i].y() - p[to].y();
+            const double toVecLength = toVecX * toVecX + toVecY * toVecY;
+
+            const double s = toVecX * ( -unitVecX ) + toVecY * ( -unitVecY );
+            if ( s < 0.0 )
+            {
+                distToSegmentSqr = toVecLength;
+            }
+            else
+            {
+                distToSegmentSqr = std::fabs( toVecLength - s * s );
+            }
+        }
+
+        if ( maxDistSqr < distToSegmentSqr )
+        {
+            maxDistSqr = distToSegmentSqr;
+            nVertexIndexMaxDistance = i;
+        }
+    }
+
+    return nVertexIndexMaxDistance;
+}
+
+static void qwtRankPoints( const QPointF *p, int from, int to, double *values )
+{
+    /*
+      Running the Douglas Peucker algorithm without tolerance
+      the significance of a point is the distance, where it
+      splits its line - limited by the significance of the point,
+      that has split the enclosing line.
+     */
+    const double maxSignificance = std::numeric_limits<double>::max();
+
+    values[from] = values[to] = maxSignificance;
+
+    QStack<RankedLine> stack;
+    stack.reserve( 500 );
+
+    stack.push( RankedLine( from, to, maxSignificance ) );
+
+    while ( !stack.isEmpty() )
+    {
+        const RankedLine r = stack.pop();
+        if ( r.to - r.from < 2 )
+            continue;
+
+        double maxDistSqr;
+        const int index = qwtFarthestPoint( p, r.from, r.to, maxDistSqr );
+
+        const double significance = qMin( std::sqrt( maxDistSqr ), r.significance );
+        values[index] = significance;
+
+        stack.push( RankedLine( r.from, index, significance ) );
+        stack.push( RankedLine( index, r.to, significance ) );
+    }
+}
+
+static void qwtRankChunks( const QPolygonF *points,
+    int chunkSize, int chunk1, int chunk2, double *values )
+{
+    const QPointF *p = points->constData();
+
+    for ( int chunk = chunk1; chunk <= chunk2; chunk++ )
+    {
+        const int from = chunk * chunkSize;
+        const int to = qMin( from + chunkSize, points->size() ) - 1;
+
+        qwtRankPoints( p, from, to, values );
+    }
+}
 
 class QwtWeedingCurveFitter::PrivateData
 {
 public:
     PrivateData():
         tolerance( 1.0 ),
-        chunkSize( 0 )
+        chunkSize( 0 ),
+        progressive( false )
+    {
+    }
+
+    void resetRanking()
     {
+        ranking.points = QPolygonF();
+        ranking.significances.clear();
+        ranking.order.clear();
     }
 
     double tolerance;
     uint chunkSize;
+    bool progressive;
+
+    struct Ranking
+    {
+        QPolygonF points;
+        QVector<double> significances;
+
+        // indexes sorted by decreasing significance
+        QVector<int> order;
+    } ranking;
+
+    QMutex mutex;
 };
 
 class QwtWeedingCurveFitter::Line
@@ -103,7 +271,11 @@ void QwtWeedingCurveFitter::setChunkSize( uint numPoints )
     if ( numPoints > 0 )
         numPoints = qMax( numPoints, 3U );
 
-    d_data->chunkSize = numPoints;
+    if ( numPoints != d_data->chunkSize )
+    {
+        d_data->chunkSize = numPoints;
+        d_data->resetRanking();
+    }
 }
 
 /*!
@@ -116,6 +288,146 @@ uint QwtWeedingCurveFitter::chunkSize() const
     return d_data->chunkSize;
 }
 
+/*!
+  \brief En/Disable the progressive mode
+
+  In progressive mode the significances() of the points are calculated
+  once and cached. As long as fitCurve() is called for the same
+  points - f.e. with different tolerances - the smoothed curve is
+  found by a filter operation, that is linear to the number of points -
+  or even to the number of resulting points, when the tolerance is large.
+
+  The cache is identified by the data of the polygon: passing the
+  same polygon or an implicitly shared copy of it reuses the
+  significances, while a polygon with its own data - even with equal
+  points - is ranked again. So progressive mode is useful, when the
+  application keeps the points ( f.e. in plot coordinates ) and adjusts
+  the tolerance to the scales.
+
+  The cache is protected by a mutex, so that fitCurve() might be called
+  from different threads. Changing the parameters of the fitter
+  concurrently is not supported.
+
+  \param on On/Off
+  \sa isProgressive(), significances(), simplified()
+  \note The default setting is off
+*/
+void QwtWeedingCurveFitter::setProgressive( bool on )
+{
+    if ( on != d_data->progressive )
+    {
+        d_data->progressive = on;
+        d_data->resetRanking();
+    }
+}
+
+/*!
+  \return True, when the progressive mode is enabled
+  \sa setProgressive()
+*/
+bool QwtWeedingCurveFitter::isProgressive() const
+{
+    return d_data->progressive;
+}
+
+/*!
+  \brief Calculate the significance of each point
+
+  The significance of a point is the maximum tolerance, for which
+  the point is still part of the curve smoothed by the
+  Douglas and Peucker algorithm. The first and last point
+  ( of each chunk ) are always part of the smoothed curve and
+  have a significance of std::numeric_limits<double>::max().
+
+  When a chunkSize() is set, the chunks are processed in parallel.
+
+  \param points Series of data points
+  \return Significance for each point
+  \sa simplified(), setChunkSize()
+*/
+QVector<double> QwtWeedingCurveFitter::significances(
+    const QPolygonF &points ) const
+{
+    const int numPoints = points.size();
+
+    QVector<double> values( numPoints );
+    if ( numPoints == 0 )
+        return values;
+
+    const int chunkSize = ( d_data->chunkSize > 0 )
+        ? static_cast<int>( d_data->chunkSize ) : numPoints;
+
+    const int numChunks = ( numPoints + chunkSize - 1 ) / chunkSize;
+
+#if QWT_USE_THREADS
+    int numThreads = QThread::idealThreadCount();
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    numThreads = qMin( numThreads, numChunks );
+
+    const int chunksPerThread = numChunks / numThreads;
+
+    QVector< QFuture<void> > futures;
+    futures.reserve( numThreads - 1 );
+
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        const int chunk1 = i * chunksPerThread;
+
+        if ( i == numThreads - 1 )
+        {
+            qwtRankChunks( &points, chunkSize,
+                chunk1, numChunks - 1, values.data() );
+        }
+        else
+        {
+            futures += QtConcurrent::run( &qwtRankChunks, &points, chunkSize,
+                chunk1, chunk1 + chunksPerThread - 1, values.data() );
+        }
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    qwtRankChunks( &points, chunkSize, 0, numChunks - 1, values.data() );
+#endif
+
+    return values;
+}
+
+/*!
+  \brief Smooth a curve by filtering points by their significance
+
+  Returns the same points as the Douglas and Peucker algorithm
+  for the tolerance, but without running the algorithm.
+
+  \param points Series of data points
+  \param significances Significances of the points calculated
+                       by significances()
+  \param tolerance Tolerance
+
+  \return Points with a significance above the tolerance
+  \sa significances()
+*/
+QPolygonF QwtWeedingCurveFitter::simplified( const QPolygonF &points,
+    const QVector<double> &significances, double tolerance )
+{
+    const int numPoints = qMin( points.size(), significances.size() );
+
+    const QPointF *p = points.constData();
+    const double *s = significances.constData();
+
+    QPolygonF stripped;
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        if ( s[i] > tolerance )
+            stripped += p[i];
+    }
+
+    return stripped;
+}
+
 /*!
   \param points Series of data points
   \return Curve points
@@ -126,6 +438,9 @@ QPolygonF QwtWeedingCurveFitter::fitCurve( const QPolygonF &points ) const
     if ( points.isEmpty() )
         return points;
 
+    if ( d_data->progressive )
+        return simplifyRanked( points );
+
     QPolygonF fittedPoints;
     if ( d_data->chunkSize == 0 )
     {
@@ -173,51 +488,10 @@ QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF &points ) const
     {
         const Line r = stack.pop();
 
-        // initialize line segment
-        const double vecX = p[r.to].x() - p[r.from].x();
-        const double vecY = p[r.to].y() - p[r.from].y();
-
-        const double vecLength = std::sqrt( vecX * vecX + vecY * vecY );
-
-        const double unitVecX = ( vecLength != 0.0 ) ? vecX / vecLength : 0.0;
-        const double unitVecY = ( vecLength != 0.0 ) ? vecY / vecLength : 0.0;
+        double maxDistSqr;
+        const int nVertexIndexMaxDistance =
+            qwtFarthestPoint( p, r.from, r.to, maxDistSqr );
 
-        double maxDistSqr = 0.0;
-        int nVertexIndexMaxDistance = r.from + 1;
-        for ( int i = r.from + 1; i < r.to; i++ )
-        {
-            //compare to anchor
-            const double fromVecX = p[i].x() - p[r.from].x();
-            const double fromVecY = p[i].y() - p[r.from].y();
-
-            double distToSegmentSqr;
-            if ( fromVecX * unitVecX + fromVecY * unitVecY < 0.0 )
-            {
-                distToSegmentSqr = fromVecX * fromVecX + fromVecY * fromVecY;
-            }
-            else
-            {
-                const double toVecX = p[i].x() - p[r.to].x();
-                const double toVecY = p[i].y() - p[r.to].y();
-                const double toVecLength = toVecX * toVecX + toVecY * toVecY;
-
-                const double s = toVecX * ( -unitVecX ) + toVecY * ( -unitVecY );
-                if ( s < 0.0 )
-                {
-                    distToSegmentSqr = toVecLength;
-                }
-                else
-                {
-                    distToSegmentSqr = std::fabs( toVecLength - s * s );
-                }
-            }
-
-            if ( maxDistSqr < distToSegmentSqr )
-            {
-                maxDistSqr = distToSegmentSqr;
-                nVertexIndexMaxDistance = i;
-            }
-        }
         if ( maxDistSqr <= toleranceSqr )
         {
             usePoint[r.from] = true;
@@ -239,3 +513,77 @@ QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF &points ) const
 
     return stripped;
 }
+
+QPolygonF QwtWeedingCurveFitter::simplifyRanked( const QPolygonF &points ) const
+{
+    PrivateData::Ranking ranking;
+
+    {
+        QMutexLocker locker( &d_data->mutex );
+
+        /*
+          The cached polygon is an implicitly shared copy of the
+          ranked points. As any modification detaches the data, having
+          the same data pointer means having the same points.
+         */
+
+        PrivateData::Ranking &cached = d_data->ranking;
+
+        if ( cached.points.constData() != points.constData()
+            || cached.points.size() != points.size() )
+        {
+            // running the algorithm once for each set of points
+
+            d_data->resetRanking();
+
+            cached.points = points;
+            cached.significances = significances( points );
+
+            const int numPoints = points.size();
+
+            cached.order.resize( numPoints );
+            for ( int i = 0; i < numPoints; i++ )
+                cached.order[i] = i;
+
+            std::stable_sort( cached.order.begin(), cached.order.end(),
+                SignificanceGreater( cached.significances.constData() ) );
+        }
+
+        ranking = cached;
+    }
+
+    const double tolerance = d_data->tolerance;
+
+    const double *s = ranking.significances.constData();
+    const int *order = ranking.order.constData();
+
+    // binary search for the number of points above the tolerance
+
+    int numSignificant = 0;
+    int upper = ranking.order.size();
+
+    while ( numSignificant < upper )
+    {
+        const int mid = ( numSignificant + upper ) / 2;
+        if ( s[ order[mid] ] > tolerance )
+            numSignificant = mid + 1;
+        else
+            upper = mid;
+    }
+
+    if ( numSignificant > ranking.order.size() / 8 )
+        return simplified( points, ranking.significances, tolerance );
+
+    // sorting the indexes is cheaper than iterating over all points
+
+    QVector<int> indexes = ranking.order.mid( 0, numSignificant );
+    std::sort( indexes.begin(), indexes.end() );
+
+    const QPointF *p = points.constData();
+
+    QPolygonF stripped( numSignificant );
+    for ( int i = 0; i < numSignificant; i++ )
+        stripped[i] = p[ indexes[i] ];
+
+    return stripped;
+}
@@ -12,6 +12,8 @@
 
 #include "qwt_curve_fitter.h"
 
+template <typename T> class QVector;
+
 /*!
   \brief A curve fitter implementing Douglas and Peucker algorithm
 
@@ -34,6 +36,14 @@
   the number of points. By adjusting the tolerance parameter according to the
   axis scales QwtSplineCurveFitter can be used to implement different
   level of details to speed up painting of curves of many points.
+
+  For changing tolerances ( f.e. when zooming ) the algorithm can be run
+  once in advance, calculating the significance of each point:
+  the maximum tolerance, for which the point is still part of the
+  smoothed curve ( see significances() ). Then the smoothed curve for any
+  tolerance is a simple filter operation ( see simplified() ).
+  In progressive mode ( see setProgressive() ) the fitter caches the
+  significances of the last polygon.
 */
 class QWT_EXPORT QwtWeedingCurveFitter: public QwtCurveFitter
 {
@@ -47,11 +57,20 @@ public:
     void setChunkSize( uint );
     uint chunkSize() const;
 
+    void setProgressive( bool );
+    bool isProgressive() const;
+
+    QVector<double> significances( const QPolygonF & ) const;
+
+    static QPolygonF simplified( const QPolygonF &,
+        const QVector<double> &significances, double tolerance );
+
     virtual QPolygonF fitCurve( const QPolygonF & ) const QWT_OVERRIDE;
     virtual QPainterPath fitCurvePath( const QPolygonF & ) const QWT_OVERRIDE;
 
 private:
     virtual QPolygonF simplify( const QPolygonF & ) const;
+    QPolygonF simplifyRanked( const QPolygonF & ) const;
 
     class Line;
 
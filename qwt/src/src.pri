@@ -37,6 +37,7 @@ HEADERS += \
     qwt_round_scale_draw.h \
     qwt_scale_div.h \
     qwt_scale_draw.h \
+    qwt_scale_label_cache.h \
     qwt_scale_engine.h \
     qwt_scale_map.h \
     qwt_spline.h \
@@ -48,6 +49,7 @@ HEADERS += \
     qwt_spline_polynomial.h \
     qwt_symbol.h \
     qwt_system_clock.h \
+    qwt_text_cache.h \
     qwt_text_engine.h \
     qwt_text_label.h \
     qwt_text.h \
@@ -82,6 +84,7 @@ SOURCES += \
     qwt_round_scale_draw.cpp \
     qwt_scale_div.cpp \
     qwt_scale_draw.cpp \
+    qwt_scale_label_cache.cpp \
     qwt_scale_map.cpp \
     qwt_scale_engine.cpp \
     qwt_spline.cpp \
@@ -92,6 +95,7 @@ SOURCES += \
     qwt_spline_pleasing.cpp \
     qwt_symbol.cpp \
     qwt_system_clock.cpp \
+    qwt_text_cache.cpp \
     qwt_text_engine.cpp \
     qwt_text_label.cpp \
     qwt_text.cpp \
@@ -110,8 +114,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.h \
         qwt_legend_data.h \
         qwt_legend_label.h \
+        qwt_list_legend.h \
         qwt_plot.h \
         qwt_plot_renderer.h \
+        qwt_plot_snapshot.h \
         qwt_plot_curve.h \
         qwt_plot_dict.h \
         qwt_plot_directpainter.h \
@@ -136,6 +142,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_seriesitem.h \
         qwt_plot_shapeitem.h \
         qwt_plot_vectorfield.h \
+        qwt_plot_waterfall.h \
         qwt_plot_abstract_canvas.h \
         qwt_plot_canvas.h \
         qwt_plot_panner.h \
@@ -152,6 +159,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_series_data.h \
         qwt_series_store.h \
         qwt_point_data.h \
+        qwt_histogram_data.h \
         qwt_scale_widget.h 
 
     SOURCES += \
@@ -162,8 +170,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.cpp \
         qwt_legend_data.cpp \
         qwt_legend_label.cpp \
+        qwt_list_legend.cpp \
         qwt_plot.cpp \
         qwt_plot_renderer.cpp \
+        qwt_plot_snapshot.cpp \
         qwt_plot_xml.cpp \
         qwt_plot_axis.cpp \
         qwt_plot_curve.cpp \
@@ -186,6 +196,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_plot_seriesitem.cpp \
         qwt_plot_shapeitem.cpp \
         qwt_plot_vectorfield.cpp \
+        qwt_plot_waterfall.cpp \
         qwt_plot_marker.cpp \
         qwt_plot_textlabel.cpp \
         qwt_plot_layout.cpp \
@@ -204,6 +215,7 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_sampling_thread.cpp \
         qwt_series_data.cpp \
         qwt_point_data.cpp \
+        qwt_histogram_data.cpp \
         qwt_scale_widget.cpp
 
     contains(QWT_CONFIG, QwtOpenGL) {
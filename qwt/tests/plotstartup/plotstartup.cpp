@@ -0,0 +1,67 @@
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+
+#include <qapplication.h>
+#include <qwidget.h>
+#include <qlayout.h>
+#include <qelapsedtimer.h>
+#include <qstringlist.h>
+#include <qdebug.h>
+
+static int countWidgets( const QWidget *widget )
+{
+	return widget->findChildren<QWidget *>().count();
+}
+
+static void testStartup( int numPlots, bool withTitles )
+{
+	QWidget window;
+	QGridLayout *layout = new QGridLayout( &window );
+
+	const int numColumns = 20;
+
+	QElapsedTimer timer;
+	timer.start();
+
+	for ( int i = 0; i < numPlots; i++ )
+	{
+		QwtPlot *plot = new QwtPlot();
+		if ( withTitles )
+			plot->setTitle( QString( "Plot %1" ).arg( i ) );
+
+		QwtPlotCurve *curve = new QwtPlotCurve();
+		curve->attach( plot );
+
+		layout->addWidget( plot, i / numColumns, i % numColumns );
+	}
+
+	const qint64 msCreate = timer.restart();
+
+	window.resize( 1600, 1200 );
+	window.show();
+
+	QApplication::processEvents();
+	const qint64 msShow = timer.restart();
+
+	qDebug() << "Plots:" << numPlots
+		<< ( withTitles ? "with titles" : "without titles" ) << ":"
+		<< "create" << msCreate
+		<< "show" << msShow
+		<< "widgets" << countWidgets( &window );
+}
+
+int main( int argc, char *argv[] )
+{
+	QApplication app( argc, argv );
+
+	int numPlots = 400;
+
+	const QStringList args = app.arguments();
+	if ( args.size() > 1 )
+		numPlots = qMax( args[1].toInt(), 1 );
+
+	testStartup( numPlots, false );
+	testStartup( numPlots, true );
+
+	return 0;
+}
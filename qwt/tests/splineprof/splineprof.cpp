@@ -1,30 +1,60 @@
 #include <qwt_spline_pleasing.h>
 #include <qwt_spline_local.h>
 #include <qwt_spline_cubic.h>
+#include <qwt_spline_basis.h>
 #include <qwt_spline_parametrization.h>
 
 #include <qelapsedtimer.h>
 
 #include <qpolygon.h>
+#include <qpainterpath.h>
 #include <qline.h>
 #include <qdebug.h>
 
-static void testSpline( const char *name, QwtSplineInterpolating *spline,
+#include <cmath>
+
+static void testSpline( const char *name, QwtSpline *spline,
 	int type, const QPolygonF &points )
 {
 	spline->setParametrization( type );
 
 	QElapsedTimer timer;
-	timer.start();
-
-	const QVector<QLineF> lines = spline->bezierControlLines( points );
 
-	qDebug() << name << ":" << timer.elapsed();
+	timer.start();
+	const QPainterPath path = spline->painterPath( points );
+	const qint64 msPath = timer.restart();
+
+	const QPolygonF polygon = spline->polygon( points, 0.1 );
+	const qint64 msPolygon = timer.restart();
+
+	QwtSplineInterpolating *interpolating =
+		dynamic_cast<QwtSplineInterpolating *>( spline );
+
+	if ( interpolating )
+	{
+		const QVector<QLineF> lines = interpolating->bezierControlLines( points );
+		const qint64 msLines = timer.restart();
+
+		const QPolygonF equidistant = interpolating->equidistantPolygon( points, 0.1, true );
+		const qint64 msEquidistant = timer.restart();
+
+		qDebug() << name << ":"
+			<< "path" << msPath
+			<< "polygon" << msPolygon
+			<< "control lines" << msLines
+			<< "equidistant" << msEquidistant;
+	}
+	else
+	{
+		qDebug() << name << ":"
+			<< "path" << msPath
+			<< "polygon" << msPolygon;
+	}
 }
 
 static void testSplines( int paramType, const QPolygonF &points )
 {
-#if 0
+#if 1
 	QwtSplinePleasing splinePleasing;
 	testSpline( "Pleasing", &splinePleasing, paramType, points );
 #endif
@@ -53,15 +83,15 @@ static void testSplines( int paramType, const QPolygonF &points )
 	QwtSplineCubic splineC2;
 	testSpline( "Cubic", &splineC2, paramType, points );
 #endif
+
+#if 1
+	QwtSplineBasis splineBasis;
+	testSpline( "Basis", &splineBasis, paramType, points );
+#endif
 }
 
-int main()
+static void testParametrizations( const QPolygonF &points )
 {
-	QPolygonF points;
-
-	for ( int i = 0; i < 10e6; i++ )
-		points += QPointF( i, std::sin( i ) );
-
 #if 1
 	qDebug() << "=== X";
 	testSplines( QwtSplineParametrization::ParameterX, points );
@@ -91,6 +121,23 @@ int main()
 	qDebug() << "=== Centripetral";
 	testSplines( QwtSplineParametrization::ParameterCentripetal, points );
 #endif
+}
+
+int main()
+{
+	const int sizes[] = { 1000, 10000, 100000, 1000000 };
+
+	for ( uint i = 0; i < sizeof( sizes ) / sizeof( sizes[0] ); i++ )
+	{
+		QPolygonF points;
+		points.reserve( sizes[i] );
+
+		for ( int j = 0; j < sizes[i]; j++ )
+			points += QPointF( j, std::sin( j ) );
+
+		qDebug() << "##### Points:" << sizes[i];
+		testParametrizations( points );
+	}
 
 	return 0;
 }
@@ -9,8 +9,10 @@
 
 #include <qstring.h>
 #include <qpainter.h>
+#include <qimage.h>
 #include "qwt_mathml_text_engine.h"
 #include "qwt_mml_document.h"
+#include "qwt_text_cache.h"
 
 //! Constructor
 QwtMathMLTextEngine::QwtMathMLTextEngine()
@@ -53,20 +55,21 @@ QSizeF QwtMathMLTextEngine::textSize( const QFont &font,
 {
     Q_UNUSED( flags );
 
-    static QString t;
-    static QSizeF sz;
+    // the layout does not depend on the flags
+    const QString key = QwtTextCache::sizeKey( "mathml", text, font, 0 );
 
-    if ( text != t )
+    QSizeF size;
+    if ( !QwtTextCache::findSize( key, size ) )
     {
         QwtMathMLDocument doc;
         doc.setContent( text );
         doc.setBaseFontPointSize( font.pointSizeF() );
 
-        sz = doc.size();
-        t = text;
+        size = doc.size();
+        QwtTextCache::insertSize( key, size );
     }
 
-    return sz;
+    return size;
 }
 
 /*!
@@ -86,6 +89,9 @@ void QwtMathMLTextEngine::textMargins( const QFont &, const QString &,
 /*!
    Draw the text in a clipping rectangle
 
+   On widgets and pixmaps the formula is rendered from an image,
+   that is stored in QwtTextCache.
+
    \param painter Painter
    \param rect Clipping rectangle
    \param flags Bitwise OR of the flags like in for QPainter::drawText
@@ -94,11 +100,7 @@ void QwtMathMLTextEngine::textMargins( const QFont &, const QString &,
 void QwtMathMLTextEngine::draw( QPainter *painter, const QRectF &rect,
     int flags, const QString& text ) const
 {
-    QwtMathMLDocument doc;
-    doc.setContent( text );
-    doc.setBaseFontPointSize( painter->font().pointSizeF() );
-
-    const QSizeF docSize = doc.size();
+    const QSizeF docSize = textSize( painter->font(), flags, text );
 
     QPointF pos = rect.topLeft();
     if ( rect.width() > docSize.width() )
@@ -116,6 +118,39 @@ void QwtMathMLTextEngine::draw( QPainter *painter, const QRectF &rect,
             pos.setY( rect.center().y() - docSize.height() / 2 );
     }
 
+    if ( QwtTextCache::canCacheImage( painter, docSize ) )
+    {
+        const QString key = QwtTextCache::imageKey(
+            "mathml", text, painter, 0, docSize );
+
+        QImage image;
+        if ( !QwtTextCache::findImage( key, image ) )
+        {
+            image = QwtTextCache::createImage( painter, docSize );
+
+            QPainter imagePainter( &image );
+            imagePainter.setRenderHints( painter->renderHints() );
+            imagePainter.setFont( painter->font() );
+            imagePainter.setPen( painter->pen() );
+
+            QwtMathMLDocument doc;
+            doc.setContent( text );
+            doc.setBaseFontPointSize( painter->font().pointSizeF() );
+            doc.paint( &imagePainter, QPointF( 0.0, 0.0 ) );
+
+            imagePainter.end();
+
+            QwtTextCache::insertImage( key, image );
+        }
+
+        painter->drawImage( pos.toPoint(), image );
+        return;
+    }
+
+    QwtMathMLDocument doc;
+    doc.setContent( text );
+    doc.setBaseFontPointSize( painter->font().pointSizeF() );
+
     doc.paint( painter, pos.toPoint() );
 }
 